@@ -23,6 +23,8 @@
  const unsigned long debounceDelay = 0; // Debounce time in milliseconds
  volatile unsigned long lastInterruptTime = 0; // Time of last interrupt
  volatile unsigned long totalPulses = 0; // Total pulses since startup
+ volatile unsigned long lastPulseMicros = 0; // micros() of the last counted edge
+ unsigned long lastSampleMicros = 0; // micros() at the end of the previous interval
 
  // SRF08 variables
  #define SRF08_ADDRESS 0x70
@@ -46,6 +48,7 @@
      if (currentTime - lastInterruptTime > debounceDelay) { // Ignore interrupts within debounce delay
          interruptCount++; // Increment counter
          totalPulses++; // Increment total counter
+         lastPulseMicros = micros(); // Edge timestamp for middleware speed filter
          lastInterruptTime = currentTime; // Update last interrupt time
      }
  }
@@ -80,7 +83,7 @@
      Serial.println("OK");
 
      Serial.println("Simplified sensors initialized!");
-     Serial.println("CAN IDs: Speed=0x100, SRF08=0x101");
+     Serial.println("CAN IDs: Speed=0x100, Speed timing=0x102, SRF08=0x101");
  }
 
  void loop() {
@@ -107,14 +110,39 @@
      noInterrupts(); // Disable interrupts during reading
      unsigned int rawInterruptCount = interruptCount; // Store current count
      interruptCount = 0; // Reset counter for next measurement
+     unsigned long totalSnapshot = totalPulses; // Consistent with edge time
+     unsigned long edgeMicros = lastPulseMicros;
+     unsigned long sampleMicros = micros();
      interrupts(); // Re-enable interrupts
 
+     // Device-side interval length, saturated to 16 bits
+     unsigned long intervalMicros = sampleMicros - lastSampleMicros;
+     if (lastSampleMicros == 0 || intervalMicros > 0xFFFF) {
+         intervalMicros = 0xFFFF;
+     }
+     lastSampleMicros = sampleMicros;
+
+     // Timing frame (CAN ID 0x102), sent first so the middleware can pair it
+     // with the pulse frame that follows
+     // buffer[0-3]: micros() of the last counted edge (32-bit, little endian)
+     // buffer[4-7]: micros() at the end of this interval (32-bit, little endian)
+     byte timing[8];
+     timing[0] = edgeMicros & 0xFF;
+     timing[1] = (edgeMicros >> 8) & 0xFF;
+     timing[2] = (edgeMicros >> 16) & 0xFF;
+     timing[3] = (edgeMicros >> 24) & 0xFF;
+     timing[4] = sampleMicros & 0xFF;
+     timing[5] = (sampleMicros >> 8) & 0xFF;
+     timing[6] = (sampleMicros >> 16) & 0xFF;
+     timing[7] = (sampleMicros >> 24) & 0xFF;
+     CAN.sendMsgBuf(0x102, 0, 8, timing);
+
      // Assume 2 interrupts per physical event (from working code)
      unsigned int pulsesInInterval = rawInterruptCount / 2; // Estimate physical events
 
      // FIXED: Don't divide total pulses - send the actual accumulated count
      // This was causing middleware to receive same total repeatedly -> pulse_delta = 0
-     unsigned long correctedTotalPulses = totalPulses; // Send actual total, not divided
+     unsigned long correctedTotalPulses = totalSnapshot; // Send actual total, not divided
 
      // buffer[0-1]: Pulse count in this interval (16-bit, little endian)
      uint16_t pulsesDelta = (uint16_t)pulsesInInterval;
@@ -127,9 +155,9 @@
      data[4] = (correctedTotalPulses >> 16) & 0xFF;
      data[5] = (correctedTotalPulses >> 24) & 0xFF;
 
-     // buffer[6-7]: Reserved for future use
-     data[6] = 0;
-     data[7] = 0;
+     // buffer[6-7]: Interval length in microseconds (16-bit, little endian)
+     data[6] = intervalMicros & 0xFF;
+     data[7] = (intervalMicros >> 8) & 0xFF;
 
      // Send the packet
      CAN.sendMsgBuf(id, 0, 8, data);
@@ -1,17 +1,25 @@
 #ifndef CONTROLTRANSMITTER_HPP
 #define CONTROLTRANSMITTER_HPP
 
+#include "ControlFrame.hpp"
 #include "Controller.hpp"
 #include "ZmqPublisher.hpp"
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <zmq.hpp>
 
 class ControlTransmitter {
 public:
+  // Encoding of the commands. Binary sends one control_frame per command
+  // (sequence number and send time included); Text keeps the
+  // "throttle:..;steering:..;" format for middleware builds that predate it.
+  enum class WireFormat { Text, Binary };
+
   ControlTransmitter(const std::string &zmq_address,
-                     zmq::context_t &zmq_context);
+                     zmq::context_t &zmq_context,
+                     WireFormat format = WireFormat::Binary);
   ~ControlTransmitter();
 
   // Initialize controller and return whether it was successful
@@ -21,8 +29,14 @@ public:
 
 private:
   void zmqPublish(std::string message);
+  // Sends one command with the control_frame flags describing which fields
+  // are set
+  void sendCommand(uint16_t flags, float throttle = 0.0f,
+                   float steering = 0.0f);
 
   ZmqPublisher _zmq_publisher;
+  WireFormat _format;
+  uint32_t _sequence = 0;
   Controller _controller;
   float _acceleration = 0;
   float _turn = 0;
@@ -1,18 +1,20 @@
 #include "ControlTransmitter.hpp"
 
 ControlTransmitter::ControlTransmitter(const std::string &zmq_address,
-                                       zmq::context_t &zmq_context)
-    : _zmq_publisher(zmq_address, zmq_context) {
+                                       zmq::context_t &zmq_context,
+                                       WireFormat format)
+    : _zmq_publisher(zmq_address, zmq_context), _format(format) {
   std::cout << "ControlTransmitter initialized with address: " << zmq_address
-            << std::endl;
-  _zmq_publisher.send("init;");
+            << " (" << (_format == WireFormat::Binary ? "binary" : "text")
+            << " commands)" << std::endl;
+  sendCommand(control_frame::kInit);
   std::cout << "Sent init message" << std::endl;
 }
 
 ControlTransmitter::~ControlTransmitter() {
   std::cout << "ControlTransmitter shutting down, sending zero values"
             << std::endl;
-  _zmq_publisher.send("throttle:0;steering:0;");
+  sendCommand(control_frame::kHasThrottle | control_frame::kHasSteering);
 }
 
 bool ControlTransmitter::initController() {
@@ -36,7 +38,7 @@ void ControlTransmitter::startTransmitting() {
       _onClick = true;
       std::cout << "X button pressed, sending stop command" << std::endl;
       _acceleration = 0; // Immediate stop
-      _zmq_publisher.send("throttle:0;steering:0;");
+      sendCommand(control_frame::kHasThrottle | control_frame::kHasSteering);
     }
 
     // Handle Y button toggle for auto mode (always works regardless of auto
@@ -119,9 +121,6 @@ void ControlTransmitter::startTransmitting() {
       std::cout << "Final throttle: " << _acceleration << std::endl;
     }
 
-    std::string throttleMsg = "throttle:" + std::to_string(_acceleration) + ";";
-    // _zmq_publisher.send(throttleMsg);
-
     float gear =
         _controller.getAxis(0);  // eixo horizontal (X) do analógico esquerdo.
     if (std::abs(gear) > 0.1f) { // Zona morta
@@ -139,20 +138,22 @@ void ControlTransmitter::startTransmitting() {
     int steeringAngle = static_cast<int>(_turn * 30);
     steeringAngle = std::max(
         -45, std::min(steeringAngle, 45)); // Limite entre -45 e 45 graus
-    std::string steeringMsg = "steering:" + std::to_string(steeringAngle) + ";";
 
     // Send manual control commands (middleware handles auto mode protection)
-    std::string combinedMsg = throttleMsg + steeringMsg;
+    uint16_t flags = control_frame::kHasThrottle | control_frame::kHasSteering;
 
     // Include auto mode status while Y button is pressed
     if (send_auto_mode) {
-      combinedMsg += "auto_mode:" + std::to_string(_auto_mode ? 1 : 0) + ";";
+      flags |= control_frame::kHasAutoMode;
+      if (_auto_mode) {
+        flags |= control_frame::kAutoMode;
+      }
     }
 
-    _zmq_publisher.send(combinedMsg);
+    sendCommand(flags, _acceleration, static_cast<float>(steeringAngle));
   }
   std::cout << "Exiting transmission loop, sending zero values" << std::endl;
-  _zmq_publisher.send("throttle:0;steering:0;");
+  sendCommand(control_frame::kHasThrottle | control_frame::kHasSteering);
   return;
 }
 
@@ -160,3 +161,38 @@ void ControlTransmitter::zmqPublish(std::string message) {
   std::cout << "Publishing message: " << message << std::endl;
   _zmq_publisher.send(message);
 }
+
+void ControlTransmitter::sendCommand(uint16_t flags, float throttle,
+                                     float steering) {
+  if (_format == WireFormat::Binary) {
+    control_frame::Frame frame;
+    frame.flags = flags;
+    frame.sequence = _sequence++;
+    frame.timestamp_ns = control_frame::nowNs();
+    frame.throttle = throttle;
+    frame.steering = steering;
+
+    uint8_t buffer[control_frame::kFrameSize];
+    size_t size = control_frame::encode(frame, buffer, sizeof(buffer));
+    _zmq_publisher.send(
+        std::string_view(reinterpret_cast<const char *>(buffer), size));
+    return;
+  }
+
+  if (flags & control_frame::kInit) {
+    _zmq_publisher.send("init;");
+    return;
+  }
+  kv_codec::MessageWriter<> message;
+  if (flags & control_frame::kHasThrottle) {
+    message.add(kv_codec::Key::Throttle, static_cast<double>(throttle));
+  }
+  if (flags & control_frame::kHasSteering) {
+    message.add(kv_codec::Key::Steering, static_cast<int>(steering));
+  }
+  if (flags & control_frame::kHasAutoMode) {
+    message.add(kv_codec::Key::AutoMode,
+                (flags & control_frame::kAutoMode) ? 1 : 0);
+  }
+  _zmq_publisher.send(message.view());
+}
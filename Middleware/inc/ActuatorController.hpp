@@ -0,0 +1,208 @@
+#ifndef ACTUATOR_CONTROLLER_HPP
+#define ACTUATOR_CONTROLLER_HPP
+
+#include "BackMotors.hpp"
+#include "BrakeController.hpp"
+#include "FServo.hpp"
+#include "SpeedController.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Sole owner of the motor and servo drivers. Callers post throttle and
+// steering setpoints into single-slot mailboxes (one atomic store, newest
+// wins) and return at once; the owner thread applies the latest setpoints
+// every `period`, skipping values already on the hardware, so bus writes
+// come from one thread in a fixed order.
+//
+// emergencyBrake() is lock-free from any thread: it marks the brake and
+// wakes the owner through an eventfd. The owner applies it before any
+// pending setpoint and checks again before each throttle write; throttle
+// setpoints posted before the brake are discarded. While the owner thread
+// is not running, posts are applied on the calling thread.
+//
+// With speed control enabled, setTargetSpeed() posts a target in mm/s
+// instead of a throttle: each scheduled tick of the owner runs the PI loop
+// on the latest feedback value and writes the result like a throttle
+// setpoint. Whichever of setThrottle() and setTargetSpeed() was posted last
+// decides between open and closed loop; a brake ends closed loop until the
+// next target. The loop only runs on the owner thread.
+//
+// With adaptive braking enabled, a brake starts a BrakeController stop
+// instead of only locking the wheels: counter-torque from the live speed,
+// then the short brake to hold, stepped every kBrakePeriod until the car
+// stands. Repeated brakes continue the stop in progress; the next throttle
+// or target ends it.
+//
+// A tick hook runs on the owner thread at the start of every iteration,
+// scheduled or woken, before pending setpoints are applied; setpoints it
+// posts take effect in the same iteration.
+class ActuatorController {
+public:
+  struct Stats {
+    uint64_t throttle_requests = 0;
+    uint64_t steering_requests = 0;
+    uint64_t throttle_writes = 0;
+    uint64_t steering_writes = 0;
+    uint64_t skipped = 0; // setpoints equal to what the hardware already has
+    uint64_t emergency_brakes = 0;
+    uint64_t ticks = 0;
+  };
+
+  struct BrakeStats {
+    uint64_t stops = 0;    // stops measured to standstill
+    uint64_t timeouts = 0; // still moving after the brake timeout
+    double max_distance_mm = 0;
+    BrakeController::Result last;
+  };
+
+  struct SpeedLoopStats {
+    uint64_t target_requests = 0;
+    uint64_t steps = 0;
+    double jitter_avg_us = 0; // |tick interval - period|
+    double jitter_max_us = 0;
+    SpeedController::Stats tracking;
+  };
+
+  static constexpr std::chrono::milliseconds kBrakePeriod{2};
+
+  ActuatorController(std::shared_ptr<IBackMotors> motors,
+                     std::shared_ptr<IFServo> servo,
+                     std::chrono::milliseconds period =
+                         std::chrono::milliseconds(10));
+  ~ActuatorController();
+
+  ActuatorController(const ActuatorController &) = delete;
+  ActuatorController &operator=(const ActuatorController &) = delete;
+
+  void start();
+  void stop();
+  bool isRunning() const { return !stop_flag; }
+
+  void setThrottle(int throttle);
+  void setSteering(int angle);
+  void emergencyBrake();
+
+  // `feedback` returns the latest measured speed in mm/s; it is called on
+  // the owner thread once per tick while a target is active
+  void enableSpeedControl(std::function<double()> feedback,
+                          SpeedController::Config config =
+                              SpeedController::Config());
+  bool speedControlEnabled() const { return _speedControl; }
+  void setTargetSpeed(int target_mms);
+
+  // Same feedback contract as enableSpeedControl()
+  void enableAdaptiveBraking(std::function<double()> feedback,
+                             BrakeController::Config config =
+                                 BrakeController::Config());
+
+  // Set before start()
+  void setTickHook(std::function<void()> hook);
+  // Runs an owner iteration now without shifting the schedule
+  void wake() { wakeOwner(); }
+
+  // Applies whatever is pending on the calling thread
+  void applyPending();
+
+  Stats getStats() const;
+  SpeedLoopStats getSpeedLoopStats();
+  BrakeStats getBrakeStats();
+
+private:
+  // Mailbox slot: sequence number in the high 32 bits, value in the low 32.
+  // Sequence 0 means nothing was posted.
+  static uint64_t pack(uint32_t sequence, int value) {
+    return (static_cast<uint64_t>(sequence) << 32) |
+           static_cast<uint32_t>(value);
+  }
+  static uint32_t sequenceOf(uint64_t slot) {
+    return static_cast<uint32_t>(slot >> 32);
+  }
+  static int valueOf(uint64_t slot) {
+    return static_cast<int32_t>(static_cast<uint32_t>(slot));
+  }
+  static bool newer(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) > 0;
+  }
+
+  uint32_t nextSequence();
+  void post(std::atomic<uint64_t> &slot, int value);
+  void applyLocked();
+  void applyBrake();
+  bool supersededByBrake(uint32_t sequence) const;
+  void acceptThrottle(uint64_t slot);
+  void acceptTarget(uint64_t slot);
+  void writeThrottle(int value);
+  void stepSpeedLoop(std::chrono::steady_clock::time_point now);
+  void startStop();
+  void stepBrake(std::chrono::steady_clock::time_point now);
+  void applyBrakeCommand(const BrakeController::Command &command);
+  void endStop();
+  void wakeOwner();
+  void ownerLoop();
+
+  std::shared_ptr<IBackMotors> _motors;
+  std::shared_ptr<IFServo> _servo;
+  std::chrono::milliseconds _period;
+  std::function<void()> _tickHook;
+
+  std::atomic<uint32_t> _sequence{0};
+  std::atomic<uint64_t> _throttleSlot{0};
+  std::atomic<uint64_t> _steeringSlot{0};
+  std::atomic<uint64_t> _targetSlot{0};
+  std::atomic<uint32_t> _brakeSequence{0};
+
+  // Owner state, guarded by _applyMutex (uncontended while the owner runs)
+  std::mutex _applyMutex;
+  uint32_t _handledThrottle = 0;
+  uint32_t _handledSteering = 0;
+  uint32_t _handledBrake = 0;
+  uint32_t _handledTarget = 0;
+  bool _throttleKnown = false;
+  int _appliedThrottle = 0;
+  bool _steeringKnown = false;
+  int _appliedSteering = 0;
+
+  // Closed loop, guarded by _applyMutex as well
+  std::atomic<bool> _speedControl{false};
+  std::function<double()> _speedFeedback;
+  SpeedController _speedController;
+  bool _closedLoop = false;
+  int _targetSpeed = 0;
+  bool _stepped = false;
+  std::chrono::steady_clock::time_point _lastStep;
+  uint64_t _steps = 0;
+  uint64_t _intervals = 0;
+  double _jitterTotalUs = 0;
+  double _jitterMaxUs = 0;
+
+  // Adaptive braking, guarded by _applyMutex as well
+  bool _adaptiveBraking = false;
+  BrakeController _brakeController;
+  bool _braking = false;
+  bool _holding = false;
+  int _driveDirection = 0; // sign of the last non-zero drive command
+  std::chrono::steady_clock::time_point _lastBrakeStep;
+  uint64_t _stops = 0;
+  uint64_t _stopTimeouts = 0;
+  double _maxStopDistance = 0;
+
+  std::atomic<uint64_t> _throttleRequests{0};
+  std::atomic<uint64_t> _steeringRequests{0};
+  std::atomic<uint64_t> _targetRequests{0};
+  std::atomic<uint64_t> _throttleWrites{0};
+  std::atomic<uint64_t> _steeringWrites{0};
+  std::atomic<uint64_t> _skipped{0};
+  std::atomic<uint64_t> _emergencyBrakes{0};
+  std::atomic<uint64_t> _ticks{0};
+
+  std::atomic<bool> stop_flag{true};
+  int _wakeFd = -1;
+  std::thread _ownerThread;
+};
+
+#endif
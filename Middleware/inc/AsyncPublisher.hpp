@@ -0,0 +1,97 @@
+#ifndef ASYNC_PUBLISHER_HPP
+#define ASYNC_PUBLISHER_HPP
+
+#include "ZmqPublisher.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// IPublisher front-end that lets any number of threads publish through one
+// socket. ZMQ sockets must only be used by one thread, so send() copies the
+// message into a bounded lock-free MPSC ring and returns; an owner thread
+// drains the ring in batches and is the only caller of the wrapped
+// publisher.
+//
+// Producers never wait for socket I/O. When the ring is full the message is
+// dropped (DropNewest) or the producer spins until a slot frees up (Block);
+// both cases are counted in Stats::backpressure. Slots keep their string
+// capacity, so steady-state publishing does not allocate.
+class AsyncPublisher : public IPublisher {
+public:
+  enum class OverflowPolicy { DropNewest, Block };
+
+  struct Stats {
+    uint64_t enqueued = 0;
+    uint64_t sent = 0;
+    uint64_t dropped = 0;
+    uint64_t backpressure = 0; // sends that found the ring full
+    uint64_t batches = 0;
+    uint64_t max_depth = 0;
+  };
+
+  // capacity must be a power of two
+  explicit AsyncPublisher(std::shared_ptr<IPublisher> inner,
+                          size_t capacity = 1024,
+                          OverflowPolicy policy = OverflowPolicy::DropNewest);
+  ~AsyncPublisher() override;
+
+  AsyncPublisher(const AsyncPublisher &) = delete;
+  AsyncPublisher &operator=(const AsyncPublisher &) = delete;
+
+  void send(const std::string &message) override;
+  void send(std::string_view message) override;
+  using IPublisher::send;
+
+  // Messages sent before start() are queued and published once it runs;
+  // stop() publishes everything still queued before returning
+  void start();
+  void stop();
+
+  size_t getCapacity() const { return _mask + 1; }
+  Stats getStats() const;
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    std::string data;
+  };
+
+  bool tryEnqueue(std::string_view message);
+  size_t drainBatch();
+  void drainLoop();
+
+  std::shared_ptr<IPublisher> _inner;
+  OverflowPolicy _policy;
+  std::vector<Slot> _slots;
+  size_t _mask;
+
+  alignas(64) std::atomic<size_t> _enqueuePos{0};
+  alignas(64) size_t _dequeuePos = 0; // owner thread only
+
+  std::atomic<uint64_t> _enqueued{0};
+  std::atomic<uint64_t> _sent{0};
+  std::atomic<uint64_t> _dropped{0};
+  std::atomic<uint64_t> _backpressure{0};
+  std::atomic<uint64_t> _batches{0};
+  std::atomic<uint64_t> _maxDepth{0};
+
+  // The owner thread sleeps only when the ring is empty; producers take the
+  // mutex just to wake it, never to enqueue
+  std::atomic<bool> _sleeping{false};
+  std::atomic<bool> stop_flag{true};
+  std::mutex _wakeMutex;
+  std::condition_variable _wakeCv;
+  std::mutex _drainMutex; // one drainer at a time (thread, or stop())
+  std::thread _drainThread;
+
+  static constexpr size_t batch_size = 64;
+};
+
+#endif
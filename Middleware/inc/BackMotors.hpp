@@ -9,11 +9,15 @@
 #include <fstream>
 #include <iostream>
 #include <linux/i2c-dev.h> // Interface padrão do Linux para I2C
+#include <memory>
 #include <string>
 #include <sys/ioctl.h>
 #include <thread>
 #include <unistd.h> // Para close(), usleep()
 
+#include "I2cBus.hpp"
+#include "Pca9685.hpp"
+
 // Forward declaration
 class BackMotors;
 
@@ -34,9 +38,13 @@ public:
 class BackMotors : public IBackMotors {
 private:
   const int _motorAddr = 0x60;
+  // PWM registers are shadowed, so setSpeed() only sends the channels that
+  // change, as one auto-increment burst
+  Pca9685 _pwm;
+  std::shared_ptr<II2cDevice> _device;
 
 public:
-  int _fdMotor;
+  int _fdMotor = -1; // unused, as is the fd argument: I2cBus owns the adapter
   BackMotors();
   ~BackMotors() override;
   void open_i2c_bus() override;
@@ -49,6 +57,11 @@ public:
   uint8_t readByteData(int fd, uint8_t reg) override;
 
   int getFdMotor() override;
+
+  // Routes all register access to `device` instead of the shared I2cBus
+  // device attached by open_i2c_bus()
+  void attachDevice(std::shared_ptr<II2cDevice> device);
+  Pca9685::Stats getPwmStats() const;
 };
 
 #endif
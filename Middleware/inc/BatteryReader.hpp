@@ -1,16 +1,16 @@
 #ifndef BATTERYREADER_HPP
 #define BATTERYREADER_HPP
+#include "I2cBus.hpp"
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
-#include <fcntl.h>
 #include <iomanip>
 #include <iostream>
-#include <linux/i2c-dev.h>
 #include <map>
+#include <memory>
 #include <stdexcept>
-#include <sys/ioctl.h>
 #include <thread>
-#include <unistd.h>
 #include <vector>
 
 // Interface for battery reading functionality
@@ -25,9 +25,32 @@ public:
   virtual bool isCharging() = 0;
 };
 
+// INA219 reader. The sensor runs in continuous shunt+bus mode with 128-sample
+// hardware averaging; conversions are fetched only when the conversion-ready
+// flag is set and the cached sample is older than the refresh interval, so
+// the public getters normally cost no bus traffic at all.
 class BatteryReader : public IBatteryReader {
 private:
-  int i2c_fd = -1;
+  // INA219 registers
+  static constexpr uint8_t REG_CONFIG = 0x00;
+  static constexpr uint8_t REG_SHUNT = 0x01;
+  static constexpr uint8_t REG_BUS = 0x02;
+  static constexpr uint8_t REG_POWER = 0x03;
+  // 32V range, /8 PGA, 128-sample averaging on bus and shunt ADCs (68.1ms
+  // each), shunt and bus continuous
+  static constexpr uint16_t CONFIG_AVG128_CONTINUOUS = 0x3FFF;
+  // Bus voltage register bit 1: conversion ready (cleared by reading power)
+  static constexpr uint16_t BUS_CNVR = 0x0002;
+
+  struct Sample {
+    int bus_adc = 0;
+    int shunt_adc = 0;
+    int charge = 0;
+    std::chrono::steady_clock::time_point sample_time;
+  };
+
+  // INA219 on the shared bus, behind motor and servo traffic
+  std::shared_ptr<II2cDevice> device;
   int i2c_bus = 1;
   uint8_t adc_address = 0x41;
   float percent_old = 100.0f;
@@ -35,6 +58,15 @@ private:
   std::map<uint8_t, int> test_adc_values;
   int test_charge_value = 0;
 
+  std::chrono::milliseconds refresh_interval;
+  Sample cached;
+  bool cache_valid = false;
+  std::atomic<uint32_t> i2c_transactions{0};
+
+  uint16_t read_register(uint8_t reg);
+  void write_register(uint8_t reg, uint16_t value);
+  bool refresh();
+
   const float ADC_REF = 3.3f;     // Reference voltage of ADC = 3.3V (ADC
                                   // --Analog-to-Digital Converter-- )
   const uint16_t ADC_MAX = 65535; // Maximum value of ADC = 2^16-1(16-bit)
@@ -45,8 +77,16 @@ public:
   const float MAX_VOLTAGE = 12.6f; // Maximum voltage of battery = 12.6V
   const float MIN_VOLTAGE = 9.0f;  // Minimum voltage of battery = 9.0V
 
+  static constexpr std::chrono::milliseconds DEFAULT_REFRESH_INTERVAL{1000};
+
   // Constructor with test_mode parameter
-  BatteryReader(bool test_mode = false);
+  BatteryReader(bool test_mode = false,
+                std::chrono::milliseconds refresh_interval =
+                    DEFAULT_REFRESH_INTERVAL);
+  // Hardware mode on an already opened device
+  explicit BatteryReader(std::shared_ptr<II2cDevice> device,
+                         std::chrono::milliseconds refresh_interval =
+                             DEFAULT_REFRESH_INTERVAL);
   ~BatteryReader() override;
 
   // Hardware interface methods
@@ -59,7 +99,13 @@ public:
   unsigned int getPercentage() override;
   bool isCharging() override;
 
-  // Test mode methods
+  // Cached sample diagnostics
+  std::chrono::steady_clock::time_point getSampleTime() const {
+    return cached.sample_time;
+  }
+  uint32_t getTransactionCount() const { return i2c_transactions.load(); }
+
+  // Test mode methods (setting a value simulates a completed conversion)
   bool isInTestMode() const { return test_mode; }
   void setTestAdcValue(uint8_t reg, int value);
   void setTestChargeValue(int value);
@@ -0,0 +1,82 @@
+#ifndef BRAKE_CONTROLLER_HPP
+#define BRAKE_CONTROLLER_HPP
+
+#include <cstdint>
+
+// Emergency stop from live speed: full counter-torque against the direction
+// of travel while the car is fast, then the short brake (all channels high)
+// to hold. The Speed sensor reports magnitude only, averaged over up to
+// `averaging_window_s` and sent every `sample_period_s`, so driving in
+// reverse "until it reads zero" ends up driving backwards. The short brake
+// takes over at the first of:
+//  - the speed predicted lookahead() ahead (from the last two distinct
+//    readings) drops below `hold_below_mms`
+//  - a reading rises: under counter-torque that means the wheels already
+//    passed zero (readings in the first sample period predate the brake)
+//  - another update interval of counter-torque would exceed initial speed /
+//    `max_decel_mms2`, the shortest time the car can take to stop
+// Without a known direction it holds at once.
+//
+// Also measures the stop: distance integrated from the readings and time
+// until the sensor reads zero.
+class BrakeController {
+public:
+  struct Config {
+    double max_reverse = 100;        // counter-torque, % throttle
+    double hold_below_mms = 100;     // short brake below this predicted speed
+    double max_decel_mms2 = 6500;    // traction limit plus rolling friction
+    double sample_period_s = 0.05;   // Arduino speed frame period
+    double averaging_window_s = 0.2; // Speed::estimationWindow_us
+    double timeout_s = 3.0;          // stop measuring after this long
+
+    // A reading describes the middle of its window and is up to one period
+    // old when it arrives; the next one is another period away
+    double lookahead() const {
+      return averaging_window_s / 2 + sample_period_s;
+    }
+  };
+
+  struct Command {
+    bool hold = true; // short brake; otherwise apply `throttle`
+    int throttle = 0;
+  };
+
+  struct Result {
+    double initial_speed_mms = 0;
+    double distance_mm = 0;
+    double time_ms = 0;
+    double reverse_ms = 0; // of which with counter-torque
+    bool stopped = false;  // false: timed out still moving
+  };
+
+  BrakeController();
+  explicit BrakeController(Config config);
+
+  // `direction` of travel: sign of the last drive command, 0 if unknown
+  Command begin(int direction, double measured_mms);
+  Command update(double measured_mms, double dt_s);
+
+  // Braking and not yet stopped or timed out
+  bool isActive() const { return _active && !_finished; }
+  bool isFinished() const { return _finished; }
+  const Result &getResult() const { return _result; }
+  const Config &getConfig() const { return _config; }
+
+private:
+  Command command(double measured_mms);
+
+  Config _config;
+  bool _active = false;
+  bool _finished = false;
+  bool _holding = false;
+  int _direction = 0;
+  double _lastReading = 0;
+  double _lastReadingAt = 0;
+  double _slope = 0; // mm/s per second, from the last two distinct readings
+  bool _rising = false;
+  double _reverseBudget_s = 0;
+  double _tick_s = 0; // last update interval
+  Result _result;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef COMMAND_ARBITER_HPP
+#define COMMAND_ARBITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Decides who drives. Every source writes into its own slot: Manual and
+// Autonomous post commands, Emergency, Watchdog and Autonomous are engaged
+// or released. Writes are lock-free (a seqlock per command slot, one atomic
+// word per engagement) with one writer thread per slot; arbitrate() runs on
+// one thread, once per control tick, and turns a snapshot of the slots into
+// a Decision.
+//
+// Throttle, highest priority first:
+//   Emergency engaged: brake; the manual driver may back away in reverse
+//     once the car stands (and keep reversing while it moves)
+//   Watchdog engaged:  throttle ramps from its last value to 0
+//   otherwise the mode authority (Autonomous when engaged, else Manual)
+// Steering follows the mode authority, centred while the watchdog is engaged.
+// A steering assist (lane keeping) is added on top of the authority's last
+// steering, the sum clamped to the steering limit; it lapses after its max
+// age.
+//
+// Commands written before their source gained authority are ignored, so a
+// mode switch holds the actuators until the new authority speaks and a
+// released brake or watchdog leaves throttle 0 until a newer command. With
+// a max age set, an authority whose last throttle is older drives throttle 0.
+// Timestamps are steady-clock nanoseconds and must be positive.
+class CommandArbiter {
+public:
+  // Priority order
+  enum class Source : uint8_t {
+    Emergency = 0,
+    Watchdog = 1,
+    Autonomous = 2,
+    Manual = 3
+  };
+  static constexpr size_t kSources = 4;
+
+  struct Command {
+    bool has_throttle = false;
+    int throttle = 0;
+    bool has_steering = false;
+    int steering = 0;
+  };
+
+  enum class Action : uint8_t { Hold, Set, Brake };
+
+  struct Output {
+    Action action = Action::Hold;
+    int value = 0;
+    bool changed = false; // differs from what the previous decisions applied
+  };
+
+  struct Decision {
+    Source authority = Source::Manual; // source deciding the throttle
+    Output throttle;
+    Output steering; // Hold or Set
+    bool stale = false;
+    int assist = 0; // part of the steering added by the assist
+  };
+
+  struct Stats {
+    uint64_t ticks = 0;
+    uint64_t transitions = 0; // authority changes
+    uint64_t brakes = 0;
+    uint64_t stale = 0; // ticks with a stale authority
+    uint64_t assisted = 0; // ticks with a non-zero steering assist
+  };
+
+  CommandArbiter();
+
+  CommandArbiter(const CommandArbiter &) = delete;
+  CommandArbiter &operator=(const CommandArbiter &) = delete;
+
+  // 0 (the default) never goes stale; set before arbitrating
+  void setMaxAge(Source source, std::chrono::nanoseconds max_age);
+  // Time the watchdog takes the throttle to 0; 0 (the default) is at once
+  void setWatchdogRamp(std::chrono::nanoseconds ramp);
+  // Bound of steering with an assist, 1..90 degrees (default 90)
+  void setSteeringLimit(int degrees);
+  // 0 (the default) keeps an assist until it is replaced
+  void setAssistMaxAge(std::chrono::nanoseconds max_age);
+
+  void submit(Source source, const Command &command, int64_t now_ns);
+  // Returns the previous state; Manual cannot be engaged
+  bool engage(Source source, bool engaged, int64_t now_ns);
+  bool isEngaged(Source source) const;
+  // -90..90 degrees; returns whether it differs from the current assist
+  bool assist(int correction, int64_t now_ns);
+
+  Decision arbitrate(int64_t now_ns, unsigned int speed_mms);
+
+  Stats getStats() const;
+
+  static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+private:
+  static constexpr int64_t kNever = INT64_MIN;
+
+  struct Slot {
+    std::atomic<uint32_t> version{0};
+    std::atomic<int32_t> throttle{0};
+    std::atomic<int64_t> throttle_ns{kNever};
+    std::atomic<int32_t> steering{0};
+    std::atomic<int64_t> steering_ns{kNever};
+  };
+  struct SlotState {
+    int throttle;
+    int64_t throttle_ns;
+    int steering;
+    int64_t steering_ns;
+  };
+  struct Engagement {
+    bool engaged;
+    int64_t since_ns; // last change, 0 if never
+  };
+
+  SlotState read(Source source) const;
+  Engagement engagement(Source source) const;
+  int assistAt(int64_t now_ns) const;
+  static void apply(Output &output, Output &applied);
+
+  Slot _slots[kSources];
+  // (since_ns << 1) | engaged
+  std::atomic<int64_t> _engagement[kSources] = {};
+  int64_t _maxAge[kSources] = {};
+  int64_t _watchdogRamp = 0;
+  int _steeringLimit = 90;
+  int64_t _assistMaxAge = 0;
+  // Seqlock like the command slots, one writer (the lane thread)
+  std::atomic<uint32_t> _assistVersion{0};
+  std::atomic<int32_t> _assistCorrection{0};
+  std::atomic<int64_t> _assistNs{kNever};
+
+  // Arbiter thread only
+  Source _authority = Source::Manual;
+  bool _backingAway = false;
+  bool _rampStarted = false;
+  int _rampFrom = 0;
+  int _steeringBase = 0; // last steering from an authority
+  int _appliedAssist = 0;
+  Output _appliedThrottle;
+  Output _appliedSteering;
+
+  std::atomic<uint64_t> _ticks{0};
+  std::atomic<uint64_t> _transitions{0};
+  std::atomic<uint64_t> _brakes{0};
+  std::atomic<uint64_t> _stale{0};
+  std::atomic<uint64_t> _assisted{0};
+};
+
+#endif
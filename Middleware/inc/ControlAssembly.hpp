@@ -1,10 +1,20 @@
 #ifndef CONTROLASSEMBLY_HPP
 #define CONTROLASSEMBLY_HPP
 
+#include "ActuatorController.hpp"
 #include "BackMotors.hpp"
+#include "CommandArbiter.hpp"
+#include "ControlFrame.hpp"
+#include "ControlLinkMonitor.hpp"
 #include "ControlLogger.hpp"
+#include "ControlWatchdog.hpp"
 #include "FServo.hpp"
 #include "ISensor.hpp" // Add for speed data access
+#include "KeyValueCodec.hpp"
+#include "LaneAssist.hpp"
+#include "LatencyHistogram.hpp"
+#include "Reactor.hpp"
+#include "StatePublisher.hpp"
 #include "ZmqPublisher.hpp"
 #include "ZmqSubscriber.hpp"
 #include <atomic>
@@ -15,20 +25,39 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <unordered_map>
 #include <vector>
 
 class ControlAssembly {
 public:
+  // Autonomous commands carrying "frame_ts" and "seq" (see kv_codec)
+  struct AutonomousLinkStats {
+    ControlLinkMonitor::Stats link; // sequence checks, frame to receive
+    uint64_t too_old = 0;           // dropped, frame older than the max age
+    LatencyHistogram::Snapshot actuation; // frame capture to actuator tick
+  };
+
+  struct LaneAssistStats {
+    uint64_t updates = 0;     // lane messages seen
+    uint64_t corrections = 0; // correction changes
+    uint64_t assisted_ticks = 0;
+    LatencyHistogram::Snapshot latency; // lane message to actuator tick
+  };
+
   ControlAssembly(const std::string &address, zmq::context_t &context,
                   std::shared_ptr<IBackMotors> backMotors = nullptr,
                   std::shared_ptr<IFServo> fServo = nullptr,
-                  std::shared_ptr<ZmqPublisher> clusterPublisher = nullptr);
+                  std::shared_ptr<IPublisher> clusterPublisher = nullptr,
+                  const std::string &autonomousAddress =
+                      "tcp://127.0.0.1:5560");
   ~ControlAssembly();
 
+  // Hands both subscriber sockets to a shared reactor instead of running
+  // two polling threads; call before start() and before the reactor runs
+  void attachTo(Reactor &reactor);
+
   void start();
   void stop();
 
@@ -36,6 +65,36 @@ public:
   void
   setSpeedDataAccessor(std::function<std::shared_ptr<SensorData>()> accessor);
 
+  // Closed loop: throttle commands become target speeds in mm/s, tracked by
+  // a PI loop on the actuator thread using the speed data accessor's value.
+  // Call after setSpeedDataAccessor(); throws std::invalid_argument without
+  // speed data.
+  void enableSpeedControl(
+      SpeedController::Config config = SpeedController::Config());
+
+  // Emergency brakes become speed-adaptive stops (see BrakeController);
+  // same requirement as enableSpeedControl()
+  void enableAdaptiveBraking(
+      BrakeController::Config config = BrakeController::Config());
+
+  // Dead-man timer on the active command source: once it is silent past its
+  // timeout, throttle ramps to 0 and steering centres until it speaks again.
+  // Published as "watchdog:0|1;". Call before start().
+  void
+  enableWatchdog(ControlWatchdog::Config config = ControlWatchdog::Config());
+
+  // Autonomous commands whose perception frame is older than this when
+  // they arrive are dropped; 0 accepts any age. Default 200ms.
+  void setAutonomousMaxAge(std::chrono::milliseconds max_age);
+
+  // Steers back into the lane on lane departure messages fed to
+  // handleLaneKeeping(), blended into the steering of whoever drives.
+  // Call before start().
+  void enableLaneAssist(LaneAssist::Config config = LaneAssist::Config());
+  // Called by the LaneKeepingHandler for every lane message; does nothing
+  // unless the lane assist is enabled
+  void handleLaneKeeping(const LaneKeepingData &data);
+
   // Set emergency brake callback for direct communication with Distance sensor
   void setEmergencyBrakeCallback(std::function<void(bool)> callback);
 
@@ -43,22 +102,47 @@ public:
   // Distance sensor)
   void handleEmergencyBrake(bool emergency_active);
 
+  // Sequence, loss and latency counters of binary control frames
+  ControlLinkMonitor::Stats getControlLinkStats() const;
+  ActuatorController::Stats getActuatorStats() const;
+  ActuatorController::SpeedLoopStats getSpeedLoopStats();
+  ActuatorController::BrakeStats getBrakeStats();
+  CommandArbiter::Stats getArbiterStats() const;
+  ControlWatchdog::Stats getWatchdogStats() const;
+  AutonomousLinkStats getAutonomousLinkStats() const;
+  LaneAssistStats getLaneAssistStats() const;
+
   ZmqSubscriber zmq_subscriber;
 
 private:
   void receiveMessages();
+  void drainControlMessages();
   void handleMessage(const std::string &message);
+  void handleControlFrame(std::string_view data);
+  void applyCommand(const kv_codec::ControlCommand &command,
+                    const std::string &source);
   void receiveAutonomousMessages();
+  void drainAutonomousMessages();
   void handleAutonomousMessage(const std::string &message);
+  bool acceptAutonomousCommand(const kv_codec::ControlCommand &command,
+                               uint64_t received_ns);
   void sendModeStatus(bool auto_mode_active);
+  static StatePublishPolicy modeStatusPolicy();
   void performEmergencyBraking(); // Intelligent emergency braking method
+  void arbitrateSoon(bool urgent);
+  void feedWatchdog(CommandArbiter::Source source);
+  void updateWatchdog();
+  void arbitrate();
+  void applyThrottle(double throttle); // % open loop, mm/s closed loop
+  std::function<double()> speedFeedback() const;
 
   std::thread _listenerThread;
   std::thread _autonomousListenerThread;
+  bool _useReactor = false;
+  std::string _controlBuffer;    // reused, keeps its capacity between messages
+  std::string _autonomousBuffer; // reused, keeps its capacity between messages
   std::atomic<bool> stop_flag;
   std::mutex _startStopMutex;
-  std::atomic<bool> emergency_brake_active;
-  std::atomic<bool> auto_mode_active;
 
   // Speed data accessor for intelligent braking
   std::function<std::shared_ptr<SensorData>()> speed_data_accessor;
@@ -68,12 +152,34 @@ private:
 
   // ZMQ components
   std::unique_ptr<ZmqSubscriber> _autonomousSubscriber;
-  std::shared_ptr<ZmqPublisher> _clusterPublisher;
+  std::shared_ptr<IPublisher> _clusterPublisher;
+  std::unique_ptr<StatePublisher> _modeStatus; // "mode:0|1;" to the cluster
+  std::unique_ptr<StatePublisher> _watchdogStatus; // "watchdog:0|1;"
   zmq::context_t &_context;
 
   std::shared_ptr<IBackMotors> _backMotors;
   std::shared_ptr<IFServo> _fServo;
   ControlLogger _logger;
+  // Who drives: sources write their slots, the actuator owner's tick
+  // arbitrates; while the owner is stopped, writers arbitrate under the lock
+  CommandArbiter _arbiter;
+  std::mutex _arbiterMutex;
+  std::unique_ptr<ControlWatchdog> _watchdog;
+  // Only path to _backMotors/_fServo after construction
+  ActuatorController _actuators;
+  ControlLinkMonitor _controlLink;
+  ControlLinkMonitor _autonomousLink;
+  std::atomic<int64_t> _autonomousMaxAgeNs{200000000};
+  std::atomic<uint64_t> _autonomousTooOld{0};
+  // Capture time of the newest autonomous command not yet arbitrated
+  std::atomic<uint64_t> _pendingFrameNs{0};
+  LatencyHistogram _actuationLatency;
+  std::unique_ptr<LaneAssist> _laneAssist;
+  std::atomic<uint64_t> _laneUpdates{0};
+  std::atomic<uint64_t> _laneCorrections{0};
+  // Arrival of the newest lane correction not yet arbitrated
+  std::atomic<int64_t> _pendingLaneNs{0};
+  LatencyHistogram _laneLatency;
 };
 
 #endif
@@ -0,0 +1,56 @@
+#ifndef CONTROL_LINK_MONITOR_HPP
+#define CONTROL_LINK_MONITOR_HPP
+
+#include <cstdint>
+#include <mutex>
+
+// Tracks the control_frame stream from the Controller: sequence gaps,
+// reordered or duplicated frames and end-to-end latency from the sender's
+// timestamp. Text commands carry neither, they are only counted.
+class ControlLinkMonitor {
+public:
+  enum class Verdict {
+    InOrder,  // next expected frame (or the first one)
+    Gap,      // newer than expected, frames were lost in between
+    Stale,    // sent no later than one already seen; do not apply
+    Restarted // sender restarted its sequence
+  };
+
+  struct Stats {
+    uint64_t frames = 0;
+    uint64_t text_messages = 0;
+    uint64_t gaps = 0;      // gap events
+    uint64_t lost = 0;      // frames missing across all gaps
+    uint64_t stale = 0;     // reordered or duplicated frames
+    uint64_t restarts = 0;
+    uint64_t latency_last_us = 0;
+    uint64_t latency_avg_us = 0;
+    uint64_t latency_max_us = 0;
+  };
+
+  // A backwards jump larger than this is taken as a sender restart rather
+  // than a late frame
+  static constexpr uint32_t kReorderWindow = 1024;
+
+  // init marks the sender's first frame and resets the expected sequence.
+  // Sender and receiver share a steady clock, so a frame sent after the
+  // last one accepted is never stale: a smaller sequence then means the
+  // sender restarted, even if its init frame was lost. sent_ns 0 is unknown.
+  Verdict recordFrame(uint32_t sequence, uint64_t sent_ns,
+                      uint64_t received_ns, bool init = false);
+  void recordText();
+
+  Stats getStats() const;
+  void reset();
+
+private:
+  mutable std::mutex _mutex;
+  bool _haveSequence = false;
+  uint32_t _expected = 0;
+  uint64_t _lastSentNs = 0; // of the newest accepted frame
+  uint64_t _latencyTotalUs = 0;
+  uint64_t _latencySamples = 0;
+  Stats _stats;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CONTROLLOGGER_HPP
 #define CONTROLLOGGER_HPP
 
+#include "LogPath.hpp"
 #include <chrono>
 #include <fstream>
 #include <memory>
@@ -10,7 +11,7 @@
 class ControlLogger {
 public:
   explicit ControlLogger(
-      const std::string &log_file_path = "control_updates.log");
+      const std::string &log_file_path = logFilePath("control_updates.log"));
   ~ControlLogger();
 
   void logControlUpdate(const std::string &command, double steering,
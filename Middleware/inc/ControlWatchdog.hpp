@@ -0,0 +1,89 @@
+#ifndef CONTROL_WATCHDOG_HPP
+#define CONTROL_WATCHDOG_HPP
+
+#include "CommandArbiter.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Dead-man timer per command source. feed() records when a source was last
+// heard (one atomic store); a timerfd per source fires at its deadline on
+// the watchdog's own thread, which re-arms it if the source spoke since or
+// reports it as expired. A feed after expiry reports the recovery. A source
+// is watched from its first feed.
+//
+// Detection latency is the delay from a source's deadline to the handler.
+class ControlWatchdog {
+public:
+  using Source = CommandArbiter::Source;
+
+  struct Config {
+    std::chrono::milliseconds manual_timeout{300}; // 0 does not watch it
+    std::chrono::milliseconds autonomous_timeout{500};
+    std::chrono::milliseconds ramp_down{500}; // throttle to 0 after a timeout
+  };
+
+  struct Stats {
+    uint64_t timeouts = 0;
+    uint64_t recoveries = 0;
+    double latency_avg_us = 0; // deadline to handler
+    double latency_max_us = 0;
+  };
+
+  // expired: `source` went silent past its timeout; otherwise it spoke again.
+  // Runs on the watchdog thread.
+  using Handler = std::function<void(Source source, bool expired)>;
+
+  explicit ControlWatchdog(Handler handler);
+  ControlWatchdog(Handler handler, Config config);
+  ~ControlWatchdog();
+
+  ControlWatchdog(const ControlWatchdog &) = delete;
+  ControlWatchdog &operator=(const ControlWatchdog &) = delete;
+
+  void start();
+  void stop();
+  bool isRunning() const { return !stop_flag; }
+
+  // Lock-free; any thread
+  void feed(Source source);
+  bool isExpired(Source source) const;
+
+  const Config &getConfig() const { return _config; }
+  Stats getStats() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Channel {
+    int64_t timeout_ns = 0;
+    int timer_fd = -1;
+    std::atomic<int64_t> last_ns{0}; // 0: never heard
+    std::atomic<bool> armed{false};
+    std::atomic<bool> expired{false};
+  };
+
+  void check(Source source, int64_t now_ns);
+  void arm(Channel &channel, int64_t deadline_ns);
+  void wake();
+  void loop();
+
+  Handler _handler;
+  Config _config;
+  Channel _channels[CommandArbiter::kSources];
+
+  mutable std::mutex _statsMutex;
+  uint64_t _timeouts = 0;
+  uint64_t _recoveries = 0;
+  double _latencyTotalUs = 0;
+  double _latencyMaxUs = 0;
+
+  std::atomic<bool> stop_flag{true};
+  int _wakeFd = -1;
+  std::thread _thread;
+};
+
+#endif
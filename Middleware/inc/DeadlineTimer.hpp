@@ -0,0 +1,47 @@
+#ifndef DEADLINE_TIMER_HPP
+#define DEADLINE_TIMER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Thread that runs a flush function at the deadline it returns. The flush
+// gets the current time, sends whatever is due and returns its next
+// deadline (time_point::max() when nothing is scheduled). wake() makes the
+// thread flush at once, for when a new deadline may be earlier than the one
+// it is sleeping towards. Shared by the publishers that repeat or hold back
+// values on a timer.
+class DeadlineTimer {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Flush = std::function<Clock::time_point(Clock::time_point now)>;
+
+  // `name` labels flush errors in the log
+  DeadlineTimer(std::string name, Flush flush);
+  ~DeadlineTimer();
+
+  DeadlineTimer(const DeadlineTimer &) = delete;
+  DeadlineTimer &operator=(const DeadlineTimer &) = delete;
+
+  void start();
+  void stop();
+  void wake();
+
+private:
+  void run();
+
+  std::string _name;
+  Flush _flush;
+
+  std::atomic<bool> stop_flag{true};
+  bool _wake = false;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::thread _thread;
+};
+
+#endif
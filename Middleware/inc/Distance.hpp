@@ -2,6 +2,7 @@
 #define DISTANCE_HPP
 
 #include "CanMessageBus.hpp"
+#include "DistanceFilter.hpp"
 #include "ISensor.hpp"
 #include <chrono>
 #include <functional>
@@ -12,7 +13,8 @@ class Distance : public ISensor,
                  public ICanConsumer,
                  public std::enable_shared_from_this<Distance> {
 public:
-  explicit Distance();
+  // filter_window: Hampel window in samples (< 3 disables filtering)
+  explicit Distance(size_t filter_window = DistanceFilter::defaultWindow);
   ~Distance();
 
   // ISensor interface
@@ -32,6 +34,11 @@ public:
   // Set emergency brake callback (replaces ZMQ publisher)
   void setEmergencyBrakeCallback(std::function<void(bool)> callback);
 
+  // Raw SRF08 reading and the filtered value used for collision detection
+  uint16_t getRawDistance() const { return raw_distance_cm.load(); }
+  uint16_t getFilteredDistance() const { return current_distance_cm.load(); }
+  uint32_t getRejectedSamples() const;
+
 private:
   void readSensor() override;
   void checkUpdated() override;
@@ -63,8 +70,12 @@ private:
   // - Emergency: 20cm
   // - Warning: 25cm
 
+  // Outlier rejection, guarded by data_mutex
+  DistanceFilter filter;
+
   // Current state
-  std::atomic<uint16_t> current_distance_cm{0};
+  std::atomic<uint16_t> raw_distance_cm{0};
+  std::atomic<uint16_t> current_distance_cm{0}; // filtered
   std::atomic<int> risk_level{0}; // 0 = safe, 1 = warning, 2 = emergency
   std::atomic<bool> emergency_brake_active{false};
 };
@@ -0,0 +1,51 @@
+#ifndef DISTANCE_FILTER_HPP
+#define DISTANCE_FILTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Streaming Hampel filter for ultrasonic range readings.
+//
+// Each raw sample is compared with the median of the last `window` raw
+// samples; it is rejected as an outlier when it deviates from that median by
+// more than `threshold_sigma` scaled MADs (and at least `min_deviation_cm`).
+// A rejected sample is replaced by the window median.
+//
+// Latency bound: a sample that agrees with the previous raw sample is always
+// accepted, and the filter never rejects two samples in a row, so a genuine
+// step change reaches the output at most one frame late. Cost per sample is
+// O(window) with window <= maxWindow, i.e. constant.
+class DistanceFilter {
+public:
+  static constexpr size_t maxWindow = 9;
+  static constexpr size_t defaultWindow = 5;
+
+  explicit DistanceFilter(size_t window = defaultWindow,
+                          double threshold_sigma = 3.0,
+                          uint16_t min_deviation_cm = 15);
+
+  // Feed one raw reading, returns the filtered value
+  uint16_t filter(uint16_t raw_cm);
+  void reset();
+
+  size_t getWindow() const { return window_; }
+  bool lastRejected() const { return last_rejected_; }
+  uint32_t getRejectedCount() const { return rejected_count_; }
+
+private:
+  uint16_t median(std::array<uint16_t, maxWindow> &values, size_t n) const;
+
+  size_t window_;
+  double threshold_sigma_;
+  uint16_t min_deviation_cm_;
+
+  std::array<uint16_t, maxWindow> samples_{};
+  size_t head_ = 0;
+  size_t count_ = 0;
+  uint16_t last_raw_ = 0;
+  bool last_rejected_ = false;
+  uint32_t rejected_count_ = 0;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <iostream>
 #include <linux/i2c-dev.h> // Interface padrão do Linux para I2C
+#include <memory>
 #include <string>
 #include <sys/ioctl.h>
 #include <thread>
@@ -16,6 +17,9 @@
 #include <atomic>
 #include <chrono> // Para cálculos de tempo
 
+#include "I2cBus.hpp"
+#include "Pca9685.hpp"
+
 // Forward declaration
 class FServo;
 
@@ -42,9 +46,11 @@ private:
   const int _sterringChannel = 0;
 
   int _currentAngle;
+  Pca9685 _pwm;
+  std::shared_ptr<II2cDevice> _device;
 
 public:
-  int _fdServo;
+  int _fdServo = -1; // unused, as is the fd argument: I2cBus owns the adapter
   FServo();
 
   void open_i2c_bus() override;
@@ -55,6 +61,11 @@ public:
 
   void writeByteData(int fd, uint8_t reg, uint8_t value) override;
   uint8_t readByteData(int fd, uint8_t reg) override;
+
+  // Routes all register access to `device` instead of the shared I2cBus
+  // device attached by open_i2c_bus()
+  void attachDevice(std::shared_ptr<II2cDevice> device);
+  Pca9685::Stats getPwmStats() const;
 };
 
 #endif
@@ -0,0 +1,141 @@
+#ifndef I2C_BUS_HPP
+#define I2C_BUS_HPP
+
+#include "I2cDevice.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+// One message of a combined transaction, as in struct i2c_msg
+struct I2cMessage {
+  static constexpr uint16_t kRead = 0x0001; // I2C_M_RD
+
+  uint16_t address;
+  uint16_t flags;
+  uint16_t length;
+  uint8_t *buffer;
+};
+
+// Executes combined transactions on an adapter (repeated start between
+// messages). Errors throw std::runtime_error.
+class II2cAdapter {
+public:
+  virtual ~II2cAdapter() = default;
+  virtual void transfer(I2cMessage *messages, size_t count) = 0;
+};
+
+// /dev/i2c-N through the I2C_RDWR ioctl: one syscall per transaction and
+// the slave address travels with each message, so no I2C_SLAVE state
+class LinuxI2cAdapter : public II2cAdapter {
+public:
+  explicit LinuxI2cAdapter(const std::string &path);
+  ~LinuxI2cAdapter() override;
+
+  LinuxI2cAdapter(const LinuxI2cAdapter &) = delete;
+  LinuxI2cAdapter &operator=(const LinuxI2cAdapter &) = delete;
+
+  void transfer(I2cMessage *messages, size_t count) override;
+  int fd() const { return _fd; }
+
+private:
+  int _fd = -1;
+};
+
+// Lower value runs first
+enum class I2cPriority : uint8_t { Actuator = 0, Normal = 1, Background = 2 };
+
+// Owner of an I2C adapter shared by every driver in the process. Typed
+// transactions (write, write-then-read, burst) run one at a time; when the
+// bus is busy, callers queue and the bus is handed to the highest priority
+// waiter (FIFO within a priority) as each transaction ends, so motor and
+// servo writes never wait behind more than the transaction in flight.
+// Transactions run on the calling thread.
+class I2cBus {
+public:
+  static constexpr size_t kMaxBursts = 8;
+  static constexpr size_t kMaxBurstLength = 64;
+
+  struct DeviceStats {
+    uint64_t transactions = 0;
+    uint64_t errors = 0;
+    double wait_avg_us = 0; // queueing for the bus
+    double wait_max_us = 0;
+    double transfer_avg_us = 0; // on the bus
+    double transfer_max_us = 0;
+  };
+
+  // Process-wide manager for the car's /dev/i2c-1
+  static I2cBus &getInstance();
+
+  explicit I2cBus(std::shared_ptr<II2cAdapter> adapter = nullptr);
+
+  I2cBus(const I2cBus &) = delete;
+  I2cBus &operator=(const I2cBus &) = delete;
+
+  // Opens `path` unless an adapter is already attached; throws
+  // std::runtime_error when the device cannot be opened
+  void open(const std::string &path);
+  void setAdapter(std::shared_ptr<II2cAdapter> adapter);
+  bool isOpen() const;
+
+  // Register access to one device at `priority`; the bus must outlive it
+  std::shared_ptr<II2cDevice> device(uint16_t address, I2cPriority priority);
+
+  void write(uint16_t address, I2cPriority priority, uint8_t reg,
+             const uint8_t *data, size_t length);
+  void writeRead(uint16_t address, I2cPriority priority, uint8_t reg,
+                 uint8_t *out, size_t length);
+  void burst(uint16_t address, I2cPriority priority, const I2cBurst *bursts,
+             size_t count);
+
+  DeviceStats getStats(uint16_t address) const;
+  std::map<uint16_t, DeviceStats> getAllStats() const;
+
+private:
+  class Device;
+
+  struct Waiter {
+    Waiter(I2cPriority priority, uint64_t ticket)
+        : priority(priority), ticket(ticket) {}
+    I2cPriority priority;
+    uint64_t ticket;
+    bool granted = false;
+    std::condition_variable cv;
+  };
+  struct WaiterOrder {
+    bool operator()(const Waiter *a, const Waiter *b) const {
+      if (a->priority != b->priority) {
+        return a->priority > b->priority;
+      }
+      return a->ticket > b->ticket;
+    }
+  };
+
+  struct Accumulator {
+    uint64_t transactions = 0;
+    uint64_t errors = 0;
+    double wait_total_us = 0;
+    double wait_max_us = 0;
+    double transfer_total_us = 0;
+    double transfer_max_us = 0;
+  };
+
+  void execute(uint16_t address, I2cPriority priority, I2cMessage *messages,
+               size_t count);
+  static DeviceStats summarize(const Accumulator &accumulator);
+
+  mutable std::mutex _mutex;
+  std::shared_ptr<II2cAdapter> _adapter;
+  bool _busy = false;
+  uint64_t _tickets = 0;
+  std::priority_queue<Waiter *, std::vector<Waiter *>, WaiterOrder> _waiters;
+  std::map<uint16_t, Accumulator> _stats;
+};
+
+#endif
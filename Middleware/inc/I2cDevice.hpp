@@ -0,0 +1,40 @@
+#ifndef I2C_DEVICE_HPP
+#define I2C_DEVICE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// One register write: `length` bytes starting at `reg`. Devices with
+// register auto-increment (PCA9685, INA219 pointer writes) take the whole
+// run in a single I2C message.
+struct I2cBurst {
+  uint8_t reg;
+  const uint8_t *data;
+  size_t length;
+};
+
+// Register access to a single I2C device (see I2cBus::device()). Errors
+// throw std::runtime_error, like the byte-level writeByteData/readByteData
+// helpers.
+class II2cDevice {
+public:
+  virtual ~II2cDevice() = default;
+
+  // Sends all bursts as one bus transaction (repeated start between
+  // messages)
+  virtual void writeBursts(const I2cBurst *bursts, size_t count) = 0;
+  // Register pointer write followed by a read of `length` bytes
+  virtual void readRegisters(uint8_t reg, uint8_t *out, size_t length) = 0;
+
+  void writeRegister(uint8_t reg, uint8_t value) {
+    I2cBurst burst{reg, &value, 1};
+    writeBursts(&burst, 1);
+  }
+  uint8_t readRegister(uint8_t reg) {
+    uint8_t value = 0;
+    readRegisters(reg, &value, 1);
+    return value;
+  }
+};
+
+#endif
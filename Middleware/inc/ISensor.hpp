@@ -3,17 +3,21 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 struct SensorData {
   std::string name;
   std::atomic<unsigned int> value;
   std::atomic<unsigned int> oldValue;
-  std::chrono::time_point<std::chrono::steady_clock> timestamp;
+  // Written by the sensor's read thread, read by the publisher threads;
+  // stored before `updated` so a flagged change comes with its time
+  std::atomic<std::chrono::steady_clock::time_point> timestamp;
   bool critical;
   std::atomic<bool> updated;
 
@@ -33,10 +37,27 @@ public:
   virtual const std::string &getName() const = 0;
   virtual void updateSensorData() = 0;
 
+  // Called on the thread that receives new raw data, so the owner can run
+  // updateSensorData() at once instead of at its next poll
+  void setUpdateNotifier(std::function<void()> notifier) {
+    std::lock_guard<std::mutex> lock(_notifierMutex);
+    _updateNotifier = std::move(notifier);
+  }
+
 protected:
   mutable std::mutex sensor_mutex_; // For derived classes to use
 
+  void notifyUpdate() {
+    std::lock_guard<std::mutex> lock(_notifierMutex);
+    if (_updateNotifier) {
+      _updateNotifier();
+    }
+  }
+
 private:
+  std::mutex _notifierMutex;
+  std::function<void()> _updateNotifier;
+
   virtual void readSensor() = 0;
   virtual void checkUpdated() = 0;
 };
@@ -0,0 +1,41 @@
+#ifndef LANE_ASSIST_HPP
+#define LANE_ASSIST_HPP
+
+#include "LaneKeepingHandler.hpp"
+#include <chrono>
+#include <cstdint>
+
+// Lateral assist from lane departure warnings: while the car drifts out of
+// its lane it steers back, starting at `initial` degrees and growing by
+// `rate` degrees per second of departure up to `max_correction`; back in
+// the lane the correction is 0. Positive steering is to the right, so a
+// left deviation (lane_status 1) gives a positive correction.
+//
+// update() is called by one thread for every lane message; its result is
+// meant for CommandArbiter::assist(), which blends it into the steering.
+class LaneAssist {
+public:
+  struct Config {
+    int initial = 5;         // degrees, at the first departure message
+    double rate = 20;        // degrees per second of departure
+    int max_correction = 15; // degrees
+    int max_steering = 45;   // bound of steering plus correction
+    // The correction lapses when no lane message comes for this long
+    std::chrono::milliseconds timeout{250};
+  };
+
+  LaneAssist();
+  explicit LaneAssist(Config config);
+
+  // Correction for a lane message received at `now_ns` (steady clock)
+  int update(const LaneKeepingData &data, int64_t now_ns);
+
+  const Config &getConfig() const { return _config; }
+
+private:
+  Config _config;
+  int _direction = 0; // of the correction in progress
+  int64_t _departedNs = 0;
+};
+
+#endif
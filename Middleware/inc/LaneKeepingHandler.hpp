@@ -3,6 +3,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -11,6 +12,7 @@
 
 // Forward declarations
 class IPublisher;
+class Reactor;
 class ZmqSubscriber;
 
 // Structure to represent lane keeping assistance data
@@ -38,6 +40,14 @@ public:
   LaneKeepingHandler(LaneKeepingHandler &&) = delete;
   LaneKeepingHandler &operator=(LaneKeepingHandler &&) = delete;
 
+  // Receives on a shared reactor instead of an own thread; call before
+  // start() and before the reactor runs
+  void attachTo(Reactor &reactor);
+
+  // Receives every parsed lane message on the receiving thread before it is
+  // logged and relayed (the lane assist fast path); call before start()
+  void setLaneCallback(std::function<void(const LaneKeepingData &)> callback);
+
   void start();
   void stop();
 
@@ -46,6 +56,8 @@ public:
 
 private:
   void receiveAndProcessLaneData();
+  void drainLaneData(int timeout_ms);
+  void processTestData();
   void processLaneKeepingData(const std::string &original_data,
                               const LaneKeepingData &parsed_data);
   void publishLaneData(const std::string &original_data,
@@ -53,12 +65,15 @@ private:
 
   std::atomic<bool> stop_flag;
   std::thread processing_thread;
+  bool _useReactor = false;
+  std::string _receiveBuffer; // reused, keeps its capacity between messages
 
   mutable std::mutex data_mutex;
   std::condition_variable data_cv;
 
   std::unique_ptr<ZmqSubscriber> lkas_subscriber;
   std::shared_ptr<IPublisher> nc_publisher;
+  std::function<void(const LaneKeepingData &)> lane_callback;
 
   // Latest received data
   LaneKeepingData latest_data;
@@ -0,0 +1,46 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Latency distribution in fixed 1-2-5 buckets from 1ms to 1s plus an
+// overflow bucket. record() is a handful of relaxed atomic adds, so it can
+// sit on a control path; snapshot() may run on any thread (its fields may
+// be a sample apart from each other).
+class LatencyHistogram {
+public:
+  // Upper bounds, inclusive; the last bucket holds everything above
+  static constexpr std::array<uint64_t, 10> kBoundsUs = {
+      1000,  2000,   5000,   10000,  20000,
+      50000, 100000, 200000, 500000, 1000000};
+  static constexpr size_t kBuckets = kBoundsUs.size() + 1;
+
+  struct Snapshot {
+    uint64_t count = 0;
+    uint64_t avg_us = 0;
+    uint64_t max_us = 0;
+    std::array<uint64_t, kBuckets> buckets{};
+
+    // Upper bound of the bucket holding the p-th percentile (0..100);
+    // max_us when it falls into the overflow bucket
+    uint64_t percentileUs(double p) const;
+    // "<=1ms:3 <=2ms:10 ... >1s:0"
+    std::string toString() const;
+  };
+
+  void record(uint64_t latency_us);
+  Snapshot snapshot() const;
+  void reset();
+
+private:
+  std::array<std::atomic<uint64_t>, kBuckets> _buckets{};
+  std::atomic<uint64_t> _count{0};
+  std::atomic<uint64_t> _totalUs{0};
+  std::atomic<uint64_t> _maxUs{0};
+};
+
+#endif
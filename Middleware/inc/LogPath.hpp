@@ -0,0 +1,22 @@
+#ifndef LOG_PATH_HPP
+#define LOG_PATH_HPP
+
+#include <cstdlib>
+#include <string>
+
+// Where the default update logs go: the working directory, or
+// $MIDDLEWARE_LOG_DIR when set (the test runs point it at the build tree so
+// they do not litter the checkout)
+inline std::string logFilePath(const std::string &file_name) {
+  const char *dir = std::getenv("MIDDLEWARE_LOG_DIR");
+  if (dir == nullptr || *dir == '\0') {
+    return file_name;
+  }
+  std::string path(dir);
+  if (path.back() != '/') {
+    path += '/';
+  }
+  return path + file_name;
+}
+
+#endif
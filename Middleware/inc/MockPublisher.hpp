@@ -15,6 +15,7 @@ public:
     std::lock_guard<std::mutex> lock(mutex);
     messages.push_back(message);
   }
+  using IPublisher::send;
 
   // Methods for test verification
   std::vector<std::string> getMessages() const {
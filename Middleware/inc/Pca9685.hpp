@@ -0,0 +1,89 @@
+#ifndef PCA9685_HPP
+#define PCA9685_HPP
+
+#include "I2cDevice.hpp"
+#include <cstdint>
+#include <memory>
+
+// PCA9685 16-channel PWM driver shared by BackMotors and FServo.
+//
+// Keeps a shadow of the 64 LEDn_ON/OFF registers. setPwm() only marks a
+// channel dirty when its value differs from what the chip is known to
+// hold; flush() sends the dirty channels as auto-increment bursts (runs
+// separated by up to kMergeGap known channels are merged) in a single bus
+// transaction. Outside a Batch every setPwm() flushes at once.
+//
+// Not thread-safe: each chip has one owner (see ActuatorController).
+class Pca9685 {
+public:
+  static constexpr int kChannels = 16;
+  static constexpr int kMergeGap = 2;
+
+  struct Stats {
+    uint64_t transactions = 0; // bus transactions issued by flush()
+    uint64_t bytes = 0;        // register bytes written by flush()
+    uint64_t channel_writes = 0;
+    uint64_t skipped = 0; // setPwm() calls matching the shadow
+  };
+
+  // Defers flushing until the outermost Batch goes out of scope, so a
+  // multi-channel update costs one transaction. Errors are logged.
+  class Batch {
+  public:
+    explicit Batch(Pca9685 &pwm) : _pwm(pwm) { _pwm._batchDepth++; }
+    ~Batch();
+    Batch(const Batch &) = delete;
+    Batch &operator=(const Batch &) = delete;
+
+  private:
+    Pca9685 &_pwm;
+  };
+
+  Pca9685() = default;
+  explicit Pca9685(std::shared_ptr<II2cDevice> device);
+
+  // Replaces the device and forgets the shadow
+  void attach(std::shared_ptr<II2cDevice> device);
+  bool isAttached() const { return _device != nullptr; }
+
+  // Sleep, set the prescaler for the PWM frequency, wake with
+  // auto-increment enabled. Throws std::runtime_error on bus errors.
+  void init(double frequency_hz, uint8_t mode2 = kMode2OutDrv);
+
+  void setPwm(int channel, uint16_t on, uint16_t off);
+  void flush();
+
+  // Sets every channel with one 4-byte write to the ALL_LED registers,
+  // immediately and discarding anything staged in an open Batch
+  void setAll(uint16_t on, uint16_t off);
+
+  // Next write of every channel goes to the bus
+  void invalidate();
+
+  uint16_t getOn(int channel) const;
+  uint16_t getOff(int channel) const;
+  Stats getStats() const { return _stats; }
+
+  static constexpr uint8_t kMode1 = 0x00;
+  static constexpr uint8_t kMode2 = 0x01;
+  static constexpr uint8_t kLed0 = 0x06;
+  static constexpr uint8_t kAllLed = 0xFA;
+  static constexpr uint8_t kPrescale = 0xFE;
+  static constexpr uint8_t kMode1Restart = 0x80;
+  static constexpr uint8_t kMode1AutoIncrement = 0x20;
+  static constexpr uint8_t kMode1Sleep = 0x10;
+  static constexpr uint8_t kMode1AllCall = 0x01;
+  static constexpr uint8_t kMode2OutDrv = 0x04;
+
+  static uint8_t prescaleFor(double frequency_hz);
+
+private:
+  std::shared_ptr<II2cDevice> _device;
+  uint8_t _shadow[kChannels * 4] = {};
+  uint16_t _dirty = 0;
+  uint16_t _known = 0;
+  int _batchDepth = 0;
+  Stats _stats;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "CanMessageBus.hpp"
 #include "Distance.hpp"
 #include "ISensor.hpp"
+#include "SensorFrame.hpp"
 #include "SensorLogger.hpp"
 #include "Speed.hpp"
 #include "ZmqPublisher.hpp"
@@ -14,10 +15,25 @@
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 #include <zmq.hpp>
 
 class SensorHandler {
 public:
+  // Encoding used on the critical channel. Text ("name:value;") stays the
+  // default for existing consumers; Binary packs each tick into one
+  // sensor_frame message.
+  enum class WireFormat { Text, Binary };
+
+  // Publish counters; latency is measured from the SensorData timestamp to
+  // the send call
+  struct PublishStats {
+    uint64_t critical_messages = 0;
+    uint64_t non_critical_messages = 0;
+    uint64_t critical_latency_avg_us = 0;
+    uint64_t critical_latency_max_us = 0;
+  };
+
   explicit SensorHandler(const std::string &zmq_c_address,
                          const std::string &zmq_nc_address,
                          zmq::context_t &zmq_context,
@@ -39,13 +55,25 @@ public:
   void addSensor(const std::string &name, std::shared_ptr<ISensor> sensor);
   std::unordered_map<std::string, std::shared_ptr<ISensor>> getSensors() const;
 
+  PublishStats getPublishStats() const;
+
+  void setCriticalWireFormat(WireFormat format);
+
 private:
   void addSensors();
   void sortSensorData();
   void readSensors();
+  void watchSensor(const std::shared_ptr<ISensor> &sensor);
+  void wakeReader();
+  void collectDirtyChannels();
   void publishCritical();
   void publishNonCritical();
   void publishSensorData(const std::shared_ptr<SensorData> &sensorData);
+  void
+  publishCriticalFrame(const std::vector<std::shared_ptr<SensorData>> &batch);
+  void recordCriticalLatency(const SensorData &sensorData);
+  static void markDirty(std::vector<std::shared_ptr<SensorData>> &dirty,
+                        const std::shared_ptr<SensorData> &data);
 
   std::atomic<bool> stop_flag;
   std::thread critical_thread;
@@ -55,18 +83,44 @@ private:
   mutable std::mutex sensors_mutex;
   mutable std::mutex critical_mutex;
   mutable std::mutex non_critical_mutex;
-  std::condition_variable data_cv;
+  std::condition_variable critical_cv;
+  std::condition_variable non_critical_cv;
+  // Sensors with pushed data (CAN) wake the read thread through this instead
+  // of waiting out sensor_read_interval_ms
+  std::mutex read_mutex;
+  std::condition_variable read_cv;
+  bool read_pending = false; // read_mutex
 
   std::unordered_map<std::string, std::shared_ptr<ISensor>> _sensors;
   std::unordered_map<std::string, std::shared_ptr<SensorData>> _criticalData;
   std::unordered_map<std::string, std::shared_ptr<SensorData>> _nonCriticalData;
 
+  // All channels, guarded by sensors_mutex; the read thread consumes their
+  // updated flags into the dirty sets below. last_value filters out flags
+  // raised without an actual change.
+  struct Channel {
+    std::shared_ptr<SensorData> data;
+    unsigned int last_value = 0;
+    bool seen = false;
+  };
+  std::vector<Channel> _channels;
+  std::vector<std::shared_ptr<SensorData>> _criticalDirty;    // critical_mutex
+  std::vector<std::shared_ptr<SensorData>> _nonCriticalDirty; // non_critical_mutex
+
+  std::atomic<uint64_t> critical_messages{0};
+  std::atomic<uint64_t> non_critical_messages{0};
+  std::atomic<uint64_t> critical_latency_samples{0};
+  std::atomic<uint64_t> critical_latency_total_us{0};
+  std::atomic<uint64_t> critical_latency_max_us{0};
+
+  std::atomic<WireFormat> critical_wire_format{WireFormat::Text};
+  uint32_t critical_sequence = 0; // critical thread only
+
   std::shared_ptr<IPublisher> zmq_c_publisher;
   std::shared_ptr<IPublisher> zmq_nc_publisher;
   zmq::context_t &zmq_context;
   SensorLogger _logger;
 
-  static constexpr int critical_update_interval_ms = 50;
   static constexpr int non_critical_update_interval_ms = 200;
   static constexpr int sensor_read_interval_ms = 50;
 };
@@ -2,6 +2,7 @@
 #define SENSORLOGGER_HPP
 
 #include "ISensor.hpp"
+#include "LogPath.hpp"
 #include <chrono>
 #include <fstream>
 #include <memory>
@@ -11,7 +12,7 @@
 class SensorLogger {
 public:
   explicit SensorLogger(
-      const std::string &log_file_path = "sensor_updates.log");
+      const std::string &log_file_path = logFilePath("sensor_updates.log"));
   ~SensorLogger();
 
   void logSensorUpdate(const std::shared_ptr<SensorData> &sensorData);
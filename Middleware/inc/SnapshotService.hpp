@@ -0,0 +1,72 @@
+#ifndef SNAPSHOT_SERVICE_HPP
+#define SNAPSHOT_SERVICE_HPP
+
+#include "ZmqPublisher.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <zmq.hpp>
+
+// Serves the latest value of every published channel on a REP socket so a
+// cluster that (re)connects can sync in one round trip instead of waiting
+// for each value to change.
+//
+// Publishers are wrapped with tap(); every message is recorded before it is
+// forwarded, so a delta a client receives is never newer than a snapshot it
+// requests afterwards. Tap behind any filtering decorator (such as
+// TelemetryPolicyPublisher) so only messages actually sent are recorded and
+// counted. Clients subscribe first, request a snapshot, then
+// apply deltas (text deltas are last-value-wins; binary sensor frames with a
+// sequence number <= "frame" are already contained in the snapshot).
+//
+// Any request is answered with
+//   "seq:<N>;[frame:<M>;]<name>:<value>;..."
+// where N counts recorded updates and M is the last sensor_frame sequence.
+class SnapshotService {
+public:
+  SnapshotService(const std::string &address, zmq::context_t &context,
+                  bool test_mode = false);
+  ~SnapshotService();
+
+  void start();
+  void stop();
+
+  // Returns an IPublisher that records into this service, then forwards
+  std::shared_ptr<IPublisher> tap(std::shared_ptr<IPublisher> inner);
+
+  // Records one published message (text pairs or a binary sensor frame)
+  void record(std::string_view message);
+
+  std::string snapshot() const;
+  uint64_t getSequence() const;
+  uint64_t getRequestCount() const { return request_count.load(); }
+
+private:
+  class Tap;
+
+  void store(std::string_view name, std::string_view value);
+  void serveLoop();
+
+  std::string _address;
+  zmq::socket_t _socket;
+  bool _test_mode;
+  bool _is_bound = false;
+
+  mutable std::mutex _stateMutex;
+  std::map<std::string, std::string, std::less<>> _state;
+  uint64_t _sequence = 0;
+  uint32_t _frameSequence = 0;
+  bool _hasFrame = false;
+
+  std::atomic<bool> stop_flag{true};
+  std::atomic<uint64_t> request_count{0};
+  std::thread _serveThread;
+};
+
+#endif
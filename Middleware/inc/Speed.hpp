@@ -3,6 +3,7 @@
 
 #include "CanMessageBus.hpp"
 #include "ISensor.hpp"
+#include <array>
 #include <memory>
 #include <unordered_map>
 
@@ -27,15 +28,34 @@ public:
   void start();
   void stop();
 
+  // Diagnostics
+  uint32_t getDroppedFrames() const { return dropped_frames.load(); }
+  bool hasDeviceTiming() const { return device_timing_seen.load(); }
+
 private:
+  // One pulse edge as timestamped by the Arduino (micros() clock)
+  struct EdgeSample {
+    uint32_t total_interrupts;
+    uint32_t edge_us;
+  };
+
   void readSensor() override;
   void checkUpdated() override;
   void calculateSpeed();
-  void calculateOdo();
+  void calculateSpeedFromInterval(uint16_t interval_us);
+  void calculateSpeedFromEdges(uint32_t sample_us);
+  void calculateOdo(double pulses);
+  void storeSpeed(uint32_t speed_value);
+  void trackFrameContinuity(uint32_t new_total, uint16_t interval_us);
+  void pushEdgeSample(uint32_t total, uint32_t edge_us);
 
   static constexpr uint16_t canId = 0x100;
   static constexpr uint16_t canId2 = 0x180;
   static constexpr uint16_t canId3 = 0x580;
+  // Timing frame sent by the Arduino right before each pulse frame
+  static constexpr uint16_t timingCanId = 0x102;
+  static constexpr uint16_t timingCanId2 = 0x182;
+  static constexpr uint16_t timingCanId3 = 0x582;
   std::string _name;
   std::unordered_map<std::string, std::shared_ptr<SensorData>> _sensorData;
 
@@ -44,6 +64,17 @@ private:
       18; // 18 holes in the disc
   static constexpr float wheelDiameter_mm =
       67.0f; // Wheel diameter in millimeters
+  static constexpr double wheelCircumference_mm = wheelDiameter_mm * 3.14159;
+  static constexpr double mm_per_pulse =
+      wheelCircumference_mm / pulsesPerRevolution;
+  // The encoder ISR fires twice per physical hole; total_pulses counts
+  // interrupts while the per-interval delta counts holes
+  static constexpr uint32_t interruptsPerPulse = 2;
+
+  // Edge-timing filter parameters
+  static constexpr size_t edgeHistorySize = 8;
+  static constexpr uint32_t estimationWindow_us = 200000;
+  static constexpr uint32_t standstillTimeout_us = 500000;
 
   // Thread safety for CAN message handling
   mutable std::mutex data_mutex;
@@ -56,9 +87,28 @@ private:
   std::chrono::steady_clock::time_point latest_timestamp;
   std::chrono::steady_clock::time_point last_measurement_time;
 
+  // Device-side timing (0x102) waiting to be paired with its pulse frame
+  bool pending_timing_valid = false;
+  uint32_t pending_edge_us = 0;
+  uint32_t pending_sample_us = 0;
+  // Timing attached to latest_data
+  bool latest_timing_valid = false;
+  uint32_t latest_edge_us = 0;
+  uint32_t latest_sample_us = 0;
+
   // Pulse tracking
   uint16_t last_pulse_delta = 0;
   uint32_t total_pulses = 0;
+  bool have_total = false;
+  bool have_sample_time = false;
+  uint32_t last_sample_us = 0;
+  std::atomic<uint32_t> dropped_frames{0};
+  std::atomic<bool> device_timing_seen{false};
+
+  // Fixed-size ring of recent edges, oldest at edge_head
+  std::array<EdgeSample, edgeHistorySize> edge_history{};
+  size_t edge_head = 0;
+  size_t edge_count = 0;
 
   // Odometer precision tracking
   double accumulated_distance_m = 0.0;
@@ -0,0 +1,60 @@
+#ifndef SPEED_CONTROLLER_HPP
+#define SPEED_CONTROLLER_HPP
+
+#include <cstdint>
+
+// PI speed loop: target and measured speed in mm/s in, throttle percentage
+// out. The Speed sensor reports magnitude only, so the loop works on |target|
+// and drives in the direction of the target: the output is clamped to
+// [0, max_throttle] and takes the target's sign. The integrator only grows
+// until the output reaches its limit (anti-windup by clamping), so it never
+// has to unwind after a saturated stretch, and restarts from zero when the
+// target is zero or changes direction.
+class SpeedController {
+public:
+  struct Config {
+    double kp = 0.075;         // % throttle per mm/s of error
+    double ki = 0.25;          // % throttle per mm of integrated error
+    double max_throttle = 100; // output clamp, %
+  };
+
+  struct Stats {
+    uint64_t updates = 0;
+    uint64_t saturated = 0;    // updates with the output at a limit
+    double error_avg_mms = 0;  // mean |target - measured|
+    double error_rms_mms = 0;
+    double error_max_mms = 0;
+    double last_target_mms = 0;
+    double last_measured_mms = 0;
+    double last_output = 0;
+  };
+
+  SpeedController();
+  explicit SpeedController(Config config);
+
+  // One control step of `dt_s` seconds; returns the throttle to apply
+  double update(double target_mms, double measured_mms, double dt_s);
+
+  // Drops the integrator, e.g. after an emergency brake
+  void reset();
+
+  const Config &getConfig() const { return _config; }
+  Stats getStats() const;
+  void resetStats();
+
+private:
+  Config _config;
+  double _integral = 0;
+  int _direction = 0;
+
+  uint64_t _updates = 0;
+  uint64_t _saturated = 0;
+  double _errorSum = 0;
+  double _errorSquares = 0;
+  double _errorMax = 0;
+  double _lastTarget = 0;
+  double _lastMeasured = 0;
+  double _lastOutput = 0;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef STATE_PUBLISHER_HPP
+#define STATE_PUBLISHER_HPP
+
+#include "DeadlineTimer.hpp"
+#include "ZmqPublisher.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Publication policy for a slowly changing state value such as the mode.
+// A change is sent at once and then repeated `retransmits` times, waiting
+// `initial_backoff` before the first repeat and twice as long before each
+// following one, so a subscriber that misses the first copy still sees it
+// quickly. Otherwise the value is re-sent every `heartbeat`.
+struct StatePublishPolicy {
+  int retransmits = 3;
+  std::chrono::milliseconds initial_backoff{50};
+  std::chrono::milliseconds heartbeat{1000}; // 0 disables the heartbeat
+};
+
+// Publishes one "name:value;" state channel according to a
+// StatePublishPolicy. set() may be called at any rate from any thread;
+// repeated values cost a comparison and send nothing.
+class StatePublisher {
+public:
+  struct Stats {
+    uint64_t updates = 0;
+    uint64_t changes = 0;
+    uint64_t sent = 0;
+    uint64_t retransmits = 0;
+    uint64_t heartbeats = 0;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  StatePublisher(std::shared_ptr<IPublisher> publisher, std::string name,
+                 const StatePublishPolicy &policy = StatePublishPolicy());
+  ~StatePublisher();
+
+  StatePublisher(const StatePublisher &) = delete;
+  StatePublisher &operator=(const StatePublisher &) = delete;
+
+  void set(std::string_view value);
+
+  // Starts/stops the thread sending retransmits and heartbeats
+  void start();
+  void stop();
+
+  // Explicit-clock variants used by set() and the DeadlineTimer; exposed
+  // for deterministic tests
+  void set(std::string_view value, Clock::time_point now);
+  // Sends a due retransmit or heartbeat, returns the next deadline
+  Clock::time_point flushDue(Clock::time_point now);
+
+  std::string getValue() const;
+  Stats getStats() const;
+
+private:
+  void sendCurrent(Clock::time_point now);
+
+  std::shared_ptr<IPublisher> _publisher;
+  std::string _name;
+  StatePublishPolicy _policy;
+
+  mutable std::mutex _mutex;
+  bool _hasValue = false;
+  std::string _value;
+  std::string _message; // "name:value;", rebuilt only on change
+  Clock::time_point _lastSent{};
+  int _retransmitsLeft = 0;
+  std::chrono::milliseconds _backoff{0};
+  Clock::time_point _nextRetransmit{};
+  Stats _stats;
+
+  DeadlineTimer _timer; // last, so it stops before the state goes away
+};
+
+#endif
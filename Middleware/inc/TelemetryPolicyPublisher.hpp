@@ -0,0 +1,99 @@
+#ifndef TELEMETRY_POLICY_PUBLISHER_HPP
+#define TELEMETRY_POLICY_PUBLISHER_HPP
+
+#include "DeadlineTimer.hpp"
+#include "ZmqPublisher.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Publish policy for one "name:value;" channel.
+//
+// A new value is significant when it differs from the last published one by
+// at least `abs_deadband` or `rel_deadband` (fraction of the last value);
+// with both at zero any change is significant, and non-numeric values are
+// compared as text. Significant values are sent at most once per
+// `min_interval` (the latest one is held back and flushed when the interval
+// expires). When nothing was sent for `heartbeat`, the current value is sent
+// again, so the consumer never sees a value older than `heartbeat`.
+struct TelemetryPolicy {
+  double abs_deadband = 0.0;
+  double rel_deadband = 0.0;
+  std::chrono::milliseconds min_interval{0};
+  std::chrono::milliseconds heartbeat{0}; // 0 disables the heartbeat
+};
+
+// IPublisher decorator applying per-channel TelemetryPolicy rules before
+// forwarding to the wrapped publisher. Messages for channels without a policy
+// (and anything that is not a single "name:value;" pair) pass straight
+// through. State is O(1) per channel.
+class TelemetryPolicyPublisher : public IPublisher {
+public:
+  struct Stats {
+    uint64_t offered = 0;
+    uint64_t forwarded = 0;
+    uint64_t suppressed = 0;
+    uint64_t heartbeats = 0;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  explicit TelemetryPolicyPublisher(std::shared_ptr<IPublisher> inner);
+  ~TelemetryPolicyPublisher() override;
+
+  // Configure before start(); replaces any previous policy for the channel
+  void setPolicy(const std::string &channel, const TelemetryPolicy &policy);
+
+  void send(const std::string &message) override;
+  // Evaluates the policy on the view; held and forwarded messages reuse each
+  // channel's buffers, so steady-state publishing does not allocate
+  void send(std::string_view message) override;
+  using IPublisher::send;
+
+  // Starts/stops the thread that flushes held-back values and heartbeats
+  void start();
+  void stop();
+
+  // Policy evaluation with an explicit clock, used by send() and the
+  // DeadlineTimer; exposed for deterministic tests
+  void offer(std::string_view message, Clock::time_point now);
+  // Sends due held-back values and heartbeats, returns the next deadline
+  Clock::time_point flushDue(Clock::time_point now);
+
+  Stats getStats() const;
+
+private:
+  struct ChannelState {
+    TelemetryPolicy policy;
+    bool has_sent = false;
+    bool numeric = false;
+    double sent_value = 0.0;
+    std::string sent_text;
+    Clock::time_point sent_time{};
+    std::string latest;       // most recent full message
+    std::string latest_value; // its value part
+    bool pending = false;
+  };
+
+  static bool splitMessage(std::string_view message, std::string_view &name,
+                           std::string_view &value);
+  static bool parseNumber(const std::string &value, double &number);
+  static bool isSignificant(const ChannelState &state,
+                            const std::string &value);
+  void sendLatest(ChannelState &state, Clock::time_point now);
+
+  std::shared_ptr<IPublisher> _inner;
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, ChannelState> _channels;
+  std::string _lookup; // channel name key, reused across offers
+  Stats _stats;
+
+  DeadlineTimer _timer; // last, so it stops before the channels go away
+};
+
+#endif
@@ -4,12 +4,13 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <unordered_map>
 #include <zmq.hpp>
 
 // Forward declarations
 class IPublisher;
+class Reactor;
 class ZmqSubscriber;
 
 class TrafficSignHandler {
@@ -27,6 +28,10 @@ public:
   TrafficSignHandler(TrafficSignHandler &&) = delete;
   TrafficSignHandler &operator=(TrafficSignHandler &&) = delete;
 
+  // Receives on a shared reactor instead of an own thread; call before
+  // start() and before the reactor runs
+  void attachTo(Reactor &reactor);
+
   void start();
   void stop();
 
@@ -35,18 +40,21 @@ public:
 
 private:
   void receiveAndProcessTrafficSignData();
+  void drainTrafficSignData(int timeout_ms);
   void processTrafficSignMessage(const std::string &data);
 
   std::atomic<bool> stop_flag;
   std::thread processing_thread;
+  bool _useReactor = false;
+  std::string _receiveBuffer; // reused, keeps its capacity between messages
 
   std::unique_ptr<ZmqSubscriber> traffic_sign_subscriber;
   std::shared_ptr<IPublisher> nc_publisher;
 
   bool _test_mode;
 
-  // Map of publishable traffic signs: key = sign name, value = speed limit
-  static const std::unordered_map<std::string, std::string> publishable_signs;
+  // Cluster message ("sign:<value>") for a publishable sign, empty otherwise
+  static std::string_view clusterMessageFor(std::string_view sign_name);
 
   static constexpr int processing_interval_ms = 50; // Process every 50ms
 };
@@ -0,0 +1,453 @@
+#include "ActuatorController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+ActuatorController::ActuatorController(std::shared_ptr<IBackMotors> motors,
+                                       std::shared_ptr<IFServo> servo,
+                                       std::chrono::milliseconds period)
+    : _motors(std::move(motors)), _servo(std::move(servo)), _period(period) {
+  if (!_motors || !_servo) {
+    throw std::invalid_argument("ActuatorController needs motors and servo");
+  }
+  if (_period.count() <= 0) {
+    throw std::invalid_argument("ActuatorController period must be positive");
+  }
+  _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (_wakeFd < 0) {
+    throw std::runtime_error("ActuatorController eventfd failed");
+  }
+}
+
+ActuatorController::~ActuatorController() {
+  stop();
+  close(_wakeFd);
+}
+
+void ActuatorController::start() {
+  if (!stop_flag.exchange(false)) {
+    return; // already running
+  }
+  _ownerThread = std::thread(&ActuatorController::ownerLoop, this);
+}
+
+void ActuatorController::stop() {
+  stop_flag = true;
+  wakeOwner();
+  if (_ownerThread.joinable()) {
+    _ownerThread.join();
+  }
+}
+
+void ActuatorController::setTickHook(std::function<void()> hook) {
+  if (isRunning()) {
+    throw std::logic_error("Set the tick hook before start()");
+  }
+  _tickHook = std::move(hook);
+}
+
+uint32_t ActuatorController::nextSequence() {
+  uint32_t sequence = _sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+  return sequence != 0 ? sequence
+                       : _sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void ActuatorController::post(std::atomic<uint64_t> &slot, int value) {
+  uint32_t sequence = nextSequence();
+  uint64_t desired = pack(sequence, value);
+  uint64_t current = slot.load(std::memory_order_relaxed);
+  // Two producers may race; the later sequence wins
+  while (newer(sequence, sequenceOf(current)) &&
+         !slot.compare_exchange_weak(current, desired,
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+  }
+  if (!isRunning()) {
+    applyPending();
+  }
+}
+
+void ActuatorController::setThrottle(int throttle) {
+  _throttleRequests.fetch_add(1, std::memory_order_relaxed);
+  post(_throttleSlot, throttle);
+}
+
+void ActuatorController::setSteering(int angle) {
+  _steeringRequests.fetch_add(1, std::memory_order_relaxed);
+  post(_steeringSlot, angle);
+}
+
+void ActuatorController::enableSpeedControl(std::function<double()> feedback,
+                                            SpeedController::Config config) {
+  if (!feedback) {
+    throw std::invalid_argument("Speed control needs a feedback source");
+  }
+  std::lock_guard<std::mutex> lock(_applyMutex);
+  _speedFeedback = std::move(feedback);
+  _speedController = SpeedController(config);
+  _speedControl = true;
+}
+
+void ActuatorController::enableAdaptiveBraking(
+    std::function<double()> feedback, BrakeController::Config config) {
+  if (!feedback) {
+    throw std::invalid_argument("Adaptive braking needs a feedback source");
+  }
+  std::lock_guard<std::mutex> lock(_applyMutex);
+  _speedFeedback = std::move(feedback);
+  _brakeController = BrakeController(config);
+  _adaptiveBraking = true;
+}
+
+void ActuatorController::setTargetSpeed(int target_mms) {
+  if (!_speedControl) {
+    throw std::logic_error("Speed control is not enabled");
+  }
+  _targetRequests.fetch_add(1, std::memory_order_relaxed);
+  post(_targetSlot, target_mms);
+}
+
+void ActuatorController::emergencyBrake() {
+  uint32_t sequence = nextSequence();
+  uint32_t current = _brakeSequence.load(std::memory_order_relaxed);
+  while (newer(sequence, current) &&
+         !_brakeSequence.compare_exchange_weak(current, sequence,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+  }
+  if (isRunning()) {
+    wakeOwner();
+  } else {
+    applyPending();
+  }
+}
+
+void ActuatorController::wakeOwner() {
+  // No lock and no allocation: safe from any thread, including one that
+  // holds locks the owner might need
+  uint64_t one = 1;
+  ssize_t written = write(_wakeFd, &one, sizeof(one));
+  (void)written; // EAGAIN means a wake-up is already pending
+}
+
+// Caller holds _applyMutex
+void ActuatorController::applyBrake() {
+  uint32_t brake = _brakeSequence.load(std::memory_order_acquire);
+  if (brake == _handledBrake) {
+    return;
+  }
+  _handledBrake = brake;
+  _throttleKnown = false; // the motors are no longer at a setpoint
+  _closedLoop = false;
+  _emergencyBrakes.fetch_add(1, std::memory_order_relaxed);
+  if (_adaptiveBraking) {
+    if (!_braking) {
+      startStop(); // repeated brakes continue the stop in progress
+    }
+    return;
+  }
+  try {
+    _motors->emergencyBrake();
+  } catch (const std::exception &e) {
+    std::cerr << "Actuator emergency brake failed: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Hardware error handling
+  }
+}
+
+void ActuatorController::applyPending() {
+  std::lock_guard<std::mutex> lock(_applyMutex);
+  applyLocked();
+}
+
+// Caller holds _applyMutex
+void ActuatorController::applyLocked() {
+  // Emergency first, whatever else is queued
+  applyBrake();
+
+  // Throttle and target speed drive the same motors; take the older post
+  // first so the newer one decides between open and closed loop
+  uint64_t throttle = _throttleSlot.load(std::memory_order_acquire);
+  uint64_t target = _targetSlot.load(std::memory_order_acquire);
+  bool throttlePosted = sequenceOf(throttle) != _handledThrottle;
+  bool targetPosted = sequenceOf(target) != _handledTarget;
+  if (throttlePosted && targetPosted &&
+      newer(sequenceOf(throttle), sequenceOf(target))) {
+    acceptTarget(target);
+    acceptThrottle(throttle);
+  } else {
+    if (throttlePosted) {
+      acceptThrottle(throttle);
+    }
+    if (targetPosted) {
+      acceptTarget(target);
+    }
+  }
+
+  uint64_t steering = _steeringSlot.load(std::memory_order_acquire);
+  if (sequenceOf(steering) != _handledSteering) {
+    _handledSteering = sequenceOf(steering);
+    int value = valueOf(steering);
+    if (_steeringKnown && value == _appliedSteering) {
+      _skipped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      try {
+        _servo->set_steering(value);
+        _appliedSteering = value;
+        _steeringKnown = true;
+        _steeringWrites.fetch_add(1, std::memory_order_relaxed);
+      } catch (const std::exception &e) {
+        _steeringKnown = false;
+        std::cerr << "Actuator steering write failed: " << e.what()
+                  << std::endl; // LCOV_EXCL_LINE - Hardware error handling
+      }
+    }
+  }
+}
+
+// Caller holds _applyMutex
+bool ActuatorController::supersededByBrake(uint32_t sequence) const {
+  return _handledBrake != 0 && !newer(sequence, _handledBrake);
+}
+
+// Caller holds _applyMutex
+void ActuatorController::acceptThrottle(uint64_t slot) {
+  _handledThrottle = sequenceOf(slot);
+  int value = valueOf(slot);
+  // A brake posted since the first check still goes first
+  applyBrake();
+  if (supersededByBrake(_handledThrottle)) {
+    return; // posted before the brake
+  }
+  _closedLoop = false;
+  endStop();
+  if (_throttleKnown && value == _appliedThrottle) {
+    _skipped.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    writeThrottle(value);
+  }
+}
+
+// Caller holds _applyMutex
+void ActuatorController::acceptTarget(uint64_t slot) {
+  _handledTarget = sequenceOf(slot);
+  applyBrake();
+  if (supersededByBrake(_handledTarget)) {
+    return;
+  }
+  endStop();
+  if (!_closedLoop) {
+    _speedController.reset();
+    _stepped = false;
+  }
+  _closedLoop = true;
+  _targetSpeed = valueOf(slot);
+}
+
+// Caller holds _applyMutex
+void ActuatorController::writeThrottle(int value) {
+  try {
+    _motors->setSpeed(value);
+    _appliedThrottle = value;
+    _throttleKnown = true;
+    if (!_braking && value != 0) {
+      _driveDirection = value > 0 ? 1 : -1;
+    }
+    _throttleWrites.fetch_add(1, std::memory_order_relaxed);
+  } catch (const std::exception &e) {
+    _throttleKnown = false;
+    std::cerr << "Actuator throttle write failed: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Hardware error handling
+  }
+}
+
+// Caller holds _applyMutex; runs once per scheduled tick
+void ActuatorController::stepSpeedLoop(
+    std::chrono::steady_clock::time_point now) {
+  applyBrake();
+  if (!_closedLoop) {
+    _stepped = false;
+    return;
+  }
+
+  double period_us =
+      std::chrono::duration<double, std::micro>(_period).count();
+  double dt_us = period_us;
+  if (_stepped) {
+    double interval_us =
+        std::chrono::duration<double, std::micro>(now - _lastStep).count();
+    double jitter_us = std::abs(interval_us - period_us);
+    _jitterTotalUs += jitter_us;
+    _jitterMaxUs = std::max(_jitterMaxUs, jitter_us);
+    _intervals++;
+    // After a stall, don't integrate the whole gap at once
+    dt_us = std::min(interval_us, 2 * period_us);
+  }
+  _lastStep = now;
+  _stepped = true;
+  _steps++;
+
+  double output =
+      _speedController.update(_targetSpeed, _speedFeedback(), dt_us / 1e6);
+  int value = static_cast<int>(std::lround(output));
+  if (!_throttleKnown || value != _appliedThrottle) {
+    writeThrottle(value);
+  }
+}
+
+// Caller holds _applyMutex
+void ActuatorController::startStop() {
+  _braking = true;
+  _holding = false;
+  _lastBrakeStep = std::chrono::steady_clock::now();
+  applyBrakeCommand(_brakeController.begin(_driveDirection, _speedFeedback()));
+  if (_brakeController.isFinished()) {
+    _stops++; // already standing
+  }
+}
+
+// Caller holds _applyMutex; runs once per scheduled tick
+void ActuatorController::stepBrake(std::chrono::steady_clock::time_point now) {
+  if (!_braking || (!_brakeController.isActive() && _holding)) {
+    return;
+  }
+  double dt_s = std::chrono::duration<double>(now - _lastBrakeStep).count();
+  _lastBrakeStep = now;
+  bool measuring = _brakeController.isActive();
+  applyBrakeCommand(_brakeController.update(_speedFeedback(), dt_s));
+  if (!measuring || _brakeController.isActive()) {
+    return;
+  }
+
+  const BrakeController::Result &result = _brakeController.getResult();
+  if (result.stopped) {
+    _stops++;
+  } else {
+    _stopTimeouts++;
+  }
+  _maxStopDistance = std::max(_maxStopDistance, result.distance_mm);
+  std::cout << "Emergency stop from " << result.initial_speed_mms
+            << " mm/s: " << result.distance_mm << " mm in " << result.time_ms
+            << " ms (" << result.reverse_ms << " ms counter-torque)"
+            << (result.stopped ? "" : ", still moving at timeout")
+            << std::endl; // LCOV_EXCL_LINE - Brake logging
+}
+
+// Caller holds _applyMutex
+void ActuatorController::applyBrakeCommand(
+    const BrakeController::Command &command) {
+  if (!command.hold) {
+    if (!_throttleKnown || command.throttle != _appliedThrottle) {
+      writeThrottle(command.throttle);
+    }
+    return;
+  }
+  if (_holding) {
+    return;
+  }
+  _throttleKnown = false;
+  try {
+    _motors->emergencyBrake();
+    _holding = true;
+  } catch (const std::exception &e) {
+    std::cerr << "Actuator emergency brake failed: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Hardware error handling
+  }
+}
+
+// Caller holds _applyMutex; a newer throttle or target releases the brake
+void ActuatorController::endStop() {
+  _braking = false;
+  _holding = false;
+}
+
+void ActuatorController::ownerLoop() {
+  auto next = std::chrono::steady_clock::now();
+  while (!stop_flag) {
+    // Wake-ups for a brake apply it without shifting the schedule
+    auto now = std::chrono::steady_clock::now();
+    bool scheduled = now >= next;
+    bool stopping;
+    if (_tickHook) {
+      _tickHook();
+    }
+    {
+      std::lock_guard<std::mutex> lock(_applyMutex);
+      applyLocked();
+      if (scheduled) {
+        stepSpeedLoop(now);
+        stepBrake(now);
+      }
+      stopping = _braking && (_brakeController.isActive() || !_holding);
+    }
+
+    // Faster ticks while an adaptive stop is in progress
+    std::chrono::milliseconds period = stopping ? kBrakePeriod : _period;
+    if (scheduled) {
+      _ticks.fetch_add(1, std::memory_order_relaxed);
+      // Fixed rate; after an overrun, restart the schedule from now
+      next += period;
+      if (next < now) {
+        next = now + period;
+      }
+    } else if (stopping) {
+      next = std::min(next, now + period);
+    }
+
+    auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        next - std::chrono::steady_clock::now());
+    if (wait.count() > 0 && !stop_flag) {
+      timespec timeout{static_cast<time_t>(wait.count() / 1000000000),
+                       static_cast<long>(wait.count() % 1000000000)};
+      pollfd item{_wakeFd, POLLIN, 0};
+      if (ppoll(&item, 1, &timeout, nullptr) > 0) {
+        uint64_t count;
+        ssize_t drained = read(_wakeFd, &count, sizeof(count));
+        (void)drained;
+      }
+    }
+  }
+  if (_tickHook) {
+    _tickHook();
+  }
+  applyPending(); // leave the last setpoints on the hardware
+}
+
+ActuatorController::Stats ActuatorController::getStats() const {
+  Stats stats;
+  stats.throttle_requests = _throttleRequests.load(std::memory_order_relaxed);
+  stats.steering_requests = _steeringRequests.load(std::memory_order_relaxed);
+  stats.throttle_writes = _throttleWrites.load(std::memory_order_relaxed);
+  stats.steering_writes = _steeringWrites.load(std::memory_order_relaxed);
+  stats.skipped = _skipped.load(std::memory_order_relaxed);
+  stats.emergency_brakes = _emergencyBrakes.load(std::memory_order_relaxed);
+  stats.ticks = _ticks.load(std::memory_order_relaxed);
+  return stats;
+}
+
+ActuatorController::SpeedLoopStats ActuatorController::getSpeedLoopStats() {
+  std::lock_guard<std::mutex> lock(_applyMutex);
+  SpeedLoopStats stats;
+  stats.target_requests = _targetRequests.load(std::memory_order_relaxed);
+  stats.steps = _steps;
+  if (_intervals > 0) {
+    stats.jitter_avg_us = _jitterTotalUs / _intervals;
+  }
+  stats.jitter_max_us = _jitterMaxUs;
+  stats.tracking = _speedController.getStats();
+  return stats;
+}
+
+ActuatorController::BrakeStats ActuatorController::getBrakeStats() {
+  std::lock_guard<std::mutex> lock(_applyMutex);
+  BrakeStats stats;
+  stats.stops = _stops;
+  stats.timeouts = _stopTimeouts;
+  stats.max_distance_mm = _maxStopDistance;
+  stats.last = _brakeController.getResult();
+  return stats;
+}
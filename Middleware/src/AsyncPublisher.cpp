@@ -0,0 +1,162 @@
+#include "AsyncPublisher.hpp"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+AsyncPublisher::AsyncPublisher(std::shared_ptr<IPublisher> inner,
+                               size_t capacity, OverflowPolicy policy)
+    : _inner(std::move(inner)), _policy(policy), _slots(capacity),
+      _mask(capacity - 1) {
+  if (!_inner) {
+    throw std::invalid_argument("AsyncPublisher needs a publisher");
+  }
+  if (capacity < 2 || (capacity & _mask) != 0) {
+    throw std::invalid_argument("AsyncPublisher capacity must be a power of "
+                                "two");
+  }
+  for (size_t i = 0; i < capacity; ++i) {
+    _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+AsyncPublisher::~AsyncPublisher() { stop(); }
+
+void AsyncPublisher::send(const std::string &message) {
+  send(std::string_view(message));
+}
+
+void AsyncPublisher::send(std::string_view message) {
+  bool queued = tryEnqueue(message);
+  if (!queued) {
+    _backpressure.fetch_add(1, std::memory_order_relaxed);
+    // Blocking only makes sense while the owner thread frees slots
+    while (!queued && _policy == OverflowPolicy::Block && !stop_flag.load()) {
+      std::this_thread::yield();
+      queued = tryEnqueue(message);
+    }
+    if (!queued) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  _enqueued.fetch_add(1, std::memory_order_relaxed);
+
+  // Pairs with the fence in drainLoop(): either the owner sees the new
+  // message before sleeping, or we see it sleeping and wake it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_sleeping.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(_wakeMutex);
+    _wakeCv.notify_one();
+  }
+}
+
+bool AsyncPublisher::tryEnqueue(std::string_view message) {
+  // Bounded MPSC ring (Vyukov): a slot is free for position pos when its
+  // sequence equals pos, and holds a message once it is pos + 1
+  size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &_slots[pos & _mask];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+    if (diff == 0) {
+      if (_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false; // full
+    } else {
+      pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  slot->data.assign(message.data(), message.size());
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+size_t AsyncPublisher::drainBatch() {
+  std::lock_guard<std::mutex> lock(_drainMutex);
+
+  uint64_t depth = _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos;
+  if (depth > _maxDepth.load(std::memory_order_relaxed)) {
+    _maxDepth.store(depth, std::memory_order_relaxed);
+  }
+
+  size_t count = 0;
+  while (count < batch_size) {
+    Slot &slot = _slots[_dequeuePos & _mask];
+    if (slot.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+      break; // empty, or the producer is still copying
+    }
+    try {
+      _inner->send(std::string_view(slot.data));
+    } catch (const std::exception &e) {
+      std::cerr << "Error in async publisher: " << e.what()
+                << std::endl; // LCOV_EXCL_LINE - Error handling
+    }
+    slot.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+    _dequeuePos++;
+    count++;
+  }
+
+  if (count > 0) {
+    _sent.fetch_add(count, std::memory_order_relaxed);
+    _batches.fetch_add(1, std::memory_order_relaxed);
+  }
+  return count;
+}
+
+void AsyncPublisher::start() {
+  if (!stop_flag.exchange(false)) {
+    return; // already running
+  }
+  _drainThread = std::thread(&AsyncPublisher::drainLoop, this);
+}
+
+void AsyncPublisher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_wakeMutex);
+    stop_flag = true;
+  }
+  _wakeCv.notify_all();
+  if (_drainThread.joinable()) {
+    _drainThread.join();
+  }
+  // Publish whatever was queued before (or while) stopping
+  while (drainBatch() > 0) {
+  }
+}
+
+void AsyncPublisher::drainLoop() {
+  // Producers wake the thread after every enqueue; the timeout is only a
+  // safety net
+  constexpr auto idle_period = std::chrono::milliseconds(100);
+
+  while (!stop_flag) {
+    if (drainBatch() > 0) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    _sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    _wakeCv.wait_for(lock, idle_period, [this] {
+      const Slot &slot = _slots[_dequeuePos & _mask];
+      return stop_flag ||
+             slot.sequence.load(std::memory_order_acquire) == _dequeuePos + 1;
+    });
+    _sleeping.store(false, std::memory_order_relaxed);
+  }
+}
+
+AsyncPublisher::Stats AsyncPublisher::getStats() const {
+  Stats stats;
+  stats.enqueued = _enqueued.load();
+  stats.sent = _sent.load();
+  stats.dropped = _dropped.load();
+  stats.backpressure = _backpressure.load();
+  stats.batches = _batches.load();
+  stats.max_depth = _maxDepth.load();
+  return stats;
+}
@@ -4,46 +4,23 @@ BackMotors::BackMotors() {}
 
 // LCOV_EXCL_START - Hardware I2C initialization, not testable in unit tests
 void BackMotors::open_i2c_bus() {
-  std::string i2c_device = "/dev/i2c-1";
-  _fdMotor = open(i2c_device.c_str(), O_RDWR);
-  if (_fdMotor < 0)
-    throw std::runtime_error("Error open I2C");
-  if (ioctl(_fdMotor, I2C_SLAVE, _motorAddr) < 0) {
-    close(_fdMotor);
-    throw std::runtime_error("Erro ao configurar endereço I2C do motor.");
-  }
+  // The shared bus queues motor writes ahead of sensor polling
+  I2cBus &bus = I2cBus::getInstance();
+  bus.open("/dev/i2c-1");
+  attachDevice(bus.device(_motorAddr, I2cPriority::Actuator));
   std::cout << "JetCar inicializado com sucesso!" << std::endl;
 }
 // LCOV_EXCL_STOP
 
 BackMotors::~BackMotors() {
-  close(_fdMotor);                  // LCOV_EXCL_LINE - Hardware cleanup
   std::cout << "destructor call\n"; // LCOV_EXCL_LINE - Destructor logging
 }
 
 // LCOV_EXCL_START - Hardware motor initialization, not testable in unit tests
 bool BackMotors::init_motors() {
   try {
-    // Configure motor controller
-    this->writeByteData(_fdMotor, 0x00, 0x20);
-
-    // Set frequency to 60Hz
-    int preScale;
-    uint8_t oldMode, newMode;
-
-    oldMode = this->readByteData(_fdMotor, 0x00);
-    preScale = static_cast<int>(std::floor(25000000.0 / 4096.0 / 60 - 1));
-    newMode = (oldMode & 0x7F) | 0x10;
-
-    // Configurar o novo modo e frequência
-    this->writeByteData(_fdMotor, 0x00, newMode);
-    this->writeByteData(_fdMotor, 0xFE, preScale);
-    this->writeByteData(_fdMotor, 0x00, oldMode);
-
-    usleep(5000);
-
-    // Ativar auto-incremento
-    this->writeByteData(_fdMotor, 0x00, oldMode | 0xa1);
+    // 60Hz, auto-increment on for the burst writes in setMotorPwm()
+    _pwm.init(60);
     // LCOV_EXCL_STOP
     return true;
   } catch (
@@ -59,10 +36,8 @@ bool BackMotors::init_motors() {
 bool BackMotors::setMotorPwm(const int channel, int value) {
   value = std::min(std::max(value, 0), 4095);
   try {
-    this->writeByteData(_fdMotor, 0x06 + 4 * channel, 0);
-    this->writeByteData(_fdMotor, 0x07 + 4 * channel, 0);
-    this->writeByteData(_fdMotor, 0x08 + 4 * channel, value & 0xFF);
-    this->writeByteData(_fdMotor, 0x09 + 4 * channel, value >> 8);
+    // Staged when called from setSpeed()/emergencyBrake(), sent otherwise
+    _pwm.setPwm(channel, 0, static_cast<uint16_t>(value));
     // LCOV_EXCL_STOP
     return true;
 
@@ -119,6 +94,9 @@ void BackMotors::setSpeed(int speed) {
   pwmRight = std::min(pwmRight, 4095) * _compRight;
   // LCOV_EXCL_STOP
 
+  // Both H-bridges go out in one transaction when the batch closes
+  Pca9685::Batch batch(_pwm);
+
   // LCOV_EXCL_START - Hardware motor control, not testable in unit tests
   // Enhanced acceleration profiles - faster PWM transitions
   if (leftSpeed > 0) {        // forward
@@ -154,10 +132,9 @@ void BackMotors::setSpeed(int speed) {
 // LCOV_EXCL_START - Hardware emergency brake, not testable in unit tests
 void BackMotors::emergencyBrake() {
   try {
-    // Set all PWM channels to maximum (4095) to lock the motors
-    for (int channel = 0; channel < 16; ++channel) {
-      setMotorPwm(channel, 4095);
-    }
+    // Set all PWM channels to maximum (4095) to lock the motors, in one
+    // 4-byte write to the ALL_LED registers
+    _pwm.setAll(0, 4095);
     std::cout << "Emergency brake activated - all motors locked!" << std::endl;
     // LCOV_EXCL_STOP
   } catch (
@@ -167,27 +144,27 @@ void BackMotors::emergencyBrake() {
   }
 }
 
-// LCOV_EXCL_START - Hardware I2C write, not testable in unit tests
-void BackMotors::writeByteData(int fd, uint8_t reg, uint8_t value) {
-  uint8_t buffer[2] = {reg, value};
-  if (write(fd, buffer, 2) != 2) {
+void BackMotors::writeByteData(int, uint8_t reg, uint8_t value) {
+  if (!_device) {
     throw std::runtime_error("Erro ao escrever no dispositivo I2C.");
   }
+  _device->writeRegister(reg, value);
 }
-// LCOV_EXCL_STOP
 
-// LCOV_EXCL_START - Hardware I2C read, not testable in unit tests
-uint8_t BackMotors::readByteData(int fd, uint8_t reg) {
-  if (write(fd, &reg, 1) != 1)
-    throw std::runtime_error(
-        "Erro ao enviar o registrador ao dispositivo I2C.");
-  uint8_t value;
-  if (read(fd, &value, 1) != 1)
+uint8_t BackMotors::readByteData(int, uint8_t reg) {
+  if (!_device) {
     throw std::runtime_error("Erro ao ler o registrador ao dispositivo I2C.");
-  return value;
+  }
+  return _device->readRegister(reg);
 }
-// LCOV_EXCL_STOP
 
 int BackMotors::getFdMotor() {
   return _fdMotor;
 } // LCOV_EXCL_LINE - Hardware accessor
+
+void BackMotors::attachDevice(std::shared_ptr<II2cDevice> device) {
+  _device = device;
+  _pwm.attach(std::move(device));
+}
+
+Pca9685::Stats BackMotors::getPwmStats() const { return _pwm.getStats(); }
@@ -44,17 +44,8 @@ void Battery::readSensor() {
   _sensorData["charging"]->value.store(charging);
   // _sensorData["power"]->value.store(20);
 
-  // Battery charging cheat. only goes up while charging, only goes down while
-  // not charging
-  if (!oldBattery) {
-    return;
-  } else if (charging) {
-    auto new_value = (battery > oldBattery ? battery : oldBattery);
-    _sensorData["battery"]->value.store(new_value);
-  } else {
-    auto new_value = (battery < oldBattery ? battery : oldBattery);
-    _sensorData["battery"]->value.store(new_value);
-  }
+  // No smoothing here: BatteryReader delivers hardware-averaged INA219
+  // samples, so readings are reported as measured
 
   // Update timestamps using steady_clock
   auto now = std::chrono::steady_clock::now();
@@ -1,27 +1,17 @@
 #include "BatteryReader.hpp"
 
-BatteryReader::BatteryReader(bool test_mode) : test_mode(test_mode) {
+BatteryReader::BatteryReader(bool test_mode,
+                             std::chrono::milliseconds refresh_interval)
+    : test_mode(test_mode), refresh_interval(refresh_interval) {
   if (!test_mode) {
     // LCOV_EXCL_START - Hardware I2C initialization, not testable in unit tests
-    try {
-      std::string i2c_device = "/dev/i2c-" + std::to_string(i2c_bus);
-      i2c_fd = open(i2c_device.c_str(), O_RDWR);
-      if (i2c_fd < 0) {
-        throw std::runtime_error("Failed to open I2C bus: " + i2c_device);
-      }
-
-      if (ioctl(i2c_fd, I2C_SLAVE, adc_address) < 0) {
-        close(i2c_fd);
-        throw std::runtime_error("Failed to set I2C slave address: " +
-                                 std::to_string(adc_address));
-      }
-    } catch (...) {      // LCOV_EXCL_LINE - Hardware error handling
-      if (i2c_fd >= 0) { // LCOV_EXCL_LINE - Hardware cleanup in error path
-        close(i2c_fd);   // LCOV_EXCL_LINE - Hardware cleanup in error path
-        i2c_fd = -1;     // LCOV_EXCL_LINE - Hardware error handling
-      }
-      throw; // LCOV_EXCL_LINE - Hardware error handling
-    }
+    I2cBus &bus = I2cBus::getInstance();
+    bus.open("/dev/i2c-" + std::to_string(i2c_bus));
+    device = bus.device(adc_address, I2cPriority::Background);
+
+    // Let the sensor average and convert on its own; reads then only
+    // collect finished results
+    write_register(REG_CONFIG, CONFIG_AVG128_CONTINUOUS);
     // LCOV_EXCL_STOP
   } else {
     // Initialize with default test values
@@ -31,14 +21,39 @@ BatteryReader::BatteryReader(bool test_mode) : test_mode(test_mode) {
   }
 }
 
-BatteryReader::~BatteryReader() {
-  if (!test_mode && i2c_fd >= 0) {
-    close(i2c_fd);
+BatteryReader::BatteryReader(std::shared_ptr<II2cDevice> device,
+                             std::chrono::milliseconds refresh_interval)
+    : device(std::move(device)), refresh_interval(refresh_interval) {
+  if (!this->device) {
+    throw std::invalid_argument("BatteryReader needs an I2C device");
   }
+  write_register(REG_CONFIG, CONFIG_AVG128_CONTINUOUS);
+}
+
+BatteryReader::~BatteryReader() {}
+
+uint16_t BatteryReader::read_register(uint8_t reg) {
+  uint8_t data[2];
+
+  // Pointer write and read in one transaction
+  i2c_transactions.fetch_add(1);
+  device->readRegisters(reg, data, 2);
+
+  return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+void BatteryReader::write_register(uint8_t reg, uint16_t value) {
+  uint8_t data[2] = {static_cast<uint8_t>(value >> 8),
+                     static_cast<uint8_t>(value & 0xFF)};
+  I2cBurst burst{reg, data, sizeof(data)};
+
+  i2c_transactions.fetch_add(1);
+  device->writeBursts(&burst, 1);
 }
 
 int BatteryReader::read_adc(uint8_t reg) {
   if (test_mode) {
+    i2c_transactions.fetch_add(1);
     auto it = test_adc_values.find(reg);
     if (it != test_adc_values.end()) {
       return it->second;
@@ -47,18 +62,7 @@ int BatteryReader::read_adc(uint8_t reg) {
   }
 
   // LCOV_EXCL_START - Hardware I2C read, not testable in unit tests
-  uint8_t data[2];
-
-  if (write(i2c_fd, &reg, 1) != 1) {
-    throw std::runtime_error("Write failure on the I2C bus");
-  }
-
-  if (read(i2c_fd, data, 2) != 2) {
-    throw std::runtime_error("Failed to read from I2C bus");
-  }
-
-  int raw_value =
-      (data[0] << 8) | data[1]; // Combine the two bytes read into a raw value
+  int raw_value = read_register(reg);
   return (raw_value >> 3) & 0x1FFF; // Remove the 3 least significant bits
                                     // (status) & return the remaining 13 bits
   // LCOV_EXCL_STOP
@@ -69,34 +73,61 @@ int BatteryReader::read_charge() {
     return test_charge_value;
   }
 
-  uint8_t reg = 0x01;
+  i2c_transactions.fetch_add(1);
+  return static_cast<int>(device->readRegister(REG_SHUNT));
+}
+
+bool BatteryReader::refresh() {
+  auto now = std::chrono::steady_clock::now();
+  if (cache_valid && now - cached.sample_time < refresh_interval) {
+    return false;
+  }
 
-  if (write(i2c_fd, &reg, 1) != 1) {
-    throw std::runtime_error("Error sending I2C command.");
+  if (test_mode) {
+    cached.bus_adc = read_adc(REG_BUS);
+    cached.shunt_adc = read_adc(REG_SHUNT);
+    cached.charge = test_charge_value;
+    cached.sample_time = now;
+    cache_valid = true;
+    return true;
   }
-  uint8_t value;
-  if (read(i2c_fd, &value, 1) != 1) {
-    throw std::runtime_error("Error reading value from I2C register.");
+
+  // LCOV_EXCL_START - Hardware I2C read, not testable in unit tests
+  uint16_t bus_raw = read_register(REG_BUS);
+  if (cache_valid && !(bus_raw & BUS_CNVR)) {
+    return false; // Averaging still in progress, keep the previous sample
   }
 
-  return static_cast<int>(value);
+  uint16_t shunt_raw = read_register(REG_SHUNT);
+  read_register(REG_POWER); // Clears CNVR for the next conversion
+
+  cached.bus_adc = (bus_raw >> 3) & 0x1FFF;
+  cached.shunt_adc = (shunt_raw >> 3) & 0x1FFF;
+  // Same byte read_charge() fetches: the shunt register's high byte
+  cached.charge = shunt_raw >> 8;
+  cached.sample_time = now;
+  cache_valid = true;
+  return true;
+  // LCOV_EXCL_STOP
 }
 
 float BatteryReader::getVoltage() {
-  int adc_value = read_adc(0x02);
-  float voltage = adc_value * 0.004; // Each bit of the ADC represents 4mV
+  refresh();
+  float voltage = cached.bus_adc * 0.004; // Each bit of the ADC represents 4mV
   return voltage;
 }
 
 float BatteryReader::getShunt() {
-  int adc_value = read_adc(0x01);
-  float voltage = adc_value * 0.00001; // Each bit of the ADC represents 10µV
+  refresh();
+  float voltage =
+      cached.shunt_adc * 0.00001; // Each bit of the ADC represents 10µV
   // Validate: shunt voltage should never be negative in a real-world scenario
   return (voltage < 0.0f) ? 0.0f : voltage;
 }
 
 bool BatteryReader::isCharging() {
-  int value = read_charge();
+  refresh();
+  int value = cached.charge;
   return (value < 255 && value > 0);
 }
 
@@ -116,11 +147,13 @@ unsigned int BatteryReader::getPercentage() {
 void BatteryReader::setTestAdcValue(uint8_t reg, int value) {
   if (test_mode) {
     test_adc_values[reg] = value;
+    cache_valid = false;
   }
 }
 
 void BatteryReader::setTestChargeValue(int value) {
   if (test_mode) {
     test_charge_value = value;
+    cache_valid = false;
   }
 }
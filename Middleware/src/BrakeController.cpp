@@ -0,0 +1,78 @@
+#include "BrakeController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+BrakeController::BrakeController() : BrakeController(Config()) {}
+
+BrakeController::BrakeController(Config config) : _config(config) {
+  if (_config.max_reverse < 0 || _config.max_reverse > 100 ||
+      _config.hold_below_mms < 0 || _config.max_decel_mms2 <= 0 ||
+      _config.sample_period_s <= 0 || _config.averaging_window_s < 0 ||
+      _config.timeout_s <= 0) {
+    throw std::invalid_argument("Invalid BrakeController configuration");
+  }
+}
+
+BrakeController::Command BrakeController::begin(int direction,
+                                                double measured_mms) {
+  double speed = std::abs(measured_mms);
+  _active = true;
+  _finished = speed == 0;
+  _holding = direction == 0 || _config.max_reverse == 0;
+  _direction = direction > 0 ? 1 : direction < 0 ? -1 : 0;
+  _lastReading = speed;
+  _lastReadingAt = 0;
+  _slope = 0;
+  _rising = false;
+  _reverseBudget_s = speed / _config.max_decel_mms2;
+  _tick_s = 0;
+  _result = Result();
+  _result.initial_speed_mms = speed;
+  _result.stopped = _finished;
+  return command(speed);
+}
+
+BrakeController::Command BrakeController::update(double measured_mms,
+                                                 double dt_s) {
+  if (!isActive()) {
+    return Command();
+  }
+  double speed = std::abs(measured_mms);
+  _tick_s = dt_s;
+  _result.distance_mm += speed * dt_s;
+  _result.time_ms += dt_s * 1000;
+  if (!_holding) {
+    _result.reverse_ms += dt_s * 1000;
+  }
+
+  double now_s = _result.time_ms / 1000;
+  if (speed != _lastReading) {
+    _rising = speed > _lastReading && now_s > _config.sample_period_s;
+    _slope = (speed - _lastReading) / std::max(now_s - _lastReadingAt, 1e-3);
+    _lastReading = speed;
+    _lastReadingAt = now_s;
+  }
+
+  if (speed == 0 || now_s >= _config.timeout_s) {
+    _finished = true;
+    _result.stopped = speed == 0;
+    return Command();
+  }
+  return command(speed);
+}
+
+BrakeController::Command BrakeController::command(double speed) {
+  if (!_holding) {
+    double predicted = speed + std::min(_slope, 0.0) * _config.lookahead();
+    _holding = predicted <= _config.hold_below_mms || _rising ||
+               _result.reverse_ms / 1000 + _tick_s > _reverseBudget_s;
+  }
+  Command result;
+  if (!_holding) {
+    result.hold = false;
+    result.throttle =
+        -_direction * static_cast<int>(std::lround(_config.max_reverse));
+  }
+  return result;
+}
@@ -0,0 +1,244 @@
+#include "CommandArbiter.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+CommandArbiter::CommandArbiter() = default;
+
+void CommandArbiter::setMaxAge(Source source,
+                               std::chrono::nanoseconds max_age) {
+  _maxAge[static_cast<size_t>(source)] = max_age.count();
+}
+
+void CommandArbiter::setWatchdogRamp(std::chrono::nanoseconds ramp) {
+  _watchdogRamp = ramp.count();
+}
+
+void CommandArbiter::setSteeringLimit(int degrees) {
+  if (degrees < 1 || degrees > 90) {
+    throw std::invalid_argument("Steering limit must be 1..90 degrees");
+  }
+  _steeringLimit = degrees;
+}
+
+void CommandArbiter::setAssistMaxAge(std::chrono::nanoseconds max_age) {
+  _assistMaxAge = max_age.count();
+}
+
+void CommandArbiter::submit(Source source, const Command &command,
+                            int64_t now_ns) {
+  Slot &slot = _slots[static_cast<size_t>(source)];
+  // Seqlock: odd while writing; readers retry across a write
+  uint32_t version = slot.version.load(std::memory_order_relaxed);
+  slot.version.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if (command.has_throttle) {
+    slot.throttle.store(command.throttle, std::memory_order_relaxed);
+    slot.throttle_ns.store(now_ns, std::memory_order_relaxed);
+  }
+  if (command.has_steering) {
+    slot.steering.store(command.steering, std::memory_order_relaxed);
+    slot.steering_ns.store(now_ns, std::memory_order_relaxed);
+  }
+  slot.version.store(version + 2, std::memory_order_release);
+}
+
+CommandArbiter::SlotState CommandArbiter::read(Source source) const {
+  const Slot &slot = _slots[static_cast<size_t>(source)];
+  SlotState state;
+  uint32_t before;
+  uint32_t after;
+  do {
+    before = slot.version.load(std::memory_order_acquire);
+    state.throttle = slot.throttle.load(std::memory_order_relaxed);
+    state.throttle_ns = slot.throttle_ns.load(std::memory_order_relaxed);
+    state.steering = slot.steering.load(std::memory_order_relaxed);
+    state.steering_ns = slot.steering_ns.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = slot.version.load(std::memory_order_relaxed);
+  } while ((before & 1) != 0 || before != after);
+  return state;
+}
+
+bool CommandArbiter::engage(Source source, bool engaged, int64_t now_ns) {
+  if (source == Source::Manual) {
+    throw std::invalid_argument("The manual source is always engaged");
+  }
+  int64_t word = (now_ns << 1) | (engaged ? 1 : 0);
+  auto &slot = _engagement[static_cast<size_t>(source)];
+  int64_t previous = slot.load(std::memory_order_relaxed);
+  // Only changes move the timestamp; it marks when authority moved
+  while ((previous & 1) != (word & 1) &&
+         !slot.compare_exchange_weak(previous, word, std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+  }
+  return (previous & 1) != 0;
+}
+
+bool CommandArbiter::isEngaged(Source source) const {
+  return engagement(source).engaged;
+}
+
+CommandArbiter::Engagement CommandArbiter::engagement(Source source) const {
+  int64_t word = _engagement[static_cast<size_t>(source)].load(
+      std::memory_order_acquire);
+  return {(word & 1) != 0, word >> 1};
+}
+
+bool CommandArbiter::assist(int correction, int64_t now_ns) {
+  if (correction < -90 || correction > 90) {
+    throw std::invalid_argument("Steering assist must be -90..90 degrees");
+  }
+  bool changed = assistAt(now_ns) != correction;
+  uint32_t version = _assistVersion.load(std::memory_order_relaxed);
+  _assistVersion.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  _assistCorrection.store(correction, std::memory_order_relaxed);
+  _assistNs.store(now_ns, std::memory_order_relaxed);
+  _assistVersion.store(version + 2, std::memory_order_release);
+  return changed;
+}
+
+int CommandArbiter::assistAt(int64_t now_ns) const {
+  int correction;
+  int64_t since_ns;
+  uint32_t before;
+  uint32_t after;
+  do {
+    before = _assistVersion.load(std::memory_order_acquire);
+    correction = _assistCorrection.load(std::memory_order_relaxed);
+    since_ns = _assistNs.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = _assistVersion.load(std::memory_order_relaxed);
+  } while ((before & 1) != 0 || before != after);
+
+  if (since_ns == kNever ||
+      (_assistMaxAge > 0 && now_ns - since_ns > _assistMaxAge)) {
+    return 0;
+  }
+  return correction;
+}
+
+void CommandArbiter::apply(Output &output, Output &applied) {
+  if (output.action == Action::Hold) {
+    output.changed = false;
+    return;
+  }
+  output.changed =
+      output.action != applied.action ||
+      (output.action == Action::Set && output.value != applied.value);
+  applied = output;
+}
+
+CommandArbiter::Decision CommandArbiter::arbitrate(int64_t now_ns,
+                                                   unsigned int speed_mms) {
+  Engagement emergency = engagement(Source::Emergency);
+  Engagement watchdog = engagement(Source::Watchdog);
+  Engagement autonomous = engagement(Source::Autonomous);
+  Source mode = autonomous.engaged ? Source::Autonomous : Source::Manual;
+  int64_t mode_since = autonomous.since_ns;
+  SlotState state = read(mode);
+  bool has_throttle =
+      state.throttle_ns != kNever && state.throttle_ns >= mode_since;
+
+  Decision decision;
+  if (!watchdog.engaged || emergency.engaged) {
+    _rampStarted = false;
+  }
+  if (emergency.engaged) {
+    decision.authority = Source::Emergency;
+    bool reverse = mode == Source::Manual && has_throttle &&
+                   state.throttle_ns >= emergency.since_ns &&
+                   state.throttle < 0;
+    _backingAway = reverse && (_backingAway || speed_mms == 0);
+    if (_backingAway) {
+      decision.throttle = {Action::Set, state.throttle};
+    } else {
+      decision.throttle = {Action::Brake, 0};
+    }
+  } else if (watchdog.engaged) {
+    _backingAway = false;
+    decision.authority = Source::Watchdog;
+    if (!_rampStarted) {
+      _rampStarted = true;
+      bool driving = _appliedThrottle.action == Action::Set;
+      _rampFrom = driving ? _appliedThrottle.value : 0;
+    }
+    int64_t left = _watchdogRamp - (now_ns - watchdog.since_ns);
+    int value = 0;
+    if (left > 0) {
+      // Truncates towards 0
+      value = static_cast<int>(_rampFrom * left / _watchdogRamp);
+    }
+    decision.throttle = {Action::Set, value};
+  } else {
+    _backingAway = false;
+    decision.authority = mode;
+    int64_t released = std::max(emergency.since_ns, watchdog.since_ns);
+    int64_t max_age = _maxAge[static_cast<size_t>(mode)];
+    if (!has_throttle || state.throttle_ns < released) {
+      // Nothing from the authority since it took over
+      if (released > mode_since) {
+        decision.throttle = {Action::Set, 0};
+      }
+    } else if (max_age > 0 && now_ns - state.throttle_ns > max_age) {
+      decision.stale = true;
+      decision.throttle = {Action::Set, 0};
+    } else {
+      decision.throttle = {Action::Set, state.throttle};
+    }
+  }
+
+  if (watchdog.engaged) {
+    _steeringBase = 0;
+    _appliedAssist = 0;
+    decision.steering = {Action::Set, 0};
+  } else {
+    bool has_steering = state.steering_ns != kNever &&
+                        state.steering_ns >= mode_since &&
+                        state.steering_ns >= watchdog.since_ns;
+    if (has_steering) {
+      _steeringBase = state.steering;
+    }
+    decision.assist = assistAt(now_ns);
+    // Without an assist, holding keeps what the authority set last
+    if (has_steering || decision.assist != 0 || _appliedAssist != 0) {
+      int steering = _steeringBase;
+      if (decision.assist != 0) {
+        steering += decision.assist;
+        steering =
+            std::max(-_steeringLimit, std::min(_steeringLimit, steering));
+      }
+      decision.steering = {Action::Set, steering};
+    }
+    _appliedAssist = decision.assist;
+  }
+
+  apply(decision.throttle, _appliedThrottle);
+  apply(decision.steering, _appliedSteering);
+
+  _ticks.fetch_add(1, std::memory_order_relaxed);
+  if (decision.authority != _authority) {
+    _authority = decision.authority;
+    _transitions.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (decision.throttle.changed && decision.throttle.action == Action::Brake) {
+    _brakes.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (decision.stale) {
+    _stale.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (decision.assist != 0) {
+    _assisted.fetch_add(1, std::memory_order_relaxed);
+  }
+  return decision;
+}
+
+CommandArbiter::Stats CommandArbiter::getStats() const {
+  Stats stats;
+  stats.ticks = _ticks.load(std::memory_order_relaxed);
+  stats.transitions = _transitions.load(std::memory_order_relaxed);
+  stats.brakes = _brakes.load(std::memory_order_relaxed);
+  stats.stale = _stale.load(std::memory_order_relaxed);
+  stats.assisted = _assisted.load(std::memory_order_relaxed);
+  return stats;
+}
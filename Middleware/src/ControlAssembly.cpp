@@ -1,24 +1,50 @@
 #include "ControlAssembly.hpp"
+#include <stdexcept>
+
+namespace {
+
+using Source = CommandArbiter::Source;
+
+CommandArbiter::Command toRequest(const kv_codec::ControlCommand &command) {
+  CommandArbiter::Command request;
+  request.has_throttle = command.has_throttle;
+  request.throttle = static_cast<int>(command.throttle);
+  request.has_steering = command.has_steering;
+  request.steering = static_cast<int>(command.steering);
+  return request;
+}
+
+} // namespace
 
 ControlAssembly::ControlAssembly(const std::string &address,
                                  zmq::context_t &context,
                                  std::shared_ptr<IBackMotors> backMotors,
                                  std::shared_ptr<IFServo> fServo,
-                                 std::shared_ptr<ZmqPublisher> clusterPublisher)
-    : zmq_subscriber(address, context), stop_flag(true),
-      emergency_brake_active(false), auto_mode_active(false), _context(context),
+                                 std::shared_ptr<IPublisher> clusterPublisher,
+                                 const std::string &autonomousAddress)
+    // Every command counts: no conflation, so drains see the whole backlog
+    // and the link monitor's gaps are frames the network actually lost
+    : zmq_subscriber(address, context, false, ZmqSubscriber::Delivery::All),
+      stop_flag(true), _context(context),
       _backMotors(backMotors ? backMotors : std::make_shared<BackMotors>()),
       _fServo(fServo ? fServo : std::make_shared<FServo>()),
-      _clusterPublisher(clusterPublisher), _logger("control_updates.log") {
+      _clusterPublisher(clusterPublisher),
+      _logger(logFilePath("control_updates.log")),
+      _actuators(_backMotors, _fServo) {
+  _actuators.setTickHook([this] { arbitrate(); });
+  if (_clusterPublisher) {
+    _modeStatus = std::make_unique<StatePublisher>(_clusterPublisher, "mode",
+                                                   modeStatusPolicy());
+  }
+
   std::cout << "ControlAssembly initialized with ZMQ address: " << address
             << std::endl; // LCOV_EXCL_LINE - Initialization logging
 
   // Initialize autonomous control subscriber
-  const std::string autonomous_address = "tcp://127.0.0.1:5560";
-  _autonomousSubscriber =
-      std::make_unique<ZmqSubscriber>(autonomous_address, context);
+  _autonomousSubscriber = std::make_unique<ZmqSubscriber>(
+      autonomousAddress, context, false, ZmqSubscriber::Delivery::All);
   std::cout << "Autonomous control subscriber initialized with address: "
-            << autonomous_address
+            << autonomousAddress
             << std::endl; // LCOV_EXCL_LINE - Initialization logging
 
   // LCOV_EXCL_START - Hardware initialization, not testable in unit tests
@@ -57,14 +83,13 @@ ControlAssembly::~ControlAssembly() {
             << std::endl; // LCOV_EXCL_LINE - Shutdown logging
 
   // Deactivate auto mode and send status
-  if (auto_mode_active.load()) {
-    auto_mode_active.store(false);
+  if (_arbiter.engage(Source::Autonomous, false, CommandArbiter::nowNs())) {
     sendModeStatus(false);
   }
 
   stop();
-  _backMotors->setSpeed(0);
-  _fServo->set_steering(0);
+  _actuators.setThrottle(0);
+  _actuators.setSteering(0);
   std::cout << "Motor speed and steering set to 0"
             << std::endl; // LCOV_EXCL_LINE - Shutdown logging
 }
@@ -76,6 +101,113 @@ void ControlAssembly::setSpeedDataAccessor(
             << std::endl; // LCOV_EXCL_LINE - Configuration logging
 }
 
+std::function<double()> ControlAssembly::speedFeedback() const {
+  auto speed_data = speed_data_accessor ? speed_data_accessor() : nullptr;
+  if (!speed_data) {
+    throw std::invalid_argument(
+        "Speed feedback needs speed data; call setSpeedDataAccessor first");
+  }
+  return [speed_data] { return static_cast<double>(speed_data->value.load()); };
+}
+
+void ControlAssembly::enableSpeedControl(SpeedController::Config config) {
+  _actuators.enableSpeedControl(speedFeedback(), config);
+  std::cout << "Closed-loop speed control enabled, throttle is mm/s"
+            << std::endl; // LCOV_EXCL_LINE - Configuration logging
+}
+
+void ControlAssembly::enableAdaptiveBraking(BrakeController::Config config) {
+  _actuators.enableAdaptiveBraking(speedFeedback(), config);
+  std::cout << "Speed-adaptive emergency braking enabled"
+            << std::endl; // LCOV_EXCL_LINE - Configuration logging
+}
+
+void ControlAssembly::enableWatchdog(ControlWatchdog::Config config) {
+  std::lock_guard<std::mutex> lock(_startStopMutex);
+  if (!stop_flag) {
+    throw std::logic_error("Enable the watchdog before start()");
+  }
+  _watchdog = std::make_unique<ControlWatchdog>(
+      [this](Source, bool) { updateWatchdog(); }, config);
+  _arbiter.setWatchdogRamp(config.ramp_down);
+  if (_clusterPublisher) {
+    _watchdogStatus = std::make_unique<StatePublisher>(
+        _clusterPublisher, "watchdog", modeStatusPolicy());
+    _watchdogStatus->set("0");
+  }
+  std::cout << "Control watchdog enabled: manual "
+            << config.manual_timeout.count() << "ms, autonomous "
+            << config.autonomous_timeout.count() << "ms"
+            << std::endl; // LCOV_EXCL_LINE - Configuration logging
+}
+
+void ControlAssembly::enableLaneAssist(LaneAssist::Config config) {
+  std::lock_guard<std::mutex> lock(_startStopMutex);
+  if (!stop_flag) {
+    throw std::logic_error("Enable the lane assist before start()");
+  }
+  _laneAssist = std::make_unique<LaneAssist>(config);
+  _arbiter.setSteeringLimit(config.max_steering);
+  _arbiter.setAssistMaxAge(config.timeout);
+  std::cout << "Lane assist enabled: up to " << config.max_correction
+            << " degrees"
+            << std::endl; // LCOV_EXCL_LINE - Configuration logging
+}
+
+void ControlAssembly::handleLaneKeeping(const LaneKeepingData &data) {
+  if (!_laneAssist) {
+    return;
+  }
+  _laneUpdates.fetch_add(1, std::memory_order_relaxed);
+  int64_t now_ns = CommandArbiter::nowNs();
+  if (_arbiter.assist(_laneAssist->update(data, now_ns), now_ns)) {
+    _laneCorrections.fetch_add(1, std::memory_order_relaxed);
+    _pendingLaneNs.store(now_ns, std::memory_order_release);
+    // Departures are corrected at once, not at the next tick
+    arbitrateSoon(true);
+  }
+}
+
+void ControlAssembly::feedWatchdog(Source source) {
+  if (_watchdog) {
+    _watchdog->feed(source);
+  }
+}
+
+// Engages the arbiter's watchdog slot while the source in control is silent
+void ControlAssembly::updateWatchdog() {
+  Source active = _arbiter.isEngaged(Source::Autonomous) ? Source::Autonomous
+                                                         : Source::Manual;
+  bool lost = _watchdog->isExpired(active);
+  if (_arbiter.engage(Source::Watchdog, lost, CommandArbiter::nowNs()) ==
+      lost) {
+    return;
+  }
+  arbitrateSoon(true);
+  if (lost) {
+    std::cerr << "CONTROL LINK LOST - no "
+              << (active == Source::Autonomous ? "autonomous" : "manual")
+              << " commands, stopping"
+              << std::endl; // LCOV_EXCL_LINE - Watchdog logging
+    _logger.logControlUpdate("watchdog_timeout", 0, 0);
+  } else {
+    std::cout << "Control link restored"
+              << std::endl; // LCOV_EXCL_LINE - Watchdog logging
+    _logger.logControlUpdate("watchdog_recovered", 0, 0);
+  }
+  if (_watchdogStatus) {
+    _watchdogStatus->set(lost ? "1" : "0");
+  }
+}
+
+void ControlAssembly::applyThrottle(double throttle) {
+  if (_actuators.speedControlEnabled()) {
+    _actuators.setTargetSpeed(static_cast<int>(throttle));
+  } else {
+    _actuators.setThrottle(static_cast<int>(throttle));
+  }
+}
+
 void ControlAssembly::setEmergencyBrakeCallback(
     std::function<void(bool)> callback) {
   emergency_brake_callback = callback;
@@ -83,6 +215,21 @@ void ControlAssembly::setEmergencyBrakeCallback(
             << std::endl; // LCOV_EXCL_LINE - Configuration logging
 }
 
+void ControlAssembly::attachTo(Reactor &reactor) {
+  std::lock_guard<std::mutex> lock(_startStopMutex);
+  void *control_socket = zmq_subscriber.handle();
+  void *autonomous_socket = _autonomousSubscriber->handle();
+  if (!control_socket || !autonomous_socket) {
+    std::cerr << "ControlAssembly: subscribers not connected, keeping "
+                 "receiver threads"
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    return;
+  }
+  reactor.addSocket(control_socket, [this] { drainControlMessages(); });
+  reactor.addSocket(autonomous_socket, [this] { drainAutonomousMessages(); });
+  _useReactor = true;
+}
+
 void ControlAssembly::start() {
   std::lock_guard<std::mutex> lock(_startStopMutex);
 
@@ -93,6 +240,24 @@ void ControlAssembly::start() {
     return;
   }
 
+  if (_modeStatus) {
+    _modeStatus->start();
+  }
+  if (_watchdogStatus) {
+    _watchdogStatus->start();
+  }
+  _actuators.start();
+  if (_watchdog) {
+    _watchdog->start();
+  }
+
+  if (_useReactor) {
+    std::cout << "Starting ControlAssembly on the shared reactor"
+              << std::endl; // LCOV_EXCL_LINE - Thread management logging
+    stop_flag = false;
+    return;
+  }
+
   std::cout << "Starting ControlAssembly message receiver threads"
             << std::endl; // LCOV_EXCL_LINE - Thread management logging
   stop_flag = false;
@@ -127,6 +292,15 @@ void ControlAssembly::stop() {
 
   // Only stop if not already stopped
   if (!stop_flag.exchange(true)) {
+    if (_watchdog) {
+      _watchdog->stop();
+    }
+    if (_modeStatus) {
+      _modeStatus->stop();
+    }
+    if (_watchdogStatus) {
+      _watchdogStatus->stop();
+    }
     // Join threads with timeout to prevent hanging
     if (_listenerThread.joinable()) {
       _listenerThread.join();
@@ -138,6 +312,23 @@ void ControlAssembly::stop() {
       std::cout << "Autonomous control receiver thread joined"
                 << std::endl; // LCOV_EXCL_LINE - Thread management logging
     }
+    // Last, so setpoints from the receivers above are still applied
+    _actuators.stop();
+    LatencyHistogram::Snapshot latency = _actuationLatency.snapshot();
+    if (latency.count > 0) {
+      std::cout << "Autonomous frame-to-actuation latency: avg "
+                << latency.avg_us << "us, p99 <= " << latency.percentileUs(99)
+                << "us, max " << latency.max_us << "us ("
+                << latency.toString() << ")"
+                << std::endl; // LCOV_EXCL_LINE - Latency report
+    }
+    latency = _laneLatency.snapshot();
+    if (latency.count > 0) {
+      std::cout << "Lane assist correction latency: avg " << latency.avg_us
+                << "us, p99 <= " << latency.percentileUs(99) << "us, max "
+                << latency.max_us << "us (" << latency.toString() << ")"
+                << std::endl; // LCOV_EXCL_LINE - Latency report
+    }
   } else {
     std::cout << "ControlAssembly already stopped"
               << std::endl; // LCOV_EXCL_LINE - State logging
@@ -148,17 +339,7 @@ void ControlAssembly::receiveMessages() {
   std::cout << "Message receiver thread started"
             << std::endl; // LCOV_EXCL_LINE - Thread management logging
   while (!stop_flag) {
-    std::string message = zmq_subscriber.receive();
-
-    if (!message.empty()) {
-      std::cout << "Received control message: " << message
-                << std::endl; // LCOV_EXCL_LINE - Debug logging
-      handleMessage(message);
-    } else {
-      std::cout << "Received empty message"
-                << std::endl; // LCOV_EXCL_LINE - Debug logging
-    }
-
+    drainControlMessages();
     std::this_thread::sleep_for(
         std::chrono::milliseconds(10)); // Reduced from 50ms to 10ms
   }
@@ -166,44 +347,88 @@ void ControlAssembly::receiveMessages() {
             << std::endl; // LCOV_EXCL_LINE - Thread management logging
 }
 
-void ControlAssembly::handleMessage(const std::string &message) {
-  std::unordered_map<std::string, double> values;
-  std::stringstream ss(message);
-  std::string token;
-  // LCOV_EXCL_START - Debug logging and message parsing, not testable in unit
-  // tests
-  std::cout << "Parsing message: " << message << std::endl;
-  while (std::getline(ss, token, ';')) {
-    if (token.empty())
+void ControlAssembly::drainControlMessages() {
+  // Handle everything queued since the last wakeup. While stopped the
+  // socket is still drained, a reactor would otherwise keep reporting it.
+  while (zmq_subscriber.receiveInto(_controlBuffer)) {
+    if (stop_flag) {
       continue;
+    }
+    if (control_frame::isFrame(_controlBuffer.data(), _controlBuffer.size())) {
+      handleControlFrame(_controlBuffer);
+    } else {
+      std::cout << "Received control message: " << _controlBuffer
+                << std::endl; // LCOV_EXCL_LINE - Debug logging
+      handleMessage(_controlBuffer);
+    }
+  }
+}
 
-    std::string key;
-    double value;
-    std::stringstream ss_token(token);
-    std::getline(ss_token, key, ':');
-    ss_token >> value;
-    values[key] = value;
-    std::cout << "Parsed key: '" << key << "', value: " << value << std::endl;
+void ControlAssembly::handleControlFrame(std::string_view data) {
+  const uint64_t received_ns = control_frame::nowNs();
+  control_frame::Frame frame;
+  if (!control_frame::decode(data.data(), data.size(), frame)) {
+    std::cerr << "Dropping malformed control frame (" << data.size()
+              << " bytes)" << std::endl; // LCOV_EXCL_LINE - Error handling
+    return;
   }
-  // LCOV_EXCL_STOP
+
+  auto verdict =
+      _controlLink.recordFrame(frame.sequence, frame.timestamp_ns, received_ns,
+                               (frame.flags & control_frame::kInit) != 0);
+  if (verdict == ControlLinkMonitor::Verdict::Stale) {
+    // An older command must not override a newer one
+    std::cerr << "Dropping stale control frame " << frame.sequence
+              << std::endl; // LCOV_EXCL_LINE - Link diagnostics
+    return;
+  }
+  if (verdict == ControlLinkMonitor::Verdict::Gap) {
+    std::cerr << "Control frames lost before " << frame.sequence
+              << std::endl; // LCOV_EXCL_LINE - Link diagnostics
+  }
+
+  applyCommand(control_frame::toCommand(frame), "frame");
+}
+
+void ControlAssembly::handleMessage(const std::string &message) {
+  std::cout << "Parsing message: " << message
+            << std::endl; // LCOV_EXCL_LINE - Debug logging
+  _controlLink.recordText();
+  applyCommand(kv_codec::parseControl(message), message);
+}
+
+void ControlAssembly::applyCommand(const kv_codec::ControlCommand &command,
+                                   const std::string &source) {
+  feedWatchdog(Source::Manual);
 
   // Handle special 'init' message
-  if (message == "init;") {
+  if (command.init) {
     std::cout << "Received init message, resetting to zero values"
               << std::endl; // LCOV_EXCL_LINE - Message handling logging
-    emergency_brake_active.store(false);
-    _fServo->set_steering(0);
-    _backMotors->setSpeed(0);
+    CommandArbiter::Command zero;
+    zero.has_throttle = true;
+    zero.has_steering = true;
+    int64_t now = CommandArbiter::nowNs();
+    _arbiter.engage(Source::Emergency, false, now);
+    _arbiter.submit(Source::Manual, zero, now);
     _logger.logControlUpdate("init", 0, 0);
+    arbitrateSoon(true);
     return;
   }
 
   // Handle AUTO mode toggle commands with highest priority
-  if (values.find("auto_mode") != values.end()) {
-    bool new_auto_mode = (values["auto_mode"] != 0.0);
-    bool was_auto_active = auto_mode_active.exchange(new_auto_mode);
+  if (command.has_auto_mode) {
+    bool new_auto_mode = command.auto_mode;
+    bool was_auto_active = _arbiter.engage(Source::Autonomous, new_auto_mode,
+                                           CommandArbiter::nowNs());
 
     if (was_auto_active != new_auto_mode) {
+      // The new authority gets a full timeout to speak
+      feedWatchdog(new_auto_mode ? Source::Autonomous : Source::Manual);
+      if (_watchdog) {
+        updateWatchdog();
+      }
+      arbitrateSoon(true);
       if (new_auto_mode) {
         std::cout << "AUTO MODE ACTIVATED - Switching to autonomous control"
                   << std::endl; // LCOV_EXCL_LINE - Mode change logging
@@ -214,194 +439,124 @@ void ControlAssembly::handleMessage(const std::string &message) {
         _logger.logControlUpdate("auto_mode_deactivated", 0, 0);
       }
 
-      // Spam the mode change message to ensure cluster receives it
-      for (int i = 0; i < 10; i++) {
-        sendModeStatus(new_auto_mode);
-      }
+      // Sent at once; the state publisher repeats it with backoff
+      sendModeStatus(new_auto_mode);
     }
     return; // Auto mode commands are handled immediately and exclusively
   }
 
-  double steering = 0.0;
-  double throttle = 0.0;
-
-  // Only process manual control commands if AUTO mode is not active
-  if (!auto_mode_active.load()) {
-    // Apply steering if present in the message (emergency brake doesn't affect
-    // steering)
-    if (values.find("steering") != values.end()) {
-      steering = values["steering"];
-      std::cout << "Setting steering to: " << steering
-                << std::endl; // LCOV_EXCL_LINE - Control action logging
-      _fServo->set_steering(static_cast<int>(steering));
-    }
-
-    // Apply throttle if present in the message
-    if (values.find("throttle") != values.end()) {
-      throttle = values["throttle"];
-
-      if (emergency_brake_active.load()) {
-        if (throttle < 0) {
-          // Check current speed before allowing reverse during emergency brake
-          uint32_t current_speed_mms = 0; // Speed in mm/s
-          if (speed_data_accessor) {
-            auto speed_data = speed_data_accessor();
-            if (speed_data) {
-              current_speed_mms = speed_data->value.load();
-            }
-          }
-
-          if (current_speed_mms == 0) {
-            // Vehicle is stopped, allow reverse to back away from obstruction
-            // LCOV_EXCL_START - Emergency brake logging, not testable in unit
-            // tests
-            std::cout << "Emergency brake active - vehicle stopped (speed: "
-                      << current_speed_mms
-                      << " mm/s), allowing reverse throttle: " << throttle
-                      << std::endl;
-            // LCOV_EXCL_STOP
-            _backMotors->setSpeed(throttle);
-          } else {
-            // Vehicle still moving, block reverse and continue emergency
-            // braking
-            // LCOV_EXCL_START - Emergency brake logging, not testable in unit
-            // tests
-            std::cout
-                << "Emergency brake active - vehicle still moving (speed: "
-                << current_speed_mms
-                << " mm/s), blocking reverse throttle: " << throttle
-                << ", continuing emergency braking" << std::endl;
-            // LCOV_EXCL_STOP
-            performEmergencyBraking();
-            throttle = 0; // Log as 0 for consistency
-          }
-        } else {
-          // Block positive throttle during emergency brake
-          std::cout << "Emergency brake active - blocking positive throttle: "
-                    << throttle << ", applying intelligent braking instead"
-                    << std::endl;    // LCOV_EXCL_LINE - Emergency brake logging
-          performEmergencyBraking(); // Use intelligent braking instead of
-                                     // positive throttle
-          throttle = 0;              // Log as 0 for consistency
-        }
-      } else {
-        std::cout << "Setting throttle to: " << throttle
-                  << std::endl; // LCOV_EXCL_LINE - Control action logging
-        _backMotors->setSpeed(throttle);
-      }
-    }
-
-    // Log the control update
-    _logger.logControlUpdate(message, steering, throttle);
-
-    // Send mode status continuously (manual mode)
-    sendModeStatus(false);
-  } else {
+  // The arbiter ignores it while AUTO mode is active and turns throttle
+  // into braking during an emergency brake
+  _arbiter.submit(Source::Manual, toRequest(command), CommandArbiter::nowNs());
+  if (_arbiter.isEngaged(Source::Autonomous)) {
     std::cout << "AUTO mode active - ignoring manual control commands"
               << std::endl; // LCOV_EXCL_LINE - Mode state logging
+    return;
   }
+  arbitrateSoon(false);
+
+  _logger.logControlUpdate(source, command.has_steering ? command.steering : 0,
+                           command.has_throttle ? command.throttle : 0);
+
+  // Only publishes if the mode changed; see StatePublisher
+  sendModeStatus(false);
 }
 
 void ControlAssembly::receiveAutonomousMessages() {
   std::cout << "Autonomous control receiver thread started"
             << std::endl; // LCOV_EXCL_LINE - Thread management logging
   while (!stop_flag) {
-    std::string message = _autonomousSubscriber->receive();
-
-    if (!message.empty()) {
-      std::cout << "Received autonomous control message: " << message
-                << std::endl; // LCOV_EXCL_LINE - Debug logging
-      handleAutonomousMessage(message);
-    }
-
+    drainAutonomousMessages();
     std::this_thread::sleep_for(
         std::chrono::milliseconds(10)); // Reduced from 50ms to 10ms
   }
   std::cout << "Autonomous control receiver thread stopping" << std::endl;
 }
-// LCOV_EXCL_START - Autonomous message handling, not testable in unit tests
+
+void ControlAssembly::drainAutonomousMessages() {
+  while (_autonomousSubscriber->receiveInto(_autonomousBuffer)) {
+    if (!stop_flag) {
+      std::cout << "Received autonomous control message: " << _autonomousBuffer
+                << std::endl; // LCOV_EXCL_LINE - Debug logging
+      handleAutonomousMessage(_autonomousBuffer);
+    }
+  }
+}
 void ControlAssembly::handleAutonomousMessage(const std::string &message) {
-  // Only process autonomous commands if AUTO mode is active
-  bool current_auto_mode = auto_mode_active.load();
-  if (!current_auto_mode) {
+  const uint64_t received_ns = control_frame::nowNs();
+  const kv_codec::ControlCommand command = kv_codec::parseControl(message);
+  if (!acceptAutonomousCommand(command, received_ns)) {
+    return; // a lagging autonomy stack counts as silent for the watchdog
+  }
+  feedWatchdog(Source::Autonomous);
+  _arbiter.submit(Source::Autonomous, toRequest(command),
+                  CommandArbiter::nowNs());
+
+  // Only applied while AUTO mode is active
+  if (!_arbiter.isEngaged(Source::Autonomous)) {
     std::cout << "MANUAL MODE ACTIVE - Ignoring autonomous control command: "
               << message << std::endl; // LCOV_EXCL_LINE - Mode state logging
     return;
   }
+  if (command.has_frame_ts) {
+    _pendingFrameNs.store(command.frame_ts_ns, std::memory_order_release);
+  }
+  arbitrateSoon(false);
 
   std::cout << "AUTO MODE ACTIVE - Processing autonomous control command: "
             << message << std::endl; // LCOV_EXCL_LINE - Mode state logging
 
-  std::unordered_map<std::string, double> values;
-  std::stringstream ss(message);
-  std::string token;
-  std::cout << "Parsing autonomous message: " << message
-            << std::endl; // LCOV_EXCL_LINE - Debug logging
+  // Log the autonomous control update
+  _logger.logControlUpdate("AUTO:" + message,
+                           command.has_steering ? command.steering : 0,
+                           command.has_throttle ? command.throttle : 0);
 
-  while (std::getline(ss, token, ';')) {
-    if (token.empty())
-      continue;
+  // Only publishes if the mode changed; see StatePublisher
+  sendModeStatus(true);
+}
 
-    std::string key;
-    double value;
-    std::stringstream ss_token(token);
-    std::getline(ss_token, key, ':');
-    ss_token >> value;
-    values[key] = value;
-    std::cout << "Parsed autonomous key: '" << key << "', value: " << value
-              << std::endl; // LCOV_EXCL_LINE - Debug logging
-  }
-
-  double steering = 0.0;
-  double throttle = 0.0;
-
-  // Apply autonomous steering
-  if (values.find("steering") != values.end()) {
-    steering = values["steering"];
-    std::cout << "Setting autonomous steering to: " << steering
-              << std::endl; // LCOV_EXCL_LINE - Control action logging
-    _fServo->set_steering(static_cast<int>(steering));
-  }
-
-  // Apply autonomous throttle
-  if (values.find("throttle") != values.end()) {
-    throttle = values["throttle"];
-
-    if (emergency_brake_active.load()) {
-      // Block all throttle during emergency brake in autonomous mode
-      std::cout << "Emergency brake active - blocking all autonomous throttle: "
-                << throttle << ", applying intelligent braking instead"
-                << std::endl;    // LCOV_EXCL_LINE - Emergency brake logging
-      performEmergencyBraking(); // Use intelligent braking instead of any
-                                 // throttle
-      throttle = 0;              // Log as 0 for consistency
-    } else {
-      std::cout << "Setting autonomous throttle to: " << throttle
-                << std::endl; // LCOV_EXCL_LINE - Control action logging
-      _backMotors->setSpeed(throttle);
+// An older command must not override a newer one, and a late one steers
+// for a scene that is gone. Commands without "seq"/"frame_ts" are taken as
+// they come.
+bool ControlAssembly::acceptAutonomousCommand(
+    const kv_codec::ControlCommand &command, uint64_t received_ns) {
+  if (command.has_sequence && command.has_frame_ts) {
+    auto verdict = _autonomousLink.recordFrame(
+        command.sequence, command.frame_ts_ns, received_ns);
+    if (verdict == ControlLinkMonitor::Verdict::Stale) {
+      std::cerr << "Dropping stale autonomous command " << command.sequence
+                << std::endl; // LCOV_EXCL_LINE - Link diagnostics
+      return false;
     }
+  } else {
+    _autonomousLink.recordText();
   }
 
-  // Log the autonomous control update
-  _logger.logControlUpdate("AUTO:" + message, steering, throttle);
+  int64_t max_age = _autonomousMaxAgeNs.load(std::memory_order_relaxed);
+  if (command.has_frame_ts && max_age > 0 &&
+      received_ns > command.frame_ts_ns &&
+      received_ns - command.frame_ts_ns > static_cast<uint64_t>(max_age)) {
+    _autonomousTooOld.fetch_add(1, std::memory_order_relaxed);
+    std::cerr << "Dropping autonomous command " << command.sequence
+              << ", frame is "
+              << (received_ns - command.frame_ts_ns) / 1000000 << "ms old"
+              << std::endl; // LCOV_EXCL_LINE - Link diagnostics
+    return false;
+  }
+  return true;
+}
 
-  // Send mode status continuously (auto mode)
-  sendModeStatus(true);
-} // LCOV_EXCL_STOP
+StatePublishPolicy ControlAssembly::modeStatusPolicy() {
+  StatePublishPolicy policy;
+  policy.retransmits = 3; // 50, 100 and 200ms after a change
+  policy.initial_backoff = std::chrono::milliseconds(50);
+  policy.heartbeat = std::chrono::milliseconds(1000);
+  return policy;
+}
 
 void ControlAssembly::sendModeStatus(bool auto_mode_active) {
-  if (_clusterPublisher) {
-    std::string mode_message =
-        "mode:" + std::to_string(auto_mode_active ? 1 : 0) + ";";
-
-    // Only print status occasionally to avoid spam
-    static int mode_counter = 0;
-    if (mode_counter++ % 100 == 0) {
-      std::cout << "Sending mode status to cluster: " << mode_message
-                << std::endl;
-    }
-
-    _clusterPublisher->send(mode_message);
+  if (_modeStatus) {
+    _modeStatus->set(auto_mode_active ? "1" : "0");
   } else {
     static int warning_counter = 0;
     if (warning_counter++ % 1000 == 0) {
@@ -413,18 +568,19 @@ void ControlAssembly::sendModeStatus(bool auto_mode_active) {
 }
 
 void ControlAssembly::handleEmergencyBrake(bool emergency_active) {
-  bool was_active = emergency_brake_active.exchange(emergency_active);
+  bool was_active = _arbiter.engage(Source::Emergency, emergency_active,
+                                    CommandArbiter::nowNs());
 
   if (was_active != emergency_active) {
+    // Brakes, or stops when deactivating, on the owner's next iteration
+    arbitrateSoon(true);
     if (emergency_active) {
       std::cout << "EMERGENCY BRAKE ACTIVATED - Intelligent braking engaged!"
                 << std::endl;
-      performEmergencyBraking(); // Use intelligent braking
       _logger.logControlUpdate("emergency_brake_activated", 0, 0);
     } else {
       std::cout << "Emergency brake deactivated - Normal control resumed"
                 << std::endl;
-      _backMotors->setSpeed(0); // Ensure we stop when deactivating
       _logger.logControlUpdate("emergency_brake_deactivated", 0, 0);
     }
 
@@ -435,35 +591,112 @@ void ControlAssembly::handleEmergencyBrake(bool emergency_active) {
   }
 }
 
-// void ControlAssembly::performEmergencyBraking() {
-//   // Get current speed for intelligent braking
-//   uint32_t current_speed_mms = 0; // Speed in mm/s
-//   if (speed_data_accessor) {
-//     auto speed_data = speed_data_accessor();
-//     if (speed_data) {
-//       current_speed_mms = speed_data->value.load();
-//     }
-//   }
-
-//   // Convert mm/s to a rough equivalent for motor control
-//   // Assuming motor speed range is roughly -100 to +100
-//   // and current speed indicates forward motion
-//   if (current_speed_mms > 10) { // Vehicle is moving forward (>10 mm/s ~=
-//   0.036 km/h)
-//     // Apply strong reverse braking until stopped
-//     std::cout << "EMERGENCY BRAKING: Applying reverse force (-100) to stop
-//     vehicle (current speed: "
-//               << current_speed_mms << " mm/s)" << std::endl;
-//     _backMotors->setSpeed(-100);
-//   } else {
-//     // Vehicle is stopped or moving very slowly, just set to 0
-//     std::cout << "EMERGENCY BRAKING: Vehicle stopped, setting speed to 0
-//     (current speed: "
-//               << current_speed_mms << " mm/s)" << std::endl;
-//     _backMotors->setSpeed(0);
-//   }
-// }
+// The owner thread arbitrates every tick; brakes and mode changes wake it.
+// While it is stopped, arbitrate here.
+void ControlAssembly::arbitrateSoon(bool urgent) {
+  if (!_actuators.isRunning()) {
+    arbitrate();
+  } else if (urgent) {
+    _actuators.wake();
+  }
+}
+
+void ControlAssembly::arbitrate() {
+  std::lock_guard<std::mutex> lock(_arbiterMutex);
+  // Read before the slots, so the command it belongs to is in the decision
+  uint64_t frame_ns = _pendingFrameNs.exchange(0, std::memory_order_acquire);
+  int64_t lane_ns = _pendingLaneNs.exchange(0, std::memory_order_acquire);
+  unsigned int speed_mms = 0; // only needed to release reverse while braking
+  if (_arbiter.isEngaged(Source::Emergency) && speed_data_accessor) {
+    auto speed_data = speed_data_accessor();
+    if (speed_data) {
+      speed_mms = speed_data->value.load();
+    }
+  }
+
+  const CommandArbiter::Decision decision =
+      _arbiter.arbitrate(CommandArbiter::nowNs(), speed_mms);
+  if (decision.steering.changed) {
+    _actuators.setSteering(decision.steering.value);
+  }
+  if (decision.throttle.changed) {
+    if (decision.throttle.action == CommandArbiter::Action::Brake) {
+      performEmergencyBraking();
+    } else {
+      if (decision.authority == Source::Emergency) {
+        std::cout << "Emergency brake active - vehicle stopped, allowing "
+                     "reverse throttle: "
+                  << decision.throttle.value
+                  << std::endl; // LCOV_EXCL_LINE - Emergency brake logging
+      }
+      applyThrottle(decision.throttle.value);
+    }
+  }
+
+  // The owner applies the setpoints right after this hook
+  if (frame_ns != 0 && decision.authority == Source::Autonomous) {
+    uint64_t now_ns = control_frame::nowNs();
+    _actuationLatency.record(now_ns > frame_ns ? (now_ns - frame_ns) / 1000
+                                               : 0);
+  }
+  if (lane_ns != 0 && decision.authority != Source::Watchdog) {
+    _laneLatency.record(
+        static_cast<uint64_t>(CommandArbiter::nowNs() - lane_ns) / 1000);
+  }
+}
 
+// Counter-torque and hold run on the actuator thread when adaptive braking
+// is enabled; otherwise the wheels are locked
 void ControlAssembly::performEmergencyBraking() {
-  _backMotors->emergencyBrake();
+  _actuators.emergencyBrake();
+}
+
+ControlLinkMonitor::Stats ControlAssembly::getControlLinkStats() const {
+  return _controlLink.getStats();
+}
+
+ActuatorController::Stats ControlAssembly::getActuatorStats() const {
+  return _actuators.getStats();
+}
+
+ActuatorController::SpeedLoopStats ControlAssembly::getSpeedLoopStats() {
+  return _actuators.getSpeedLoopStats();
+}
+
+ActuatorController::BrakeStats ControlAssembly::getBrakeStats() {
+  return _actuators.getBrakeStats();
+}
+
+CommandArbiter::Stats ControlAssembly::getArbiterStats() const {
+  return _arbiter.getStats();
+}
+
+void ControlAssembly::setAutonomousMaxAge(std::chrono::milliseconds max_age) {
+  if (max_age.count() < 0) {
+    throw std::invalid_argument("Autonomous max age must not be negative");
+  }
+  _autonomousMaxAgeNs.store(std::chrono::nanoseconds(max_age).count(),
+                            std::memory_order_relaxed);
+}
+
+ControlAssembly::AutonomousLinkStats
+ControlAssembly::getAutonomousLinkStats() const {
+  AutonomousLinkStats stats;
+  stats.link = _autonomousLink.getStats();
+  stats.too_old = _autonomousTooOld.load(std::memory_order_relaxed);
+  stats.actuation = _actuationLatency.snapshot();
+  return stats;
+}
+
+ControlAssembly::LaneAssistStats ControlAssembly::getLaneAssistStats() const {
+  LaneAssistStats stats;
+  stats.updates = _laneUpdates.load(std::memory_order_relaxed);
+  stats.corrections = _laneCorrections.load(std::memory_order_relaxed);
+  stats.assisted_ticks = _arbiter.getStats().assisted;
+  stats.latency = _laneLatency.snapshot();
+  return stats;
+}
+
+ControlWatchdog::Stats ControlAssembly::getWatchdogStats() const {
+  return _watchdog ? _watchdog->getStats() : ControlWatchdog::Stats();
 }
@@ -0,0 +1,69 @@
+#include "ControlLinkMonitor.hpp"
+#include <algorithm>
+
+ControlLinkMonitor::Verdict
+ControlLinkMonitor::recordFrame(uint32_t sequence, uint64_t sent_ns,
+                                uint64_t received_ns, bool init) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stats.frames++;
+
+  // Latency only when both clocks agree on ordering; a sender clock ahead of
+  // ours would mean another host and is not meaningful
+  if (received_ns >= sent_ns) {
+    uint64_t latency_us = (received_ns - sent_ns) / 1000;
+    _stats.latency_last_us = latency_us;
+    _stats.latency_max_us = std::max(_stats.latency_max_us, latency_us);
+    _latencyTotalUs += latency_us;
+    _latencySamples++;
+    _stats.latency_avg_us = _latencyTotalUs / _latencySamples;
+  }
+
+  Verdict verdict = Verdict::InOrder;
+  if (_haveSequence && !init) {
+    // Signed distance handles the 32-bit wrap
+    auto distance = static_cast<int32_t>(sequence - _expected);
+    if (distance > 0) {
+      verdict = Verdict::Gap;
+      _stats.gaps++;
+      _stats.lost += static_cast<uint32_t>(distance);
+    } else if (distance < 0) {
+      if (sent_ns > _lastSentNs ||
+          static_cast<uint32_t>(-static_cast<int64_t>(distance)) >
+              kReorderWindow) {
+        verdict = Verdict::Restarted;
+        _stats.restarts++;
+      } else {
+        _stats.stale++;
+        return Verdict::Stale; // keep expecting the newer sequence
+      }
+    }
+  } else if (_haveSequence && init) {
+    verdict = Verdict::Restarted;
+    _stats.restarts++;
+  }
+
+  _haveSequence = true;
+  _expected = sequence + 1;
+  _lastSentNs = std::max(_lastSentNs, sent_ns);
+  return verdict;
+}
+
+void ControlLinkMonitor::recordText() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stats.text_messages++;
+}
+
+ControlLinkMonitor::Stats ControlLinkMonitor::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
+
+void ControlLinkMonitor::reset() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _haveSequence = false;
+  _expected = 0;
+  _lastSentNs = 0;
+  _latencyTotalUs = 0;
+  _latencySamples = 0;
+  _stats = Stats();
+}
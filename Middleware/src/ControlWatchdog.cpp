@@ -0,0 +1,204 @@
+#include "ControlWatchdog.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+ControlWatchdog::ControlWatchdog(Handler handler)
+    : ControlWatchdog(std::move(handler), Config()) {}
+
+ControlWatchdog::ControlWatchdog(Handler handler, Config config)
+    : _handler(std::move(handler)), _config(config) {
+  if (!_handler) {
+    throw std::invalid_argument("ControlWatchdog needs a handler");
+  }
+  if (_config.manual_timeout.count() < 0 ||
+      _config.autonomous_timeout.count() < 0 ||
+      _config.ramp_down.count() < 0) {
+    throw std::invalid_argument("Invalid ControlWatchdog configuration");
+  }
+  _channels[static_cast<size_t>(Source::Manual)].timeout_ns =
+      std::chrono::nanoseconds(_config.manual_timeout).count();
+  _channels[static_cast<size_t>(Source::Autonomous)].timeout_ns =
+      std::chrono::nanoseconds(_config.autonomous_timeout).count();
+
+  _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (_wakeFd < 0) {
+    throw std::runtime_error("ControlWatchdog eventfd failed");
+  }
+  for (auto &channel : _channels) {
+    if (channel.timeout_ns == 0) {
+      continue;
+    }
+    // steady_clock is CLOCK_MONOTONIC, so deadlines can be set absolute
+    channel.timer_fd =
+        timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (channel.timer_fd < 0) {
+      int error = errno;
+      for (auto &created : _channels) {
+        if (created.timer_fd >= 0) {
+          close(created.timer_fd);
+        }
+      }
+      close(_wakeFd);
+      throw std::runtime_error(
+          std::string("ControlWatchdog timerfd failed: ") +
+          std::strerror(error));
+    }
+  }
+}
+
+ControlWatchdog::~ControlWatchdog() {
+  stop();
+  for (auto &channel : _channels) {
+    if (channel.timer_fd >= 0) {
+      close(channel.timer_fd);
+    }
+  }
+  close(_wakeFd);
+}
+
+void ControlWatchdog::start() {
+  if (!stop_flag.exchange(false)) {
+    return; // already running
+  }
+  _thread = std::thread(&ControlWatchdog::loop, this);
+}
+
+void ControlWatchdog::stop() {
+  stop_flag = true;
+  wake();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void ControlWatchdog::feed(Source source) {
+  Channel &channel = _channels[static_cast<size_t>(source)];
+  if (channel.timeout_ns == 0) {
+    return;
+  }
+  channel.last_ns.store(CommandArbiter::nowNs());
+  // An armed timer re-checks at its deadline; otherwise tell the thread
+  if (!channel.armed.load()) {
+    wake();
+  }
+}
+
+// A feed counts at once, before the thread reports the recovery
+bool ControlWatchdog::isExpired(Source source) const {
+  const Channel &channel = _channels[static_cast<size_t>(source)];
+  return channel.expired.load() &&
+         CommandArbiter::nowNs() >= channel.last_ns.load() + channel.timeout_ns;
+}
+
+void ControlWatchdog::wake() {
+  uint64_t one = 1;
+  ssize_t written = write(_wakeFd, &one, sizeof(one));
+  (void)written; // EAGAIN means a wake-up is already pending
+}
+
+void ControlWatchdog::arm(Channel &channel, int64_t deadline_ns) {
+  itimerspec spec{};
+  spec.it_value.tv_sec = static_cast<time_t>(deadline_ns / 1000000000);
+  spec.it_value.tv_nsec = static_cast<long>(deadline_ns % 1000000000);
+  if (timerfd_settime(channel.timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) <
+      0) {
+    std::cerr << "ControlWatchdog: timerfd_settime failed: "
+              << std::strerror(errno)
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    return;
+  }
+  channel.armed = true;
+}
+
+// Watchdog thread only
+void ControlWatchdog::check(Source source, int64_t now_ns) {
+  Channel &channel = _channels[static_cast<size_t>(source)];
+  if (channel.timeout_ns == 0) {
+    return;
+  }
+  int64_t last = channel.last_ns.load();
+  if (last == 0) {
+    return;
+  }
+
+  int64_t deadline = last + channel.timeout_ns;
+  if (now_ns < deadline) {
+    arm(channel, deadline);
+    if (channel.expired.exchange(false)) {
+      {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        ++_recoveries;
+      }
+      _handler(source, false);
+    }
+    return;
+  }
+
+  channel.armed = false;
+  if (channel.last_ns.load() != last) {
+    // Fed while disarming; that feed may have skipped the wake-up
+    check(source, now_ns);
+    return;
+  }
+  if (!channel.expired.exchange(true)) {
+    double latency_us = (now_ns - deadline) / 1000.0;
+    {
+      std::lock_guard<std::mutex> lock(_statsMutex);
+      ++_timeouts;
+      _latencyTotalUs += latency_us;
+      _latencyMaxUs = std::max(_latencyMaxUs, latency_us);
+    }
+    _handler(source, true);
+  }
+}
+
+void ControlWatchdog::loop() {
+  pollfd items[1 + CommandArbiter::kSources];
+  size_t count = 0;
+  items[count++] = {_wakeFd, POLLIN, 0};
+  for (const auto &channel : _channels) {
+    if (channel.timer_fd >= 0) {
+      items[count++] = {channel.timer_fd, POLLIN, 0};
+    }
+  }
+
+  while (!stop_flag) {
+    int64_t now_ns = CommandArbiter::nowNs();
+    for (size_t i = 0; i < CommandArbiter::kSources; ++i) {
+      check(static_cast<Source>(i), now_ns);
+    }
+
+    if (poll(items, count, -1) < 0) {
+      if (errno != EINTR) {
+        std::cerr << "ControlWatchdog: poll failed: " << std::strerror(errno)
+                  << std::endl; // LCOV_EXCL_LINE - Error handling
+      }
+      continue;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (items[i].revents & POLLIN) {
+        uint64_t expirations;
+        ssize_t drained = read(items[i].fd, &expirations, sizeof(expirations));
+        (void)drained;
+      }
+    }
+  }
+}
+
+ControlWatchdog::Stats ControlWatchdog::getStats() const {
+  std::lock_guard<std::mutex> lock(_statsMutex);
+  Stats stats;
+  stats.timeouts = _timeouts;
+  stats.recoveries = _recoveries;
+  stats.latency_avg_us = _timeouts > 0 ? _latencyTotalUs / _timeouts : 0;
+  stats.latency_max_us = _latencyMaxUs;
+  return stats;
+}
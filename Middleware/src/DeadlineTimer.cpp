@@ -0,0 +1,57 @@
+#include "DeadlineTimer.hpp"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+DeadlineTimer::DeadlineTimer(std::string name, Flush flush)
+    : _name(std::move(name)), _flush(std::move(flush)) {}
+
+DeadlineTimer::~DeadlineTimer() { stop(); }
+
+void DeadlineTimer::start() {
+  if (!stop_flag.exchange(false)) {
+    return; // already running
+  }
+  _thread = std::thread(&DeadlineTimer::run, this);
+}
+
+void DeadlineTimer::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    stop_flag = true;
+  }
+  _cv.notify_all();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void DeadlineTimer::wake() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _wake = true;
+  }
+  _cv.notify_one();
+}
+
+void DeadlineTimer::run() {
+  // Upper bound on the sleep, so work the flush function cannot announce
+  // through wake() is still picked up
+  constexpr auto idle_period = std::chrono::seconds(1);
+
+  while (!stop_flag) {
+    auto now = Clock::now();
+    Clock::time_point next;
+    try {
+      next = std::min(_flush(now), now + idle_period);
+    } catch (const std::exception &e) {
+      std::cerr << "Error flushing " << _name << ": " << e.what()
+                << std::endl; // LCOV_EXCL_LINE - Error handling
+      next = now + idle_period;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait_until(lock, next, [this] { return stop_flag || _wake; });
+    _wake = false;
+  }
+}
@@ -5,7 +5,7 @@
 #include <iostream>
 #include <limits>
 
-Distance::Distance() {
+Distance::Distance(size_t filter_window) : filter(filter_window) {
   _name = "distance";
   // Publish obstacle alerts: 0 = safe, 1 = warning, 2 = emergency
   _sensorData["obs"] = std::make_shared<SensorData>(
@@ -24,6 +24,11 @@ Distance::getSensorData() const {
   return _sensorData;
 }
 
+uint32_t Distance::getRejectedSamples() const {
+  std::lock_guard<std::mutex> lock(data_mutex);
+  return filter.getRejectedCount();
+}
+
 void Distance::setEmergencyBrakeCallback(std::function<void(bool)> callback) {
   emergency_brake_callback = callback;
   std::cout << "Emergency brake callback set for Distance sensor"
@@ -73,6 +78,7 @@ void Distance::onCanMessage(const CanMessage &message) {
 
   std::cout << "Distance received CAN message with " << (int)message.length
             << " bytes" << std::endl; // LCOV_EXCL_LINE - Debug logging
+  notifyUpdate();
 }
 
 void Distance::readSensor() {
@@ -86,9 +92,19 @@ void Distance::readSensor() {
     // Extract distance value from CAN message (little endian, in cm)
     uint16_t new_distance = latest_data[0] | (latest_data[1] << 8);
 
-    current_distance_cm.store(new_distance);
-    std::cout << "Distance updated: " << new_distance << " cm"
-              << std::endl; // LCOV_EXCL_LINE - Debug logging
+    // Single-frame spikes (multipath, missed echo) must not toggle the brake
+    uint16_t filtered_distance = filter.filter(new_distance);
+
+    raw_distance_cm.store(new_distance);
+    current_distance_cm.store(filtered_distance);
+    if (filter.lastRejected()) {
+      std::cout << "Distance outlier rejected: " << new_distance << " cm (using "
+                << filtered_distance << " cm)"
+                << std::endl; // LCOV_EXCL_LINE - Debug logging
+    } else {
+      std::cout << "Distance updated: " << new_distance << " cm"
+                << std::endl; // LCOV_EXCL_LINE - Debug logging
+    }
   } else {
     std::cerr << "Distance: Invalid CAN message length: " << (int)latest_length
               << std::endl; // LCOV_EXCL_LINE - Error handling
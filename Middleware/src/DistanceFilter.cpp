@@ -0,0 +1,69 @@
+#include "DistanceFilter.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+DistanceFilter::DistanceFilter(size_t window, double threshold_sigma,
+                               uint16_t min_deviation_cm)
+    : window_(std::min(window, maxWindow)), threshold_sigma_(threshold_sigma),
+      min_deviation_cm_(min_deviation_cm) {}
+
+void DistanceFilter::reset() {
+  head_ = 0;
+  count_ = 0;
+  last_raw_ = 0;
+  last_rejected_ = false;
+  rejected_count_ = 0;
+}
+
+uint16_t DistanceFilter::median(std::array<uint16_t, maxWindow> &values,
+                                size_t n) const {
+  auto mid = values.begin() + n / 2;
+  std::nth_element(values.begin(), mid, values.begin() + n);
+  return *mid;
+}
+
+uint16_t DistanceFilter::filter(uint16_t raw_cm) {
+  // Windows below 3 samples cannot tell an outlier from a step
+  if (window_ < 3) {
+    last_rejected_ = false;
+    return raw_cm;
+  }
+
+  uint16_t output = raw_cm;
+  bool rejected = false;
+
+  // Judge against the history before this sample enters it
+  if (count_ >= 3 && !last_rejected_) {
+    std::array<uint16_t, maxWindow> scratch{};
+    std::copy(samples_.begin(), samples_.begin() + count_, scratch.begin());
+    uint16_t med = median(scratch, count_);
+
+    for (size_t i = 0; i < count_; ++i) {
+      scratch[i] = static_cast<uint16_t>(std::abs(samples_[i] - med));
+    }
+    uint16_t mad = median(scratch, count_);
+
+    // 1.4826 * MAD estimates the standard deviation for Gaussian noise
+    double limit = std::max(threshold_sigma_ * 1.4826 * mad,
+                            static_cast<double>(min_deviation_cm_));
+    // A sample agreeing with its predecessor is a new level, not a spike
+    bool outlier = std::abs(raw_cm - med) > limit;
+    bool confirmed = std::abs(raw_cm - last_raw_) <= limit;
+    if (outlier && !confirmed) {
+      rejected = true;
+      output = med;
+      rejected_count_++;
+    }
+  }
+
+  if (count_ < window_) {
+    samples_[count_++] = raw_cm;
+  } else {
+    samples_[head_] = raw_cm;
+    head_ = (head_ + 1) % window_;
+  }
+
+  last_raw_ = raw_cm;
+  last_rejected_ = rejected;
+  return output;
+}
@@ -5,43 +5,21 @@ FServo::FServo() {}
 // LCOV_EXCL_START - Hardware I2C initialization, not testable in unit tests
 void FServo::open_i2c_bus() {
   i2c_device = "/dev/i2c-1";
-  _fdServo = open(i2c_device.c_str(), O_RDWR);
-  if (_fdServo < 0)
-    throw std::runtime_error("Error open I2C");
-  if (ioctl(_fdServo, I2C_SLAVE, _servoAddr) < 0) {
-    close(_fdServo);
-    throw std::runtime_error("Erro ao configurar endereço I2C do servo.");
-  }
+  I2cBus &bus = I2cBus::getInstance();
+  bus.open(i2c_device);
+  attachDevice(bus.device(_servoAddr, I2cPriority::Actuator));
 }
 // LCOV_EXCL_STOP
 
 FServo::~FServo() {
-  close(_fdServo);                  // LCOV_EXCL_LINE - Hardware cleanup
   std::cout << "destructor call\n"; // LCOV_EXCL_LINE - Destructor logging
 }
 
 // LCOV_EXCL_START - Hardware servo initialization, not testable in unit tests
 bool FServo::init_servo() {
   try {
-    // Reset PCA9685
-    this->writeByteData(_fdServo, 0x00, 0x06);
-    usleep(100000); // Aguarda 100 ms
-
-    // Setup servo control
-    this->writeByteData(_fdServo, 0x00, 0x10);
-    usleep(100000);
-
-    // Set frequency (~50Hz)
-    this->writeByteData(_fdServo, 0xFE, 0x79);
-    usleep(100000);
-
-    // Configure MODE2
-    this->writeByteData(_fdServo, 0x01, 0x04);
-    usleep(100000);
-
-    // Enable auto-increment
-    this->writeByteData(_fdServo, 0x00, 0x20);
-    usleep(100000);
+    // ~50Hz servo frame, totem-pole outputs, auto-increment on
+    _pwm.init(50, Pca9685::kMode2OutDrv);
     // LCOV_EXCL_STOP
     return true;
   } catch (
@@ -56,10 +34,9 @@ bool FServo::setServoPwm(const int channel, int on_value, int off_value) {
   try {
     // LCOV_EXCL_START - Hardware servo PWM configuration, not testable in unit
     // tests
-    this->writeByteData(_fdServo, 0x06 + 4 * channel, on_value & 0xFF);
-    this->writeByteData(_fdServo, 0x07 + 4 * channel, on_value >> 8);
-    this->writeByteData(_fdServo, 0x08 + 4 * channel, off_value & 0xFF);
-    this->writeByteData(_fdServo, 0x09 + 4 * channel, off_value >> 8);
+    // One auto-increment burst, nothing if the pulse is unchanged
+    _pwm.setPwm(channel, static_cast<uint16_t>(on_value),
+                static_cast<uint16_t>(off_value));
     // LCOV_EXCL_STOP
     return true;
   } catch (
@@ -94,23 +71,23 @@ void FServo::set_steering(int angle) {
   _currentAngle = angle;
 }
 
-// LCOV_EXCL_START - Hardware I2C write, not testable in unit tests
-void FServo::writeByteData(int fd, uint8_t reg, uint8_t value) {
-  uint8_t buffer[2] = {reg, value};
-  if (write(fd, buffer, 2) != 2) {
+void FServo::writeByteData(int, uint8_t reg, uint8_t value) {
+  if (!_device) {
     throw std::runtime_error("Erro ao escrever no dispositivo I2C.");
   }
-  // LCOV_EXCL_STOP
+  _device->writeRegister(reg, value);
 }
 
-// LCOV_EXCL_START - Hardware I2C read, not testable in unit tests
-uint8_t FServo::readByteData(int fd, uint8_t reg) {
-  if (write(fd, &reg, 1) != 1)
-    throw std::runtime_error(
-        "Erro ao enviar o registrador ao dispositivo I2C.");
-  uint8_t value;
-  if (read(fd, &value, 1) != 1)
+uint8_t FServo::readByteData(int, uint8_t reg) {
+  if (!_device) {
     throw std::runtime_error("Erro ao ler o registrador ao dispositivo I2C.");
-  return value;
-  // LCOV_EXCL_STOP
+  }
+  return _device->readRegister(reg);
 }
+
+void FServo::attachDevice(std::shared_ptr<II2cDevice> device) {
+  _device = device;
+  _pwm.attach(std::move(device));
+}
+
+Pca9685::Stats FServo::getPwmStats() const { return _pwm.getStats(); }
@@ -0,0 +1,215 @@
+#include "I2cBus.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <stdexcept>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// LCOV_EXCL_START - Hardware I2C adapter, not testable in unit tests
+LinuxI2cAdapter::LinuxI2cAdapter(const std::string &path) {
+  _fd = ::open(path.c_str(), O_RDWR);
+  if (_fd < 0) {
+    throw std::runtime_error("Error open I2C: " + path);
+  }
+}
+
+LinuxI2cAdapter::~LinuxI2cAdapter() {
+  if (_fd >= 0) {
+    close(_fd);
+  }
+}
+
+void LinuxI2cAdapter::transfer(I2cMessage *messages, size_t count) {
+  i2c_msg kernel[I2cBus::kMaxBursts + 1];
+  if (count > I2cBus::kMaxBursts + 1) {
+    throw std::invalid_argument("Too many I2C messages in one transaction");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    kernel[i].addr = messages[i].address;
+    kernel[i].flags = (messages[i].flags & I2cMessage::kRead) ? I2C_M_RD : 0;
+    kernel[i].len = messages[i].length;
+    kernel[i].buf = messages[i].buffer;
+  }
+  i2c_rdwr_ioctl_data transfer{kernel, static_cast<uint32_t>(count)};
+  if (ioctl(_fd, I2C_RDWR, &transfer) < 0) {
+    throw std::runtime_error("Erro na transação I2C.");
+  }
+}
+// LCOV_EXCL_STOP
+
+// II2cDevice bound to one address and priority
+class I2cBus::Device : public II2cDevice {
+public:
+  Device(I2cBus &bus, uint16_t address, I2cPriority priority)
+      : _bus(bus), _address(address), _priority(priority) {}
+
+  void writeBursts(const I2cBurst *bursts, size_t count) override {
+    _bus.burst(_address, _priority, bursts, count);
+  }
+  void readRegisters(uint8_t reg, uint8_t *out, size_t length) override {
+    _bus.writeRead(_address, _priority, reg, out, length);
+  }
+
+private:
+  I2cBus &_bus;
+  uint16_t _address;
+  I2cPriority _priority;
+};
+
+I2cBus &I2cBus::getInstance() {
+  static I2cBus instance;
+  return instance;
+}
+
+I2cBus::I2cBus(std::shared_ptr<II2cAdapter> adapter)
+    : _adapter(std::move(adapter)) {}
+
+void I2cBus::open(const std::string &path) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_adapter) {
+    _adapter = std::make_shared<LinuxI2cAdapter>(path); // LCOV_EXCL_LINE
+  }
+}
+
+void I2cBus::setAdapter(std::shared_ptr<II2cAdapter> adapter) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _adapter = std::move(adapter);
+}
+
+bool I2cBus::isOpen() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _adapter != nullptr;
+}
+
+std::shared_ptr<II2cDevice> I2cBus::device(uint16_t address,
+                                           I2cPriority priority) {
+  return std::make_shared<Device>(*this, address, priority);
+}
+
+void I2cBus::write(uint16_t address, I2cPriority priority, uint8_t reg,
+                   const uint8_t *data, size_t length) {
+  I2cBurst burst{reg, data, length};
+  this->burst(address, priority, &burst, 1);
+}
+
+void I2cBus::writeRead(uint16_t address, I2cPriority priority, uint8_t reg,
+                       uint8_t *out, size_t length) {
+  I2cMessage messages[2] = {
+      {address, 0, 1, &reg},
+      {address, I2cMessage::kRead, static_cast<uint16_t>(length), out}};
+  execute(address, priority, messages, 2);
+}
+
+void I2cBus::burst(uint16_t address, I2cPriority priority,
+                   const I2cBurst *bursts, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  if (count > kMaxBursts) {
+    throw std::invalid_argument("Too many I2C bursts in one transaction");
+  }
+
+  // Each message is the register byte followed by the data
+  uint8_t buffers[kMaxBursts][kMaxBurstLength + 1];
+  I2cMessage messages[kMaxBursts];
+  for (size_t i = 0; i < count; ++i) {
+    if (bursts[i].length > kMaxBurstLength) {
+      throw std::invalid_argument("I2C burst too long");
+    }
+    buffers[i][0] = bursts[i].reg;
+    std::memcpy(&buffers[i][1], bursts[i].data, bursts[i].length);
+    messages[i] = {address, 0, static_cast<uint16_t>(bursts[i].length + 1),
+                   buffers[i]};
+  }
+  execute(address, priority, messages, count);
+}
+
+void I2cBus::execute(uint16_t address, I2cPriority priority,
+                     I2cMessage *messages, size_t count) {
+  auto queued = std::chrono::steady_clock::now();
+  std::shared_ptr<II2cAdapter> adapter;
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_busy) {
+      Waiter waiter(priority, _tickets++);
+      _waiters.push(&waiter);
+      waiter.cv.wait(lock, [&waiter] { return waiter.granted; });
+    } else {
+      _busy = true;
+    }
+    adapter = _adapter;
+  }
+
+  auto started = std::chrono::steady_clock::now();
+  std::exception_ptr error;
+  try {
+    if (!adapter) {
+      throw std::runtime_error("I2C bus not open");
+    }
+    adapter->transfer(messages, count);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  auto finished = std::chrono::steady_clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Accumulator &stats = _stats[address];
+    double wait_us =
+        std::chrono::duration<double, std::micro>(started - queued).count();
+    double transfer_us =
+        std::chrono::duration<double, std::micro>(finished - started).count();
+    stats.transactions++;
+    stats.errors += error ? 1 : 0;
+    stats.wait_total_us += wait_us;
+    stats.wait_max_us = std::max(stats.wait_max_us, wait_us);
+    stats.transfer_total_us += transfer_us;
+    stats.transfer_max_us = std::max(stats.transfer_max_us, transfer_us);
+
+    // Hand the bus straight to the most urgent waiter
+    if (_waiters.empty()) {
+      _busy = false;
+    } else {
+      Waiter *next = _waiters.top();
+      _waiters.pop();
+      next->granted = true;
+      next->cv.notify_one();
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+I2cBus::DeviceStats I2cBus::summarize(const Accumulator &accumulator) {
+  DeviceStats stats;
+  stats.transactions = accumulator.transactions;
+  stats.errors = accumulator.errors;
+  if (accumulator.transactions > 0) {
+    stats.wait_avg_us = accumulator.wait_total_us / accumulator.transactions;
+    stats.transfer_avg_us =
+        accumulator.transfer_total_us / accumulator.transactions;
+  }
+  stats.wait_max_us = accumulator.wait_max_us;
+  stats.transfer_max_us = accumulator.transfer_max_us;
+  return stats;
+}
+
+I2cBus::DeviceStats I2cBus::getStats(uint16_t address) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _stats.find(address);
+  return it != _stats.end() ? summarize(it->second) : DeviceStats{};
+}
+
+std::map<uint16_t, I2cBus::DeviceStats> I2cBus::getAllStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::map<uint16_t, DeviceStats> all;
+  for (const auto &entry : _stats) {
+    all[entry.first] = summarize(entry.second);
+  }
+  return all;
+}
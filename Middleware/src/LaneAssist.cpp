@@ -0,0 +1,32 @@
+#include "LaneAssist.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+LaneAssist::LaneAssist() : LaneAssist(Config()) {}
+
+LaneAssist::LaneAssist(Config config) : _config(config) {
+  if (_config.max_steering < 1 || _config.max_steering > 90 ||
+      _config.max_correction < 0 ||
+      _config.max_correction > _config.max_steering ||
+      _config.initial < 0 || _config.initial > _config.max_correction ||
+      _config.rate < 0 || _config.timeout.count() < 0) {
+    throw std::invalid_argument("Invalid LaneAssist configuration");
+  }
+}
+
+int LaneAssist::update(const LaneKeepingData &data, int64_t now_ns) {
+  int direction = data.lane_status == 1 ? 1 : data.lane_status == 2 ? -1 : 0;
+  if (direction == 0) {
+    _direction = 0;
+    return 0;
+  }
+  if (direction != _direction) {
+    _direction = direction;
+    _departedNs = now_ns;
+  }
+  double seconds = (now_ns - _departedNs) / 1e9;
+  int magnitude =
+      std::min(_config.max_correction,
+               _config.initial + static_cast<int>(_config.rate * seconds));
+  return direction * magnitude;
+}
@@ -1,13 +1,15 @@
 #include "LaneKeepingHandler.hpp"
+#include "KeyValueCodec.hpp"
+#include "Reactor.hpp"
 #include "ZmqPublisher.hpp"
 #include "ZmqSubscriber.hpp"
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <memory>
-#include <sstream>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 
 // LaneKeepingData implementation
 std::string LaneKeepingData::toString() const {
@@ -19,63 +21,12 @@ LaneKeepingData LaneKeepingData::fromString(const std::string &data) {
   result.lane_status = 0; // Default to no deviation
 
   // Parse format: "lane:X" or "lane:X;"
-  if (data.find("lane:") == 0) {
-    // Find the lane status value after "lane:"
-    size_t colon_pos = data.find(':');
-    if (colon_pos != std::string::npos && colon_pos + 1 < data.length()) {
-      // Extract the number after the colon
-      std::string status_str = data.substr(colon_pos + 1);
-
-      // Find the end of the numeric part (either end of string or semicolon)
-      size_t end_pos = status_str.find(';');
-      if (end_pos != std::string::npos) {
-        // Check if there's content after the semicolon
-        if (end_pos + 1 < status_str.length()) {
-          // There's extra content after semicolon - invalid format
-          std::cerr << "Error parsing lane status from: " << data
-                    << " (extra content after semicolon)"
-                    << std::endl; // LCOV_EXCL_LINE - Error handling
-          result.lane_status = 0;
-          return result;
-        }
-        status_str = status_str.substr(0, end_pos);
-      }
-
-      // Only try to parse if we have a non-empty string
-
-      if (!status_str.empty()) {
-        try {
-          // Use stoi with size_t parameter to check if entire string was
-          // consumed
-          size_t pos;
-          int parsed_value = std::stoi(status_str, &pos);
-
-          // Check if the entire string was consumed (no extra characters)
-          if (pos == status_str.length()) {
-            result.lane_status = parsed_value;
-          } else {
-            // Extra characters found - default to 0
-            std::cerr << "Error parsing lane status from: " << data
-                      << " (extra characters)"
-                      << std::endl; // LCOV_EXCL_LINE - Error handling
-            result.lane_status = 0;
-          }
-        } catch (const std::exception &e) {
-          std::cerr << "Error parsing lane status from: " << data
-                    << std::endl; // LCOV_EXCL_LINE - Error handling
-          result.lane_status = 0; // Default to no deviation on parse error
-        }
-      } else {
-        // Empty status string after colon (like "lane:") - default to 0
-        result.lane_status = 0;
-      }
-    } else {
-      // No colon found or nothing after colon - default to 0
-      result.lane_status = 0;
-    }
-  } else {
-    // Doesn't start with "lane:" - default to 0
+  if (!kv_codec::parseLane(data, result.lane_status)) {
     result.lane_status = 0;
+    if (data.compare(0, 5, "lane:") == 0) {
+      std::cerr << "Error parsing lane status from: " << data
+                << std::endl; // LCOV_EXCL_LINE - Error handling
+    }
   }
   return result;
 }
@@ -107,13 +58,35 @@ LaneKeepingHandler::LaneKeepingHandler(
 
 LaneKeepingHandler::~LaneKeepingHandler() { stop(); }
 
+void LaneKeepingHandler::attachTo(Reactor &reactor) {
+  if (void *socket = lkas_subscriber->handle()) {
+    reactor.addSocket(socket, [this] { drainLaneData(0); });
+  }
+  if (_test_mode) {
+    reactor.addTimer(std::chrono::milliseconds(processing_interval_ms),
+                     [this] {
+                       if (!stop_flag.load()) {
+                         processTestData();
+                       }
+                     });
+  }
+  _useReactor = true;
+}
+
+void LaneKeepingHandler::setLaneCallback(
+    std::function<void(const LaneKeepingData &)> callback) {
+  lane_callback = std::move(callback);
+}
+
 void LaneKeepingHandler::start() {
   std::cout << "Starting Lane Keeping Handler..."
             << std::endl; // LCOV_EXCL_LINE - Debug logging
 
   stop_flag = false;
-  processing_thread =
-      std::thread(&LaneKeepingHandler::receiveAndProcessLaneData, this);
+  if (!_useReactor) {
+    processing_thread =
+        std::thread(&LaneKeepingHandler::receiveAndProcessLaneData, this);
+  }
 
   std::cout << "Lane Keeping Handler started successfully."
             << std::endl; // LCOV_EXCL_LINE - Debug logging
@@ -157,37 +130,11 @@ void LaneKeepingHandler::receiveAndProcessLaneData() {
 
   while (!stop_flag.load()) {
     try {
-      // Try to receive data from Lane Keeping Assistance Software
-      std::string received_data =
-          lkas_subscriber->receive(processing_interval_ms);
-
-      if (!received_data.empty()) {
-        // Parse the received data
-        LaneKeepingData lane_data = LaneKeepingData::fromString(received_data);
-
-        {
-          std::lock_guard<std::mutex> lock(data_mutex);
-          latest_data = lane_data;
-          has_new_data = true;
-        }
-
-        // Process and publish the data (pass both original string and parsed
-        // data)
-        processLaneKeepingData(received_data, lane_data);
-      }
+      drainLaneData(processing_interval_ms);
 
       // Check for test data in test mode
       if (_test_mode) {
-        std::unique_lock<std::mutex> lock(data_mutex);
-        if (has_new_data) {
-          LaneKeepingData data_to_process = latest_data;
-          has_new_data = false;
-          lock.unlock();
-
-          // For test mode, generate the string format from the test data
-          std::string test_data_string = data_to_process.toString();
-          processLaneKeepingData(test_data_string, data_to_process);
-        }
+        processTestData();
       }
 
       // Small sleep to prevent busy waiting
@@ -204,8 +151,50 @@ void LaneKeepingHandler::receiveAndProcessLaneData() {
             << std::endl; // LCOV_EXCL_LINE - Debug logging
 }
 
+void LaneKeepingHandler::drainLaneData(int timeout_ms) {
+  // Try to receive data from Lane Keeping Assistance Software, then drain
+  // whatever else is already queued. While stopped the socket is still
+  // drained, a reactor would otherwise keep reporting it.
+  while (lkas_subscriber->receiveInto(_receiveBuffer, timeout_ms)) {
+    timeout_ms = 0;
+    if (stop_flag.load()) {
+      continue;
+    }
+
+    // Parse the received data
+    LaneKeepingData lane_data = LaneKeepingData::fromString(_receiveBuffer);
+
+    {
+      std::lock_guard<std::mutex> lock(data_mutex);
+      latest_data = lane_data;
+      has_new_data = true;
+    }
+
+    // Process and publish the data (pass both original string and parsed
+    // data)
+    processLaneKeepingData(_receiveBuffer, lane_data);
+  }
+}
+
+void LaneKeepingHandler::processTestData() {
+  std::unique_lock<std::mutex> lock(data_mutex);
+  if (has_new_data) {
+    LaneKeepingData data_to_process = latest_data;
+    has_new_data = false;
+    lock.unlock();
+
+    // For test mode, generate the string format from the test data
+    std::string test_data_string = data_to_process.toString();
+    processLaneKeepingData(test_data_string, data_to_process);
+  }
+}
+
 void LaneKeepingHandler::processLaneKeepingData(
     const std::string &original_data, const LaneKeepingData &parsed_data) {
+  if (lane_callback) {
+    lane_callback(parsed_data);
+  }
+
   // Log the received data
   std::cout << "Processing lane keeping data: received='" << original_data
             << "' parsed_status=" << parsed_data.lane_status
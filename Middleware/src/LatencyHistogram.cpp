@@ -0,0 +1,75 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr std::array<uint64_t, 10> LatencyHistogram::kBoundsUs;
+
+void LatencyHistogram::record(uint64_t latency_us) {
+  size_t bucket = static_cast<size_t>(
+      std::lower_bound(kBoundsUs.begin(), kBoundsUs.end(), latency_us) -
+      kBoundsUs.begin());
+  _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  _count.fetch_add(1, std::memory_order_relaxed);
+  _totalUs.fetch_add(latency_us, std::memory_order_relaxed);
+  uint64_t max = _maxUs.load(std::memory_order_relaxed);
+  while (latency_us > max &&
+         !_maxUs.compare_exchange_weak(max, latency_us,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+  Snapshot snapshot;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    snapshot.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+  }
+  snapshot.count = _count.load(std::memory_order_relaxed);
+  uint64_t total = _totalUs.load(std::memory_order_relaxed);
+  snapshot.avg_us = snapshot.count > 0 ? total / snapshot.count : 0;
+  snapshot.max_us = _maxUs.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+void LatencyHistogram::reset() {
+  for (auto &bucket : _buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  _count.store(0, std::memory_order_relaxed);
+  _totalUs.store(0, std::memory_order_relaxed);
+  _maxUs.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Snapshot::percentileUs(double p) const {
+  uint64_t total = 0;
+  for (uint64_t bucket : buckets) {
+    total += bucket;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  uint64_t rank = static_cast<uint64_t>(
+      std::ceil(std::min(std::max(p, 0.0), 100.0) / 100.0 * total));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBoundsUs.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return kBoundsUs[i];
+    }
+  }
+  return max_us;
+}
+
+std::string LatencyHistogram::Snapshot::toString() const {
+  auto label = [](uint64_t us) {
+    return us >= 1000000 ? std::to_string(us / 1000000) + "s"
+                         : std::to_string(us / 1000) + "ms";
+  };
+  std::string text;
+  for (size_t i = 0; i < kBoundsUs.size(); ++i) {
+    text += "<=" + label(kBoundsUs[i]) + ":" + std::to_string(buckets[i]) + " ";
+  }
+  text += ">" + label(kBoundsUs.back()) + ":" +
+          std::to_string(buckets[kBuckets - 1]);
+  return text;
+}
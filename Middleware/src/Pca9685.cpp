@@ -0,0 +1,161 @@
+#include "Pca9685.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+Pca9685::Batch::~Batch() {
+  if (--_pwm._batchDepth == 0) {
+    try {
+      _pwm.flush();
+    } catch (const std::exception &e) {
+      std::cerr << "PCA9685 flush failed: " << e.what()
+                << std::endl; // LCOV_EXCL_LINE - Hardware error handling
+    }
+  }
+}
+
+Pca9685::Pca9685(std::shared_ptr<II2cDevice> device) {
+  attach(std::move(device));
+}
+
+void Pca9685::attach(std::shared_ptr<II2cDevice> device) {
+  _device = std::move(device);
+  invalidate();
+}
+
+uint8_t Pca9685::prescaleFor(double frequency_hz) {
+  // 25 MHz internal oscillator, 12-bit counter
+  double prescale = std::floor(25000000.0 / 4096.0 / frequency_hz - 1);
+  return static_cast<uint8_t>(std::max(3.0, std::min(255.0, prescale)));
+}
+
+void Pca9685::init(double frequency_hz, uint8_t mode2) {
+  if (!_device) {
+    throw std::runtime_error("PCA9685 not attached");
+  }
+  // The prescaler can only be written while the oscillator sleeps
+  _device->writeRegister(kMode1, kMode1Sleep | kMode1AutoIncrement);
+  _device->writeRegister(kPrescale, prescaleFor(frequency_hz));
+  _device->writeRegister(kMode2, mode2);
+  _device->writeRegister(kMode1, kMode1AutoIncrement | kMode1AllCall);
+  usleep(5000); // oscillator start-up, 500us minimum
+  _device->writeRegister(kMode1, kMode1Restart | kMode1AutoIncrement |
+                                     kMode1AllCall);
+  invalidate();
+}
+
+void Pca9685::setPwm(int channel, uint16_t on, uint16_t off) {
+  if (channel < 0 || channel >= kChannels) {
+    throw std::out_of_range("PCA9685 channel out of range");
+  }
+  const uint8_t bytes[4] = {
+      static_cast<uint8_t>(on & 0xFF), static_cast<uint8_t>(on >> 8),
+      static_cast<uint8_t>(off & 0xFF), static_cast<uint8_t>(off >> 8)};
+  uint8_t *shadow = &_shadow[channel * 4];
+  const uint16_t bit = static_cast<uint16_t>(1u << channel);
+
+  if ((_known & bit) && !(_dirty & bit) && shadow[0] == bytes[0] &&
+      shadow[1] == bytes[1] && shadow[2] == bytes[2] && shadow[3] == bytes[3]) {
+    _stats.skipped++;
+  } else {
+    for (int i = 0; i < 4; ++i) {
+      shadow[i] = bytes[i];
+    }
+    _dirty |= bit;
+  }
+
+  if (_batchDepth == 0) {
+    flush();
+  }
+}
+
+void Pca9685::flush() {
+  if (_dirty == 0) {
+    return;
+  }
+  if (!_device) {
+    throw std::runtime_error("PCA9685 not attached");
+  }
+
+  // Contiguous runs of dirty channels; a short gap of channels whose
+  // value is known is cheaper to resend than to start another message
+  I2cBurst bursts[kChannels];
+  size_t count = 0;
+  uint16_t sent = 0;
+  int channel = 0;
+  while (channel < kChannels) {
+    if (!(_dirty & (1u << channel))) {
+      channel++;
+      continue;
+    }
+    int first = channel;
+    int last = channel;
+    for (int next = channel + 1; next < kChannels; ++next) {
+      if (_dirty & (1u << next)) {
+        last = next;
+      } else if (next - last > kMergeGap || !(_known & (1u << next))) {
+        break;
+      }
+    }
+    for (int c = first; c <= last; ++c) {
+      sent |= static_cast<uint16_t>(1u << c);
+    }
+    bursts[count++] = {static_cast<uint8_t>(kLed0 + 4 * first),
+                       &_shadow[first * 4],
+                       static_cast<size_t>(last - first + 1) * 4};
+    channel = last + 1;
+  }
+
+  _device->writeBursts(bursts, count);
+
+  _stats.transactions++;
+  for (size_t i = 0; i < count; ++i) {
+    _stats.bytes += bursts[i].length;
+    _stats.channel_writes += bursts[i].length / 4;
+  }
+  _known |= sent;
+  _dirty = 0;
+}
+
+void Pca9685::setAll(uint16_t on, uint16_t off) {
+  if (!_device) {
+    throw std::runtime_error("PCA9685 not attached");
+  }
+  const uint8_t bytes[4] = {
+      static_cast<uint8_t>(on & 0xFF), static_cast<uint8_t>(on >> 8),
+      static_cast<uint8_t>(off & 0xFF), static_cast<uint8_t>(off >> 8)};
+  I2cBurst burst{kAllLed, bytes, sizeof(bytes)};
+  try {
+    _device->writeBursts(&burst, 1);
+  } catch (...) {
+    invalidate(); // the chip may or may not hold the new values
+    throw;
+  }
+
+  _stats.transactions++;
+  _stats.bytes += sizeof(bytes);
+  for (int channel = 0; channel < kChannels; ++channel) {
+    for (int i = 0; i < 4; ++i) {
+      _shadow[channel * 4 + i] = bytes[i];
+    }
+  }
+  _known = 0xFFFF;
+  _dirty = 0;
+}
+
+void Pca9685::invalidate() {
+  _known = 0;
+  _dirty = 0;
+}
+
+uint16_t Pca9685::getOn(int channel) const {
+  const uint8_t *shadow = &_shadow[channel * 4];
+  return static_cast<uint16_t>(shadow[0] | (shadow[1] << 8));
+}
+
+uint16_t Pca9685::getOff(int channel) const {
+  const uint8_t *shadow = &_shadow[channel * 4];
+  return static_cast<uint16_t>(shadow[2] | (shadow[3] << 8));
+}
@@ -1,4 +1,5 @@
 #include "SensorHandler.hpp"
+#include <cstdio>
 #include <iostream>
 
 SensorHandler::SensorHandler(const std::string &zmq_c_address,
@@ -14,7 +15,7 @@ SensorHandler::SensorHandler(const std::string &zmq_c_address,
       zmq_nc_publisher(nc_publisher ? nc_publisher
                                     : std::make_shared<ZmqPublisher>(
                                           zmq_nc_address, zmq_context)),
-      zmq_context(zmq_context), _logger("sensor_updates.log") {
+      zmq_context(zmq_context), _logger(logFilePath("sensor_updates.log")) {
 
   if (use_real_sensors) {
     addSensors();
@@ -36,7 +37,14 @@ SensorHandler::SensorHandler(const std::string &zmq_c_address,
   }
 }
 
-SensorHandler::~SensorHandler() { stop(); }
+SensorHandler::~SensorHandler() {
+  stop();
+  // Sensors may outlive the handler; their notifiers point at it
+  std::lock_guard<std::mutex> lock(sensors_mutex);
+  for (auto &[name, sensor] : _sensors) {
+    sensor->setUpdateNotifier(nullptr);
+  }
+}
 
 void SensorHandler::addSensors() {
   std::lock_guard<std::mutex> lock(sensors_mutex);
@@ -57,6 +65,8 @@ void SensorHandler::addSensors() {
 
   _sensors["speed"] = speed_sensor;
   _sensors["distance"] = distance_sensor;
+  watchSensor(speed_sensor);
+  watchSensor(distance_sensor);
 
   // Set up emergency brake publisher for distance sensor
   // Create a ZMQ publisher for emergency brake commands to ControlAssembly
@@ -79,13 +89,19 @@ void SensorHandler::addSensor(const std::string &name,
     // Remove the sensor if it exists
     auto it = _sensors.find(name);
     if (it != _sensors.end()) {
+      it->second->setUpdateNotifier(nullptr);
       _sensors.erase(it);
       std::cout << "Removed sensor: " << name
                 << std::endl; // LCOV_EXCL_LINE - Debug logging
     }
   } else {
     // Add or replace the sensor
+    auto it = _sensors.find(name);
+    if (it != _sensors.end() && it->second != sensor) {
+      it->second->setUpdateNotifier(nullptr);
+    }
     _sensors[name] = sensor;
+    watchSensor(sensor);
     std::cout << "Added/updated sensor: " << name
               << std::endl; // LCOV_EXCL_LINE - Debug logging
   }
@@ -108,6 +124,7 @@ void SensorHandler::sortSensorData() {
   std::unordered_map<std::string, std::shared_ptr<SensorData>> newCriticalData;
   std::unordered_map<std::string, std::shared_ptr<SensorData>>
       newNonCriticalData;
+  std::vector<Channel> newChannels;
 
   for (const auto &[name, sensor] : _sensors) {
     if (!sensor) {
@@ -139,12 +156,34 @@ void SensorHandler::sortSensorData() {
       } else {
         newNonCriticalData.emplace(data_name, dataCopy);
       }
+      Channel channel;
+      channel.data = dataCopy;
+      for (const auto &existing : _channels) {
+        if (existing.data == dataCopy) {
+          channel = existing; // Keep change tracking across re-sorts
+          break;
+        }
+      }
+      newChannels.push_back(channel);
     }
   }
 
   // Atomic replacement of the maps
   _criticalData = std::move(newCriticalData);
   _nonCriticalData = std::move(newNonCriticalData);
+  _channels = std::move(newChannels);
+}
+
+SensorHandler::PublishStats SensorHandler::getPublishStats() const {
+  PublishStats stats;
+  stats.critical_messages = critical_messages.load();
+  stats.non_critical_messages = non_critical_messages.load();
+  uint64_t samples = critical_latency_samples.load();
+  if (samples > 0) {
+    stats.critical_latency_avg_us = critical_latency_total_us.load() / samples;
+  }
+  stats.critical_latency_max_us = critical_latency_max_us.load();
+  return stats;
 }
 
 void SensorHandler::start() {
@@ -189,8 +228,16 @@ void SensorHandler::stop() {
             << std::endl; // LCOV_EXCL_LINE - Debug logging
 
   // Set stop flag regardless of previous value
-  stop_flag = true;
-  data_cv.notify_all();
+  {
+    // Take the locks so a publisher between its predicate check and wait
+    // cannot miss the notification
+    std::lock_guard<std::mutex> critical_lock(critical_mutex);
+    std::lock_guard<std::mutex> non_critical_lock(non_critical_mutex);
+    stop_flag = true;
+  }
+  critical_cv.notify_all();
+  non_critical_cv.notify_all();
+  wakeReader();
 
   // Stop CAN sensors first
   {
@@ -256,42 +303,183 @@ void SensorHandler::readSensors() {
                                                        // handling
         }
       }
+      collectDirtyChannels();
+    }
+    // Polled sensors are read every interval, pushed ones when they notify
+    std::unique_lock<std::mutex> lock(read_mutex);
+    read_cv.wait_for(lock, std::chrono::milliseconds(sensor_read_interval_ms),
+                     [this] { return read_pending || stop_flag.load(); });
+    read_pending = false;
+  }
+}
+
+void SensorHandler::watchSensor(const std::shared_ptr<ISensor> &sensor) {
+  sensor->setUpdateNotifier([this] { wakeReader(); });
+}
+
+void SensorHandler::wakeReader() {
+  {
+    std::lock_guard<std::mutex> lock(read_mutex);
+    read_pending = true;
+  }
+  read_cv.notify_one();
+}
+
+void SensorHandler::markDirty(std::vector<std::shared_ptr<SensorData>> &dirty,
+                              const std::shared_ptr<SensorData> &data) {
+  // A channel changed twice before publishing goes out once, with its latest
+  // value; sets are a handful of entries so a linear check is cheapest
+  for (const auto &entry : dirty) {
+    if (entry == data) {
+      return;
+    }
+  }
+  dirty.push_back(data);
+}
+
+void SensorHandler::collectDirtyChannels() {
+  // Called with sensors_mutex held. Consuming the flag means a value is sent
+  // once per change instead of on every tick.
+  std::vector<std::shared_ptr<SensorData>> critical;
+  std::vector<std::shared_ptr<SensorData>> non_critical;
+  for (auto &channel : _channels) {
+    if (!channel.data->updated.exchange(false)) {
+      continue;
+    }
+    unsigned int value = channel.data->value.load();
+    if (channel.seen && value == channel.last_value) {
+      continue;
+    }
+    channel.last_value = value;
+    channel.seen = true;
+    (channel.data->critical ? critical : non_critical).push_back(channel.data);
+  }
+
+  if (!critical.empty()) {
+    {
+      std::lock_guard<std::mutex> lock(critical_mutex);
+      for (const auto &data : critical) {
+        markDirty(_criticalDirty, data);
+      }
+    }
+    critical_cv.notify_one();
+  }
+
+  if (!non_critical.empty()) {
+    std::lock_guard<std::mutex> lock(non_critical_mutex);
+    for (const auto &data : non_critical) {
+      markDirty(_nonCriticalDirty, data);
     }
-    data_cv.notify_all();
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(sensor_read_interval_ms));
   }
 }
 
 void SensorHandler::publishNonCritical() {
+  std::vector<std::shared_ptr<SensorData>> batch;
   while (!stop_flag) {
-    std::unique_lock<std::mutex> lock(non_critical_mutex);
-    data_cv.wait_for(
-        lock, std::chrono::milliseconds(non_critical_update_interval_ms));
-
-    if (!stop_flag) {
-      for (const auto &[name, data] : _nonCriticalData) {
-        if (data && data->updated) {
-          publishSensorData(data);
-        }
+    {
+      // Rate limit: collect changes for one interval, then send the latest
+      // value of each changed channel
+      std::unique_lock<std::mutex> lock(non_critical_mutex);
+      non_critical_cv.wait_for(
+          lock, std::chrono::milliseconds(non_critical_update_interval_ms),
+          [this] { return stop_flag.load(); });
+      if (stop_flag) {
+        break;
       }
+      batch.swap(_nonCriticalDirty);
     }
+
+    for (const auto &data : batch) {
+      publishSensorData(data);
+    }
+    batch.clear();
   }
 }
 
 void SensorHandler::publishCritical() {
+  std::vector<std::shared_ptr<SensorData>> batch;
   while (!stop_flag) {
-    std::unique_lock<std::mutex> lock(critical_mutex);
-    data_cv.wait_for(lock,
-                     std::chrono::milliseconds(critical_update_interval_ms));
-
-    if (!stop_flag) {
-      for (const auto &[name, data] : _criticalData) {
-        if (data && data->updated) {
-          publishSensorData(data);
-        }
+    {
+      std::unique_lock<std::mutex> lock(critical_mutex);
+      critical_cv.wait(lock, [this] {
+        return stop_flag.load() || !_criticalDirty.empty();
+      });
+      if (stop_flag) {
+        break;
       }
+      batch.swap(_criticalDirty);
+    }
+
+    if (critical_wire_format.load() == WireFormat::Binary) {
+      publishCriticalFrame(batch);
+    } else {
+      for (const auto &data : batch) {
+        publishSensorData(data);
+      }
+    }
+    batch.clear();
+  }
+}
+
+void SensorHandler::setCriticalWireFormat(WireFormat format) {
+  critical_wire_format.store(format);
+}
+
+void SensorHandler::recordCriticalLatency(const SensorData &sensorData) {
+  auto age = std::chrono::steady_clock::now() - sensorData.timestamp.load();
+  auto latency_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(age).count();
+  uint64_t sample = latency_us > 0 ? static_cast<uint64_t>(latency_us) : 0;
+  critical_latency_samples.fetch_add(1);
+  critical_latency_total_us.fetch_add(sample);
+  uint64_t max = critical_latency_max_us.load();
+  while (sample > max &&
+         !critical_latency_max_us.compare_exchange_weak(max, sample)) {
+  }
+}
+
+void SensorHandler::publishCriticalFrame(
+    const std::vector<std::shared_ptr<SensorData>> &batch) {
+  // Every changed channel of this tick in one fixed-layout message
+  sensor_frame::Record records[sensor_frame::kMaxRecords];
+  size_t count = 0;
+  for (const auto &data : batch) {
+    auto channel = sensor_frame::channelFromName(data->name);
+    if (channel == sensor_frame::Channel::Unknown) {
+      std::cerr << "No binary channel id for " << data->name << ", skipped"
+                << std::endl; // LCOV_EXCL_LINE - Error handling
+      continue;
+    }
+    if (count == sensor_frame::kMaxRecords) {
+      break;
     }
+    records[count++] = {
+        channel, data->value.load(),
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                data->timestamp.load().time_since_epoch())
+                .count())};
+  }
+  if (count == 0) {
+    return;
+  }
+
+  uint8_t frame[sensor_frame::kMaxFrameSize];
+  size_t size = sensor_frame::encode(critical_sequence++, records, count, frame,
+                                     sizeof(frame));
+  try {
+    zmq_c_publisher->send(
+        std::string_view(reinterpret_cast<const char *>(frame), size));
+    critical_messages.fetch_add(1);
+    for (const auto &data : batch) {
+      recordCriticalLatency(*data);
+      _logger.logSensorUpdate(data);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Error publishing sensor frame: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    _logger.logError("critical", std::string("Error publishing frame: ") +
+                                     e.what());
   }
 }
 
@@ -303,18 +491,29 @@ void SensorHandler::publishSensorData(
     return;
   }
 
-  std::string dataStr =
-      sensorData->name + ":" + std::to_string(sensorData->value) + ";";
+  // Formatted on the stack so publishing does not touch the heap
+  char buffer[96];
+  int length = std::snprintf(buffer, sizeof(buffer), "%s:%u;",
+                             sensorData->name.c_str(), sensorData->value.load());
+  std::string overflow;
+  std::string_view dataStr(buffer, length > 0 ? length : 0);
+  if (length >= static_cast<int>(sizeof(buffer))) {
+    overflow = sensorData->name + ":" + std::to_string(sensorData->value) + ";";
+    dataStr = overflow;
+  }
 
   try {
     if (sensorData->critical) {
       std::cout << "Publishing critical data: " << dataStr
                 << std::endl; // LCOV_EXCL_LINE - Debug logging
       zmq_c_publisher->send(dataStr);
+      critical_messages.fetch_add(1);
+      recordCriticalLatency(*sensorData);
     } else {
       std::cout << "Publishing non-critical data: " << dataStr
                 << std::endl; // LCOV_EXCL_LINE - Debug logging
       zmq_nc_publisher->send(dataStr);
+      non_critical_messages.fetch_add(1);
     }
     _logger.logSensorUpdate(sensorData);
   } catch (const std::exception &e) {
@@ -0,0 +1,158 @@
+#include "SnapshotService.hpp"
+#include "SensorFrame.hpp"
+#include <chrono>
+#include <iostream>
+
+class SnapshotService::Tap : public IPublisher {
+public:
+  Tap(SnapshotService &service, std::shared_ptr<IPublisher> inner)
+      : _service(service), _inner(std::move(inner)) {}
+
+  void send(const std::string &message) override {
+    send(std::string_view(message));
+  }
+
+  void send(std::string_view message) override {
+    _service.record(message);
+    _inner->send(message);
+  }
+
+private:
+  SnapshotService &_service;
+  std::shared_ptr<IPublisher> _inner;
+};
+
+SnapshotService::SnapshotService(const std::string &address,
+                                 zmq::context_t &context, bool test_mode)
+    : _address(address), _socket(context, zmq::socket_type::rep),
+      _test_mode(test_mode) {
+  if (!test_mode) {
+    try {
+      int linger = 0;
+      _socket.set(zmq::sockopt::linger, linger);
+      _socket.bind(address);
+      _is_bound = true;
+    } catch (const zmq::error_t &e) {
+      std::cerr << "ZMQ Error initializing snapshot service: " << e.what()
+                << std::endl; // LCOV_EXCL_LINE - ZMQ error handling
+    }
+  }
+}
+
+SnapshotService::~SnapshotService() {
+  stop();
+  try {
+    _socket.close();
+  } catch (const std::exception &e) {
+    // Ignore errors during cleanup
+  }
+}
+
+void SnapshotService::start() {
+  if (!_is_bound || !stop_flag.exchange(false)) {
+    return;
+  }
+  _serveThread = std::thread(&SnapshotService::serveLoop, this);
+}
+
+void SnapshotService::stop() {
+  stop_flag = true;
+  if (_serveThread.joinable()) {
+    _serveThread.join();
+  }
+}
+
+std::shared_ptr<IPublisher>
+SnapshotService::tap(std::shared_ptr<IPublisher> inner) {
+  return std::make_shared<Tap>(*this, std::move(inner));
+}
+
+void SnapshotService::record(std::string_view message) {
+  std::lock_guard<std::mutex> lock(_stateMutex);
+
+  sensor_frame::Header header;
+  if (sensor_frame::decode(
+          message.data(), message.size(), header,
+          [this](const sensor_frame::Record &record) {
+            store(sensor_frame::channelName(record.channel),
+                  std::to_string(record.value));
+          })) {
+    _frameSequence = header.sequence;
+    _hasFrame = true;
+    _sequence++;
+    return;
+  }
+
+  // One or more "name:value;" pairs; markers such as "init;" carry no state
+  bool changed = false;
+  size_t pos = 0;
+  while (pos < message.size()) {
+    size_t end = message.find(';', pos);
+    if (end == std::string_view::npos) {
+      end = message.size();
+    }
+    size_t colon = message.find(':', pos);
+    if (colon != std::string_view::npos && colon > pos && colon < end) {
+      store(message.substr(pos, colon - pos),
+            message.substr(colon + 1, end - colon - 1));
+      changed = true;
+    }
+    pos = end + 1;
+  }
+  if (changed) {
+    _sequence++;
+  }
+}
+
+void SnapshotService::store(std::string_view name, std::string_view value) {
+  // Known channels are updated in place without building a key
+  auto it = _state.find(name);
+  if (it == _state.end()) {
+    _state.emplace(std::string(name), std::string(value));
+  } else {
+    it->second.assign(value.data(), value.size());
+  }
+}
+
+std::string SnapshotService::snapshot() const {
+  std::lock_guard<std::mutex> lock(_stateMutex);
+  std::string reply = "seq:" + std::to_string(_sequence) + ";";
+  if (_hasFrame) {
+    reply += "frame:" + std::to_string(_frameSequence) + ";";
+  }
+  for (const auto &entry : _state) {
+    reply += entry.first + ":" + entry.second + ";";
+  }
+  return reply;
+}
+
+uint64_t SnapshotService::getSequence() const {
+  std::lock_guard<std::mutex> lock(_stateMutex);
+  return _sequence;
+}
+
+void SnapshotService::serveLoop() {
+  while (!stop_flag) {
+    try {
+      zmq::pollitem_t items[] = {
+          {static_cast<void *>(_socket), 0, ZMQ_POLLIN, 0}};
+      zmq::poll(&items[0], 1, std::chrono::milliseconds(100));
+      if (!(items[0].revents & ZMQ_POLLIN)) {
+        continue;
+      }
+
+      // The request body is ignored; every request gets the full state
+      zmq::message_t request;
+      if (!_socket.recv(request, zmq::recv_flags::dontwait)) {
+        continue;
+      }
+      std::string reply = snapshot();
+      _socket.send(zmq::message_t(reply.data(), reply.size()),
+                   zmq::send_flags::none);
+      request_count.fetch_add(1);
+    } catch (const zmq::error_t &e) {
+      std::cerr << "ZMQ Error in snapshot service: " << e.what()
+                << std::endl; // LCOV_EXCL_LINE - ZMQ error handling
+    }
+  }
+}
@@ -31,7 +31,8 @@ void Speed::start() {
   if (!subscribed.load()) {
     auto &bus = CanMessageBus::getInstance();
 
-    std::vector<uint16_t> canIds = {canId, canId2, canId3};
+    std::vector<uint16_t> canIds = {canId,       canId2,       canId3,
+                                    timingCanId, timingCanId2, timingCanId3};
     bus.subscribeToMultipleIds(shared_from_this(), canIds);
     subscribed.store(true);
   }
@@ -55,20 +56,46 @@ void Speed::updateSensorData() {
 void Speed::onCanMessage(const CanMessage &message) {
   // Accept messages from multiple CAN IDs (due to crystal frequency
   // differences)
-  if (message.id != canId && message.id != canId2 && message.id != canId3) {
+  bool is_timing = message.id == timingCanId || message.id == timingCanId2 ||
+                   message.id == timingCanId3;
+  if (!is_timing && message.id != canId && message.id != canId2 &&
+      message.id != canId3) {
     return; // Should not happen, but safety check
   }
 
   std::lock_guard<std::mutex> lock(data_mutex);
 
+  if (is_timing) {
+    if (message.length < 8) {
+      return;
+    }
+    // buffer[0-3]: micros() of the last counted edge
+    // buffer[4-7]: micros() at the end of the measurement interval
+    pending_edge_us = message.data[0] | (message.data[1] << 8) |
+                      (message.data[2] << 16) |
+                      (static_cast<uint32_t>(message.data[3]) << 24);
+    pending_sample_us = message.data[4] | (message.data[5] << 8) |
+                        (message.data[6] << 16) |
+                        (static_cast<uint32_t>(message.data[7]) << 24);
+    pending_timing_valid = true;
+    return;
+  }
+
   // Store the latest message data
   std::memcpy(latest_data, message.data, std::min(message.length, (uint8_t)8));
   latest_length = message.length;
   latest_timestamp = message.timestamp;
+
+  // The timing frame precedes its pulse frame; pair them here
+  latest_timing_valid = pending_timing_valid;
+  latest_edge_us = pending_edge_us;
+  latest_sample_us = pending_sample_us;
+  pending_timing_valid = false;
   new_data_available.store(true);
 
   std::cout << "Speed received CAN message with " << (int)message.length
             << " bytes" << std::endl; // LCOV_EXCL_LINE - Debug logging
+  notifyUpdate();
 }
 
 void Speed::readSensor() {
@@ -87,19 +114,49 @@ void Speed::readSensor() {
     uint32_t new_total_pulses = latest_data[2] | (latest_data[3] << 8) |
                                 (latest_data[4] << 16) | (latest_data[5] << 24);
 
+    // buffer[6-7]: Device-side interval length in microseconds (0 = legacy
+    // firmware without timing support)
+    uint16_t interval_us = 0;
+    if (latest_length >= 8) {
+      interval_us = latest_data[6] | (latest_data[7] << 8);
+    }
+
     // Validate pulse data
-    if (new_total_pulses < total_pulses) {
+    bool reset_detected = have_total && new_total_pulses < total_pulses;
+    if (reset_detected) {
       std::cout
           << "Warning: Total pulse count decreased (possible Arduino reset)"
           << std::endl; // LCOV_EXCL_LINE - Debug logging
+      edge_count = 0;
+      have_sample_time = false;
     }
 
+    uint32_t previous_total = total_pulses;
+    bool had_total = have_total && !reset_detected;
     last_pulse_delta = pulse_delta;
+    trackFrameContinuity(new_total_pulses, interval_us);
     total_pulses = new_total_pulses;
+    have_total = true;
+
+    if (latest_timing_valid) {
+      device_timing_seen.store(true);
+      pushEdgeSample(new_total_pulses, latest_edge_us);
+      calculateSpeedFromEdges(latest_sample_us);
+    } else if (interval_us > 0) {
+      calculateSpeedFromInterval(interval_us);
+    } else {
+      calculateSpeed();
+    }
 
-    // Calculate speed and odometer
-    calculateSpeed();
-    calculateOdo();
+    // Timing-capable firmware sends a trustworthy running total, so the
+    // odometer follows it and survives dropped frames. Legacy firmware only
+    // guarantees the per-interval delta.
+    if (interval_us > 0 && had_total) {
+      calculateOdo(static_cast<double>(new_total_pulses - previous_total) /
+                   interruptsPerPulse);
+    } else {
+      calculateOdo(pulse_delta);
+    }
 
     std::cout << "Speed updated with " << pulse_delta
               << " pulses (total: " << total_pulses << ")"
@@ -112,6 +169,132 @@ void Speed::readSensor() {
   new_data_available.store(false);
 }
 
+void Speed::trackFrameContinuity(uint32_t new_total, uint16_t interval_us) {
+  // Prefer the device clock: a sample gap of several intervals means frames
+  // were lost on the bus or overwritten before this sensor was polled
+  if (latest_timing_valid && interval_us > 0) {
+    if (have_sample_time) {
+      uint32_t gap_us = latest_sample_us - last_sample_us;
+      uint32_t intervals = (gap_us + interval_us / 2) / interval_us;
+      if (intervals > 1) {
+        dropped_frames.fetch_add(intervals - 1);
+        std::cout << "Speed: " << (intervals - 1)
+                  << " frame(s) missing by device clock"
+                  << std::endl; // LCOV_EXCL_LINE - Debug logging
+      }
+    }
+    last_sample_us = latest_sample_us;
+    have_sample_time = true;
+    return;
+  }
+
+  // Without timestamps, a total that advanced by more than this frame's
+  // delta (plus the rounding of the interrupt-to-pulse division) means the
+  // pulses of at least one frame never arrived
+  if (have_total && new_total >= total_pulses) {
+    uint32_t advanced = new_total - total_pulses;
+    if (advanced > (static_cast<uint32_t>(last_pulse_delta) + 1) *
+                       interruptsPerPulse) {
+      dropped_frames.fetch_add(1);
+      std::cout << "Speed: frame gap detected (total advanced by " << advanced
+                << ", delta " << last_pulse_delta << ")"
+                << std::endl; // LCOV_EXCL_LINE - Debug logging
+    }
+  }
+}
+
+void Speed::pushEdgeSample(uint32_t total, uint32_t edge_us) {
+  if (edge_count > 0) {
+    const EdgeSample &newest =
+        edge_history[(edge_head + edge_count - 1) % edgeHistorySize];
+    if (newest.total_interrupts == total) {
+      return; // No edge since the previous frame
+    }
+  }
+
+  if (edge_count < edgeHistorySize) {
+    edge_history[(edge_head + edge_count) % edgeHistorySize] = {total, edge_us};
+    edge_count++;
+  } else {
+    edge_history[edge_head] = {total, edge_us};
+    edge_head = (edge_head + 1) % edgeHistorySize;
+  }
+}
+
+void Speed::calculateSpeedFromEdges(uint32_t sample_us) {
+  if (edge_count < 2) {
+    // A single edge carries no period information yet
+    storeSpeed(0);
+    return;
+  }
+
+  const EdgeSample &newest =
+      edge_history[(edge_head + edge_count - 1) % edgeHistorySize];
+  uint32_t since_edge_us = sample_us - newest.edge_us;
+  if (since_edge_us >= standstillTimeout_us) {
+    storeSpeed(0);
+    return;
+  }
+
+  // Adaptive window: span as many edges as fit in estimationWindow_us so
+  // fast wheels average over many pulses, but always keep at least one
+  // period so slow wheels still resolve
+  size_t ref = edge_count - 2;
+  for (size_t i = 0; i + 1 < edge_count; ++i) {
+    const EdgeSample &candidate =
+        edge_history[(edge_head + i) % edgeHistorySize];
+    if (newest.edge_us - candidate.edge_us <= estimationWindow_us) {
+      ref = i;
+      break;
+    }
+  }
+  const EdgeSample &oldest = edge_history[(edge_head + ref) % edgeHistorySize];
+
+  double pulses =
+      static_cast<double>(newest.total_interrupts - oldest.total_interrupts) /
+      interruptsPerPulse;
+  double span_s = static_cast<double>(newest.edge_us - oldest.edge_us) / 1e6;
+  if (span_s <= 0.0) {
+    storeSpeed(0);
+    return;
+  }
+  double speed_mms = pulses * mm_per_pulse / span_s;
+
+  // No edge for longer than the measured period: the wheel is slowing, and
+  // the next pulse is at least since_edge_us away
+  double bound_mms = mm_per_pulse / (static_cast<double>(since_edge_us) / 1e6);
+  if (since_edge_us > 0 && bound_mms < speed_mms) {
+    speed_mms = bound_mms;
+  }
+
+  storeSpeed(static_cast<uint32_t>(speed_mms + 0.5));
+  last_measurement_time = latest_timestamp;
+
+  std::cout << "Speed calculated: " << _sensorData["speed"]->value.load()
+            << " mm/s (edge timing, " << pulses << " pulses in " << span_s
+            << "s)" << std::endl; // LCOV_EXCL_LINE - Debug logging
+}
+
+void Speed::calculateSpeedFromInterval(uint16_t interval_us) {
+  // Device interval length is immune to host jitter but still quantised to
+  // whole pulses per interval
+  double speed_mms = static_cast<double>(last_pulse_delta) * mm_per_pulse /
+                     (static_cast<double>(interval_us) / 1e6);
+  storeSpeed(static_cast<uint32_t>(speed_mms + 0.5));
+  last_measurement_time = latest_timestamp;
+}
+
+void Speed::storeSpeed(uint32_t speed_value) {
+  auto old_speed = _sensorData["speed"]->value.load();
+  _sensorData["speed"]->oldValue.store(old_speed);
+  _sensorData["speed"]->value.store(speed_value);
+  _sensorData["speed"]->timestamp = latest_timestamp;
+  // Only a changed value is news for the publishers
+  if (speed_value != old_speed) {
+    _sensorData["speed"]->updated.store(true);
+  }
+}
+
 void Speed::calculateSpeed() {
   // Calculate time difference since last measurement
   auto current_time = latest_timestamp;
@@ -120,13 +303,6 @@ void Speed::calculateSpeed() {
   double time_diff_seconds = duration.count();
 
   if (time_diff_seconds > 0 && last_pulse_delta > 0) {
-    // Calculate distance traveled in mm directly from pulses
-    // Each pulse = wheelCircumference_mm / pulsesPerRevolution
-    // wheelCircumference_mm = π * diameter = π * 67mm ≈ 210.5mm
-    static constexpr double wheelCircumference_mm = wheelDiameter_mm * 3.14159;
-    static constexpr double mm_per_pulse =
-        wheelCircumference_mm / pulsesPerRevolution;
-
     double distance_mm = static_cast<double>(last_pulse_delta) * mm_per_pulse;
 
     // Calculate speed directly in mm/s
@@ -134,13 +310,7 @@ void Speed::calculateSpeed() {
 
     // Store as rounded mm/s (integer resolution)
     uint32_t speed_value = static_cast<uint32_t>(speed_mms + 0.5);
-
-    // Update speed sensor data
-    auto old_speed = _sensorData["speed"]->value.load();
-    _sensorData["speed"]->oldValue.store(old_speed);
-    _sensorData["speed"]->value.store(speed_value);
-    _sensorData["speed"]->timestamp = current_time;
-    _sensorData["speed"]->updated.store(true);
+    storeSpeed(speed_value);
 
     std::cout << "Speed calculated: " << speed_value << " mm/s"
               << " (from " << last_pulse_delta << " pulses in "
@@ -148,11 +318,7 @@ void Speed::calculateSpeed() {
               << std::endl; // LCOV_EXCL_LINE - Debug logging
   } else {
     // No movement or invalid time difference
-    auto old_speed = _sensorData["speed"]->value.load();
-    _sensorData["speed"]->oldValue.store(old_speed);
-    _sensorData["speed"]->value.store(0);
-    _sensorData["speed"]->timestamp = current_time;
-    _sensorData["speed"]->updated.store(true);
+    storeSpeed(0);
 
     if (time_diff_seconds <= 0) {
       std::cout << "Speed: Invalid time difference: " << time_diff_seconds
@@ -166,17 +332,10 @@ void Speed::calculateSpeed() {
   last_measurement_time = current_time;
 }
 
-void Speed::calculateOdo() {
-  // Calculate incremental distance from pulse delta (same as speed calculation)
-  // Each pulse = wheelCircumference_mm / pulsesPerRevolution
-  // wheelCircumference_mm = π * diameter = π * 67mm ≈ 210.5mm
-  static constexpr double wheelCircumference_mm = wheelDiameter_mm * 3.14159;
-  static constexpr double mm_per_pulse =
-      wheelCircumference_mm / pulsesPerRevolution;
-
-  if (last_pulse_delta > 0) {
-    // Calculate incremental distance from this CAN message's pulse delta
-    double distance_mm = static_cast<double>(last_pulse_delta) * mm_per_pulse;
+void Speed::calculateOdo(double pulses) {
+  if (pulses > 0) {
+    // Calculate incremental distance from the pulses covered by this frame
+    double distance_mm = pulses * mm_per_pulse;
     double distance_m = distance_mm / 1000.0; // mm to meters
 
     // Add to accumulated distance with high precision
@@ -198,7 +357,7 @@ void Speed::calculateOdo() {
         distance_mm > 1.0) { // Update if meter value changed or moved > 1mm
       _sensorData["odo"]->updated.store(true);
       std::cout << "Odometer updated: " << new_odo_value << " meters"
-                << " (added " << distance_m << "m from " << last_pulse_delta
+                << " (added " << distance_m << "m from " << pulses
                 << " pulses, total: " << accumulated_distance_m << "m)"
                 << std::endl; // LCOV_EXCL_LINE - Debug logging
     }
@@ -0,0 +1,85 @@
+#include "SpeedController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+SpeedController::SpeedController() : SpeedController(Config()) {}
+
+SpeedController::SpeedController(Config config) : _config(config) {
+  if (_config.kp < 0 || _config.ki < 0 || _config.max_throttle <= 0) {
+    throw std::invalid_argument("SpeedController gains must be non-negative "
+                                "and max_throttle positive");
+  }
+}
+
+double SpeedController::update(double target_mms, double measured_mms,
+                               double dt_s) {
+  int direction = target_mms > 0 ? 1 : target_mms < 0 ? -1 : 0;
+  if (direction != _direction) {
+    _integral = 0;
+    _direction = direction;
+  }
+
+  double target = std::abs(target_mms);
+  double measured = std::abs(measured_mms);
+  double error = target - measured;
+
+  double output = 0;
+  bool saturated = false;
+  if (direction != 0) {
+    // Integrate only up to where the output reaches its limit
+    double previous = _integral;
+    double proportional = _config.kp * error;
+    _integral += error * dt_s;
+    if (_config.ki > 0) {
+      double upper = (_config.max_throttle - proportional) / _config.ki;
+      double lower = -proportional / _config.ki;
+      if (error > 0 && _integral > upper) {
+        _integral = std::max(previous, upper);
+      } else if (error < 0 && _integral < lower) {
+        _integral = std::min(previous, lower);
+      }
+    }
+    output = proportional + _config.ki * _integral;
+    saturated = output >= _config.max_throttle || output <= 0;
+    output = std::min(std::max(output, 0.0), _config.max_throttle);
+  }
+
+  _updates++;
+  _saturated += saturated ? 1 : 0;
+  _errorSum += std::abs(error);
+  _errorSquares += error * error;
+  _errorMax = std::max(_errorMax, std::abs(error));
+  _lastTarget = target_mms;
+  _lastMeasured = measured_mms;
+  _lastOutput = direction * output;
+  return _lastOutput;
+}
+
+void SpeedController::reset() {
+  _integral = 0;
+  _direction = 0;
+}
+
+SpeedController::Stats SpeedController::getStats() const {
+  Stats stats;
+  stats.updates = _updates;
+  stats.saturated = _saturated;
+  if (_updates > 0) {
+    stats.error_avg_mms = _errorSum / _updates;
+    stats.error_rms_mms = std::sqrt(_errorSquares / _updates);
+  }
+  stats.error_max_mms = _errorMax;
+  stats.last_target_mms = _lastTarget;
+  stats.last_measured_mms = _lastMeasured;
+  stats.last_output = _lastOutput;
+  return stats;
+}
+
+void SpeedController::resetStats() {
+  _updates = 0;
+  _saturated = 0;
+  _errorSum = 0;
+  _errorSquares = 0;
+  _errorMax = 0;
+}
@@ -0,0 +1,97 @@
+#include "StatePublisher.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+StatePublisher::StatePublisher(std::shared_ptr<IPublisher> publisher,
+                               std::string name,
+                               const StatePublishPolicy &policy)
+    : _publisher(std::move(publisher)), _name(std::move(name)),
+      _policy(policy),
+      _timer(_name + " state",
+             [this](Clock::time_point now) { return flushDue(now); }) {
+  if (!_publisher) {
+    throw std::invalid_argument("StatePublisher needs a publisher");
+  }
+}
+
+StatePublisher::~StatePublisher() { stop(); }
+
+void StatePublisher::set(std::string_view value) { set(value, Clock::now()); }
+
+void StatePublisher::set(std::string_view value, Clock::time_point now) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.updates++;
+    if (_hasValue && value == _value) {
+      return;
+    }
+
+    _hasValue = true;
+    _value.assign(value.data(), value.size());
+    _message.assign(_name).append(1, ':').append(_value).append(1, ';');
+    _stats.changes++;
+    sendCurrent(now);
+
+    _retransmitsLeft = std::max(_policy.retransmits, 0);
+    _backoff = _policy.initial_backoff;
+    _nextRetransmit = now + _backoff;
+  }
+
+  // The timer may be sleeping towards a later heartbeat
+  _timer.wake();
+}
+
+void StatePublisher::start() { _timer.start(); }
+
+void StatePublisher::stop() { _timer.stop(); }
+
+StatePublisher::Clock::time_point
+StatePublisher::flushDue(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_hasValue) {
+    return Clock::time_point::max();
+  }
+
+  if (_retransmitsLeft > 0 && now >= _nextRetransmit) {
+    sendCurrent(now);
+    _stats.retransmits++;
+    _retransmitsLeft--;
+    _backoff *= 2;
+    _nextRetransmit = now + _backoff;
+  } else if (_policy.heartbeat.count() > 0 &&
+             now - _lastSent >= _policy.heartbeat) {
+    sendCurrent(now);
+    _stats.heartbeats++;
+  }
+
+  auto next = Clock::time_point::max();
+  if (_retransmitsLeft > 0) {
+    next = _nextRetransmit;
+  }
+  if (_policy.heartbeat.count() > 0) {
+    next = std::min(next, _lastSent + _policy.heartbeat);
+  }
+  return next;
+}
+
+void StatePublisher::sendCurrent(Clock::time_point now) {
+  try {
+    _publisher->send(std::string_view(_message));
+  } catch (const std::exception &e) {
+    std::cerr << "Error publishing " << _name << " state: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+  }
+  _lastSent = now;
+  _stats.sent++;
+}
+
+std::string StatePublisher::getValue() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _value;
+}
+
+StatePublisher::Stats StatePublisher::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
@@ -0,0 +1,179 @@
+#include "TelemetryPolicyPublisher.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+TelemetryPolicyPublisher::TelemetryPolicyPublisher(
+    std::shared_ptr<IPublisher> inner)
+    : _inner(std::move(inner)),
+      _timer("telemetry",
+             [this](Clock::time_point now) { return flushDue(now); }) {
+  if (!_inner) {
+    throw std::invalid_argument("TelemetryPolicyPublisher needs a publisher");
+  }
+}
+
+TelemetryPolicyPublisher::~TelemetryPolicyPublisher() { stop(); }
+
+void TelemetryPolicyPublisher::setPolicy(const std::string &channel,
+                                         const TelemetryPolicy &policy) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  ChannelState state;
+  state.policy = policy;
+  _channels[channel] = state;
+}
+
+void TelemetryPolicyPublisher::send(const std::string &message) {
+  offer(message, Clock::now());
+}
+
+void TelemetryPolicyPublisher::send(std::string_view message) {
+  offer(message, Clock::now());
+}
+
+void TelemetryPolicyPublisher::start() { _timer.start(); }
+
+void TelemetryPolicyPublisher::stop() { _timer.stop(); }
+
+bool TelemetryPolicyPublisher::splitMessage(std::string_view message,
+                                            std::string_view &name,
+                                            std::string_view &value) {
+  // Exactly one "name:value" pair with an optional trailing ';'
+  size_t colon = message.find(':');
+  if (colon == std::string_view::npos || colon == 0) {
+    return false;
+  }
+  size_t end = message.find(';', colon);
+  if (end != std::string_view::npos && end + 1 != message.size()) {
+    return false;
+  }
+  name = message.substr(0, colon);
+  value = message.substr(
+      colon + 1,
+      (end == std::string_view::npos ? message.size() : end) - colon - 1);
+  return true;
+}
+
+bool TelemetryPolicyPublisher::parseNumber(const std::string &value,
+                                           double &number) {
+  if (value.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  number = std::strtod(value.c_str(), &end);
+  return end == value.c_str() + value.size() && std::isfinite(number);
+}
+
+bool TelemetryPolicyPublisher::isSignificant(const ChannelState &state,
+                                             const std::string &value) {
+  if (!state.has_sent) {
+    return true;
+  }
+  double number = 0.0;
+  if (!state.numeric || !parseNumber(value, number)) {
+    return value != state.sent_text;
+  }
+
+  const TelemetryPolicy &policy = state.policy;
+  double delta = std::fabs(number - state.sent_value);
+  if (policy.abs_deadband <= 0.0 && policy.rel_deadband <= 0.0) {
+    return delta > 0.0;
+  }
+  if (policy.abs_deadband > 0.0 && delta >= policy.abs_deadband) {
+    return true;
+  }
+  return policy.rel_deadband > 0.0 &&
+         delta >= policy.rel_deadband * std::fabs(state.sent_value);
+}
+
+void TelemetryPolicyPublisher::sendLatest(ChannelState &state,
+                                          Clock::time_point now) {
+  // Forwarded under _mutex so one channel's values never overtake each other
+  _inner->send(std::string_view(state.latest));
+  state.has_sent = true;
+  state.sent_time = now;
+  state.sent_text = state.latest_value;
+  state.numeric = parseNumber(state.latest_value, state.sent_value);
+  state.pending = false;
+  _stats.forwarded++;
+}
+
+void TelemetryPolicyPublisher::offer(std::string_view message,
+                                     Clock::time_point now) {
+  std::string_view name;
+  std::string_view value;
+  bool wake = false;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.offered++;
+
+    auto it = _channels.end();
+    if (splitMessage(message, name, value)) {
+      _lookup.assign(name.data(), name.size());
+      it = _channels.find(_lookup);
+    }
+    if (it == _channels.end()) {
+      _inner->send(message);
+      _stats.forwarded++;
+      return;
+    }
+
+    // assign() keeps the buffers once they have grown to the message size
+    ChannelState &state = it->second;
+    state.latest.assign(message.data(), message.size());
+    state.latest_value.assign(value.data(), value.size());
+
+    if (!isSignificant(state, state.latest_value)) {
+      // Back within the dead-band of what the consumer already has
+      state.pending = false;
+      _stats.suppressed++;
+    } else if (!state.has_sent ||
+               now - state.sent_time >= state.policy.min_interval) {
+      sendLatest(state, now);
+    } else {
+      wake = !state.pending;
+      state.pending = true;
+      _stats.suppressed++;
+    }
+  }
+
+  if (wake) {
+    _timer.wake();
+  }
+}
+
+TelemetryPolicyPublisher::Clock::time_point
+TelemetryPolicyPublisher::flushDue(Clock::time_point now) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Clock::time_point next = Clock::time_point::max();
+
+  for (auto &entry : _channels) {
+    ChannelState &state = entry.second;
+    if (!state.has_sent) {
+      continue;
+    }
+    const TelemetryPolicy &policy = state.policy;
+
+    if (state.pending && now - state.sent_time >= policy.min_interval) {
+      sendLatest(state, now);
+    } else if (policy.heartbeat.count() > 0 &&
+               now - state.sent_time >= policy.heartbeat) {
+      sendLatest(state, now);
+      _stats.heartbeats++;
+    }
+
+    if (state.pending) {
+      next = std::min(next, state.sent_time + policy.min_interval);
+    }
+    if (policy.heartbeat.count() > 0) {
+      next = std::min(next, state.sent_time + policy.heartbeat);
+    }
+  }
+  return next;
+}
+
+TelemetryPolicyPublisher::Stats TelemetryPolicyPublisher::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
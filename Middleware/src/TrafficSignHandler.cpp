@@ -1,4 +1,6 @@
 #include "TrafficSignHandler.hpp"
+#include "KeyValueCodec.hpp"
+#include "Reactor.hpp"
 #include "ZmqPublisher.hpp"
 #include "ZmqSubscriber.hpp"
 #include <chrono>
@@ -7,13 +9,31 @@
 #include <stdexcept>
 #include <thread>
 
-// Define the map of publishable traffic signs
-const std::unordered_map<std::string, std::string>
-    TrafficSignHandler::publishable_signs = {{"SPEED_50", "50"},
-                                             {"SPEED_80", "80"},
-                                             {"STOP", "stop"},
-                                             {"CROSSWALK", "crosswalk"},
-                                             {"YIELD", "yield"}};
+// Publishable traffic signs and the cluster message for each. Kept as a
+// small constant table so a lookup neither hashes nor allocates.
+namespace {
+struct PublishableSign {
+  std::string_view name;
+  std::string_view message;
+};
+
+constexpr PublishableSign publishable_signs[] = {
+    {"SPEED_50", "sign:50"},
+    {"SPEED_80", "sign:80"},
+    {"STOP", "sign:stop"},
+    {"CROSSWALK", "sign:crosswalk"},
+    {"YIELD", "sign:yield"}};
+} // namespace
+
+std::string_view
+TrafficSignHandler::clusterMessageFor(std::string_view sign_name) {
+  for (const auto &sign : publishable_signs) {
+    if (sign.name == sign_name) {
+      return sign.message;
+    }
+  }
+  return std::string_view();
+}
 
 // TrafficSignHandler implementation
 TrafficSignHandler::TrafficSignHandler(
@@ -40,13 +60,22 @@ TrafficSignHandler::TrafficSignHandler(
 
 TrafficSignHandler::~TrafficSignHandler() { stop(); }
 
+void TrafficSignHandler::attachTo(Reactor &reactor) {
+  if (void *socket = traffic_sign_subscriber->handle()) {
+    reactor.addSocket(socket, [this] { drainTrafficSignData(0); });
+  }
+  _useReactor = true;
+}
+
 void TrafficSignHandler::start() {
   std::cout << "Starting Traffic Sign Handler..."
             << std::endl; // LCOV_EXCL_LINE - Debug logging
 
   stop_flag = false;
-  processing_thread =
-      std::thread(&TrafficSignHandler::receiveAndProcessTrafficSignData, this);
+  if (!_useReactor) {
+    processing_thread = std::thread(
+        &TrafficSignHandler::receiveAndProcessTrafficSignData, this);
+  }
 
   std::cout << "Traffic Sign Handler started successfully."
             << std::endl; // LCOV_EXCL_LINE - Debug logging
@@ -86,15 +115,7 @@ void TrafficSignHandler::receiveAndProcessTrafficSignData() {
 
   while (!stop_flag.load()) {
     try {
-      // Try to receive data from Traffic Sign Detection System
-      std::string received_data =
-          traffic_sign_subscriber->receive(processing_interval_ms);
-
-      if (!received_data.empty()) {
-        std::cout << "Received traffic sign data: " << received_data
-                  << std::endl; // LCOV_EXCL_LINE - Debug logging
-        processTrafficSignMessage(received_data);
-      }
+      drainTrafficSignData(processing_interval_ms);
 
       // Small sleep to prevent busy waiting
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -110,30 +131,30 @@ void TrafficSignHandler::receiveAndProcessTrafficSignData() {
             << std::endl; // LCOV_EXCL_LINE - Debug logging
 }
 
-void TrafficSignHandler::processTrafficSignMessage(const std::string &data) {
-  try {
-    std::string sign_name = data;
-
-    // Handle structured format: "traffic_sign:SIGN_TYPE" or
-    // "traffic_sign:SIGN_TYPE;"
-    if (data.find("traffic_sign:") == 0) {
-      size_t colon_pos = data.find(':');
-      if (colon_pos != std::string::npos && colon_pos + 1 < data.length()) {
-        sign_name = data.substr(colon_pos + 1);
-      }
+void TrafficSignHandler::drainTrafficSignData(int timeout_ms) {
+  // Try to receive data from Traffic Sign Detection System, then drain
+  // whatever else is already queued. While stopped the socket is still
+  // drained, a reactor would otherwise keep reporting it.
+  while (traffic_sign_subscriber->receiveInto(_receiveBuffer, timeout_ms)) {
+    timeout_ms = 0;
+    if (stop_flag.load()) {
+      continue;
     }
 
-    // Remove trailing semicolon if present
-    if (!sign_name.empty() && sign_name.back() == ';') {
-      sign_name.pop_back();
-    }
+    std::cout << "Received traffic sign data: " << _receiveBuffer
+              << std::endl; // LCOV_EXCL_LINE - Debug logging
+    processTrafficSignMessage(_receiveBuffer);
+  }
+}
 
-    // Check if this sign is in our publishable signs map
-    auto it = publishable_signs.find(sign_name);
-    if (it != publishable_signs.end()) {
-      // Found a publishable sign, publish it
-      std::string data_to_publish = "sign:" + it->second;
+void TrafficSignHandler::processTrafficSignMessage(const std::string &data) {
+  try {
+    const std::string_view sign_name = kv_codec::parseTrafficSign(data);
 
+    // Check if this sign is one we publish
+    const std::string_view data_to_publish = clusterMessageFor(sign_name);
+    if (!data_to_publish.empty()) {
+      // Found a publishable sign, publish it
       if (nc_publisher) {
         std::cout << "Publishing to cluster: " << data_to_publish
                   << " (from sign: " << sign_name << ")"
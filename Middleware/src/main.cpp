@@ -1,7 +1,12 @@
+#include "AsyncPublisher.hpp"
 #include "ControlAssembly.hpp"
 #include "LaneKeepingHandler.hpp"
+#include "Reactor.hpp"
 #include "SensorHandler.hpp"
+#include "SnapshotService.hpp"
+#include "TelemetryPolicyPublisher.hpp"
 #include "TrafficSignHandler.hpp"
+#include "Transport.hpp"
 #include "ZmqPublisher.hpp"
 #include <chrono>
 #include <csignal>
@@ -57,6 +62,17 @@ int main() {
         "tcp://127.0.0.1:5558"; // lane keeping assistance system addr
     const std::string zmq_traffic_sign_address =
         "tcp://127.0.0.1:5559"; // traffic sign detection system addr
+    // Critical channel encoding; switch to Binary once every consumer of
+    // zmq_c_address decodes sensor_frame messages.
+    const auto critical_wire_format = SensorHandler::WireFormat::Text;
+    // Throttle commands as target speeds (mm/s) tracked by the PI loop on
+    // the actuator thread, instead of PWM percent
+    const bool closed_loop_speed = false;
+    // Steer back on lane departures inside the middleware; turn off the
+    // lane-detection stack's own corrections when enabling it
+    const bool lane_assist = false;
+    const std::string zmq_snapshot_address =
+        "tcp://0.0.0.0:5562"; // late-joiner state snapshot (REP)
     // const std::string zmq_emergency_brake_address =
     //     "tcp://127.0.0.1:5561"; // emergency brake addr
 
@@ -66,19 +82,59 @@ int main() {
     // Initialize components
     // Create shared ZMQ publishers to avoid binding conflicts
     std::cout << "Creating shared ZMQ publishers..." << std::endl;
-    auto c_publisher =
-        std::make_shared<ZmqPublisher>(zmq_c_address, zmq_context);
-    auto nc_publisher =
+    // zmq_c_address may also be "shm://<name>" for co-located consumers
+    auto c_publisher = createPublisher(zmq_c_address, zmq_context);
+    auto nc_socket_publisher =
         std::make_shared<ZmqPublisher>(zmq_nc_address, zmq_context);
+    // The non-critical socket has producers on several threads (sensor
+    // batches, telemetry flushes, both control receivers); only the async
+    // publisher's thread touches the socket
+    auto nc_async_publisher =
+        std::make_shared<AsyncPublisher>(nc_socket_publisher);
+    nc_async_publisher->start();
+
+    // Record everything published so reconnecting clients can fetch the
+    // current state instead of waiting for each value to change. The
+    // non-critical tap sits behind the telemetry policies, so the snapshot
+    // and its seq:N match what subscribers actually received; mode and
+    // watchdog status are sent through it directly.
+    std::cout << "Starting snapshot service..." << std::endl;
+    auto snapshot_service = std::make_unique<SnapshotService>(
+        zmq_snapshot_address, zmq_context);
+    auto c_tap = snapshot_service->tap(c_publisher);
+    auto nc_tap = snapshot_service->tap(nc_async_publisher);
+    snapshot_service->start();
+
+    // Non-critical telemetry goes over the WAN to the cluster: drop
+    // insignificant changes, rate-limit, and resend unchanged values so
+    // nothing shown is older than its heartbeat
+    auto nc_publisher =
+        std::make_shared<TelemetryPolicyPublisher>(nc_tap);
+    using std::chrono::milliseconds;
+    nc_publisher->setPolicy(
+        "battery", {2.0, 0.0, milliseconds(1000), milliseconds(5000)});
+    nc_publisher->setPolicy("charging",
+                            {0.0, 0.0, milliseconds(0), milliseconds(5000)});
+    nc_publisher->setPolicy("odo",
+                            {0.0, 0.0, milliseconds(200), milliseconds(2000)});
+    nc_publisher->setPolicy("obs",
+                            {0.0, 0.0, milliseconds(0), milliseconds(1000)});
+    nc_publisher->setPolicy("lane",
+                            {0.0, 0.0, milliseconds(0), milliseconds(1000)});
+    nc_publisher->setPolicy("sign",
+                            {0.0, 0.0, milliseconds(0), milliseconds(5000)});
+    nc_publisher->start();
 
     std::cout << "Initializing sensor handler..." << std::endl;
     sensor_handler = std::make_unique<SensorHandler>(
-        zmq_c_address, zmq_nc_address, zmq_context, c_publisher, nc_publisher,
+        zmq_c_address, zmq_nc_address, zmq_context, c_tap, nc_publisher,
         true); // Use real sensors in production
+    sensor_handler->setCriticalWireFormat(critical_wire_format);
 
     std::cout << "Initializing control assembly..." << std::endl;
     control_assembly = std::make_unique<ControlAssembly>(
-        zmq_control_address, zmq_context, nullptr, nullptr, nc_publisher);
+        zmq_control_address, zmq_context, nullptr, nullptr,
+        nc_tap); // mode status bypasses the telemetry policies
 
     std::cout << "Initializing lane keeping handler..." << std::endl;
     // Share the non-critical publisher with sensor handler
@@ -108,6 +164,37 @@ int main() {
                 << std::endl; // LCOV_EXCL_LINE - Warning logging
     }
 
+    // Live speed for reverse gating, adaptive braking and the speed loop
+    auto speed_sensor = sensors["speed"];
+    if (speed_sensor) {
+      auto speed_data = speed_sensor->getSensorData()["speed"];
+      control_assembly->setSpeedDataAccessor(
+          [speed_data] { return speed_data; });
+      control_assembly->enableAdaptiveBraking();
+      if (closed_loop_speed) {
+        control_assembly->enableSpeedControl();
+      }
+    }
+
+    // Stops the car if the Controller or the autonomy stack goes silent
+    control_assembly->enableWatchdog();
+
+    if (lane_assist) {
+      control_assembly->enableLaneAssist();
+      lane_keeping_handler->setLaneCallback(
+          [control_assembly = control_assembly.get()](
+              const LaneKeepingData &data) {
+            control_assembly->handleLaneKeeping(data);
+          });
+    }
+
+    // One reactor thread receives for control, autonomous control, lane
+    // keeping and traffic signs instead of a polling thread each
+    Reactor input_reactor;
+    control_assembly->attachTo(input_reactor);
+    lane_keeping_handler->attachTo(input_reactor);
+    traffic_sign_handler->attachTo(input_reactor);
+
     // Start components
     std::cout << "Starting sensor handler..." << std::endl;
     sensor_handler->start();
@@ -121,13 +208,19 @@ int main() {
     std::cout << "Starting traffic sign handler..." << std::endl;
     traffic_sign_handler->start();
 
+    std::cout << "Starting input reactor..." << std::endl;
+    input_reactor.start();
+
     // Main loop
     std::cout << "System running. Press Ctrl+C to stop." << std::endl;
     while (!stop_flag) {
       std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
-    // Cleanup
+    // Cleanup - the reactor goes first, its handlers point at the components
+    std::cout << "Stopping input reactor..." << std::endl;
+    input_reactor.stop();
+
     std::cout << "Stopping sensor handler..." << std::endl;
     sensor_handler->stop();
 
@@ -147,9 +240,18 @@ int main() {
     lane_keeping_handler.reset();
     traffic_sign_handler.reset();
 
-    // Release publishers to ensure their sockets are closed
+    // Release publishers to ensure their sockets are closed; the policy
+    // flush thread sends through the tap, so it stops before the service
+    nc_publisher->stop();
+    snapshot_service->stop();
+    snapshot_service.reset();
+    c_tap.reset();
+    nc_tap.reset();
+    nc_async_publisher->stop();
     c_publisher.reset();
     nc_publisher.reset();
+    nc_async_publisher.reset();
+    nc_socket_publisher.reset();
 
     // Give a brief moment for all sockets to close cleanly
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include "ActuatorController.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "TestUtils.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records every driver call, the calling threads and whether two calls
+// ever overlapped on the "bus"
+class BusRecorder {
+public:
+    void enter(const std::string& call) {
+        if (busy.exchange(true)) {
+            overlapped = true;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+        calls.push_back(call);
+    }
+    void leave() { busy = false; }
+
+    std::vector<std::string> getCalls() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls;
+    }
+    size_t threadCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return threads.size();
+    }
+
+    std::atomic<bool> overlapped{false};
+
+private:
+    std::atomic<bool> busy{false};
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<std::string> calls;
+};
+
+class RecordingMotors : public MockBackMotors {
+public:
+    explicit RecordingMotors(BusRecorder& bus) : bus(bus) {}
+    void setSpeed(int speed) override {
+        bus.enter("speed:" + std::to_string(speed));
+        MockBackMotors::setSpeed(speed);
+        bus.leave();
+    }
+    void emergencyBrake() override {
+        bus.enter("brake");
+        MockBackMotors::emergencyBrake();
+        bus.leave();
+    }
+
+private:
+    BusRecorder& bus;
+};
+
+class RecordingServo : public MockFServo {
+public:
+    explicit RecordingServo(BusRecorder& bus) : bus(bus) {}
+    void set_steering(int angle) override {
+        bus.enter("steering:" + std::to_string(angle));
+        MockFServo::set_steering(angle);
+        bus.leave();
+    }
+
+private:
+    BusRecorder& bus;
+};
+
+} // namespace
+
+class ActuatorControllerTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        motors = std::make_shared<RecordingMotors>(bus);
+        servo = std::make_shared<RecordingServo>(bus);
+    }
+
+    void TearDown() override { restoreOutput(); }
+
+    BusRecorder bus;
+    std::shared_ptr<RecordingMotors> motors;
+    std::shared_ptr<RecordingServo> servo;
+};
+
+TEST_F(ActuatorControllerTest, ValidatesArguments) {
+    EXPECT_THROW(ActuatorController(nullptr, servo), std::invalid_argument);
+    EXPECT_THROW(ActuatorController(motors, nullptr), std::invalid_argument);
+    EXPECT_THROW(ActuatorController(motors, servo, 0ms), std::invalid_argument);
+}
+
+TEST_F(ActuatorControllerTest, AppliesOnCallerWhenStopped) {
+    ActuatorController actuators(motors, servo);
+    actuators.setThrottle(40);
+    actuators.setSteering(-15);
+    EXPECT_EQ(motors->getCurrentSpeed(), 40);
+    EXPECT_EQ(servo->getSteeringAngle(), -15);
+}
+
+TEST_F(ActuatorControllerTest, SkipsUnchangedSetpoints) {
+    ActuatorController actuators(motors, servo);
+    for (int i = 0; i < 5; ++i) {
+        actuators.setThrottle(30);
+        actuators.setSteering(10);
+    }
+    EXPECT_EQ(bus.getCalls(), (std::vector<std::string>{"speed:30", "steering:10"}));
+
+    auto stats = actuators.getStats();
+    EXPECT_EQ(stats.throttle_requests, 5u);
+    EXPECT_EQ(stats.throttle_writes, 1u);
+    EXPECT_EQ(stats.steering_writes, 1u);
+    EXPECT_EQ(stats.skipped, 8u);
+}
+
+TEST_F(ActuatorControllerTest, OwnerAppliesLatestSetpointAtFixedRate) {
+    ActuatorController actuators(motors, servo, 20ms);
+    actuators.start();
+    ASSERT_TRUE(waitForCondition([&] { return actuators.getStats().ticks >= 1; }, 1000, 1));
+
+    // A burst between two ticks collapses to its last value
+    for (int i = 1; i <= 100; ++i) {
+        actuators.setThrottle(i);
+    }
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCurrentSpeed() == 100; }, 1000, 1));
+    actuators.stop();
+
+    auto stats = actuators.getStats();
+    EXPECT_EQ(stats.throttle_requests, 100u);
+    EXPECT_LE(stats.throttle_writes, 3u);
+    EXPECT_EQ(bus.threadCount(), 1u);
+}
+
+TEST_F(ActuatorControllerTest, EmergencyBrakeJumpsTheQueue) {
+    ActuatorController actuators(motors, servo, 1000ms);
+    actuators.start();
+    ASSERT_TRUE(waitForCondition([&] { return actuators.getStats().ticks >= 1; }, 1000, 1));
+
+    // Pending until the next tick, a second away
+    actuators.setThrottle(80);
+    auto start = std::chrono::steady_clock::now();
+    actuators.emergencyBrake();
+    ASSERT_TRUE(waitForCondition([&] { return actuators.getStats().emergency_brakes == 1; },
+                                 500, 1));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+
+    // The throttle posted before the brake is never applied
+    EXPECT_EQ(bus.getCalls(), std::vector<std::string>{"brake"});
+
+    // A setpoint after the brake releases it, even one equal to the last
+    actuators.setThrottle(0);
+    actuators.stop();
+    EXPECT_EQ(bus.getCalls(), (std::vector<std::string>{"brake", "speed:0"}));
+}
+
+TEST_F(ActuatorControllerTest, ManyCallersOneBusThread) {
+    ActuatorController actuators(motors, servo, 1ms);
+    actuators.start();
+
+    constexpr int callers = 4;
+    constexpr int per_caller = 20000;
+    std::atomic<int64_t> total_ns{0};
+    std::vector<std::thread> threads;
+    for (int c = 0; c < callers; ++c) {
+        threads.emplace_back([&, c] {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < per_caller; ++i) {
+                if (c == 0 && i % 5000 == 0) {
+                    actuators.emergencyBrake();
+                }
+                actuators.setThrottle(i % 100);
+                actuators.setSteering(c * 10 + i % 3);
+            }
+            total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    actuators.stop();
+
+    EXPECT_FALSE(bus.overlapped.load());
+    EXPECT_EQ(bus.threadCount(), 1u);
+
+    double per_call_ns = static_cast<double>(total_ns.load()) / (callers * per_caller * 2);
+    auto stats = actuators.getStats();
+    EXPECT_EQ(stats.throttle_requests, static_cast<uint64_t>(callers * per_caller));
+    EXPECT_LT(stats.throttle_writes + stats.steering_writes, stats.throttle_requests);
+
+    restoreOutput();
+    std::cout << "Setpoint post: " << per_call_ns << " ns/call, "
+              << stats.throttle_writes + stats.steering_writes << " bus writes for "
+              << stats.throttle_requests + stats.steering_requests << " requests"
+              << std::endl;
+    suppressOutput();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
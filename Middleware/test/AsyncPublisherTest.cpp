@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "AsyncPublisher.hpp"
+#include "MockPublisher.hpp"
+#include "TestUtils.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Records which threads call send() and whether two calls ever overlap,
+// like a ZMQ socket used from several threads would
+class SocketLikePublisher : public IPublisher {
+public:
+    void send(const std::string& message) override {
+        if (inSend.exchange(true)) {
+            overlapped = true;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            messages.push_back(message);
+        }
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+        inSend = false;
+    }
+    using IPublisher::send;
+
+    std::vector<std::string> getMessages() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return messages;
+    }
+
+    size_t threadCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return threads.size();
+    }
+
+    std::atomic<bool> inSend{false};
+    std::atomic<bool> overlapped{false};
+    std::chrono::milliseconds delay{0};
+
+private:
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<std::string> messages;
+};
+
+TEST(AsyncPublisherTest, ValidatesArguments) {
+    EXPECT_THROW(AsyncPublisher(nullptr), std::invalid_argument);
+    auto inner = std::make_shared<MockPublisher>();
+    EXPECT_THROW(AsyncPublisher(inner, 0), std::invalid_argument);
+    EXPECT_THROW(AsyncPublisher(inner, 1000), std::invalid_argument);
+    EXPECT_EQ(AsyncPublisher(inner, 64).getCapacity(), 64u);
+}
+
+TEST(AsyncPublisherTest, QueuedBeforeStartIsPublishedInOrder) {
+    auto inner = std::make_shared<MockPublisher>();
+    AsyncPublisher publisher(inner, 16);
+
+    publisher.send("init;");
+    publisher.send(std::string("mode:0;"));
+    EXPECT_EQ(inner->messageCount(), 0u);
+
+    publisher.start();
+    ASSERT_TRUE(waitForCondition([&] { return inner->messageCount() == 2; },
+                                 1000, 5));
+    EXPECT_EQ(inner->getMessages(), (std::vector<std::string>{"init;", "mode:0;"}));
+    publisher.stop();
+}
+
+TEST(AsyncPublisherTest, DropsNewestWhenFull) {
+    auto inner = std::make_shared<MockPublisher>();
+    AsyncPublisher publisher(inner, 4);
+
+    for (int i = 0; i < 6; ++i) {
+        publisher.send("n:" + std::to_string(i) + ";");
+    }
+    auto stats = publisher.getStats();
+    EXPECT_EQ(stats.enqueued, 4u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.backpressure, 2u);
+
+    // stop() publishes what is still queued
+    publisher.stop();
+    EXPECT_EQ(inner->getMessages(),
+              (std::vector<std::string>{"n:0;", "n:1;", "n:2;", "n:3;"}));
+    EXPECT_EQ(publisher.getStats().sent, 4u);
+    EXPECT_EQ(publisher.getStats().max_depth, 4u);
+}
+
+TEST(AsyncPublisherTest, ManyProducersOneSocketThread) {
+    auto inner = std::make_shared<SocketLikePublisher>();
+    AsyncPublisher publisher(inner, 256, AsyncPublisher::OverflowPolicy::Block);
+    publisher.start();
+
+    constexpr int producers = 4;
+    constexpr int per_producer = 5000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&publisher, p] {
+            char buffer[32];
+            for (int i = 0; i < per_producer; ++i) {
+                int length = std::snprintf(buffer, sizeof(buffer), "%d:%d;", p, i);
+                publisher.send(std::string_view(buffer, length));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(waitForCondition([&] {
+        return publisher.getStats().sent == producers * per_producer;
+    }, 2000, 5));
+    publisher.stop();
+
+    auto messages = inner->getMessages();
+    ASSERT_EQ(messages.size(), static_cast<size_t>(producers * per_producer));
+    EXPECT_FALSE(inner->overlapped.load());
+    EXPECT_EQ(inner->threadCount(), 1u);
+
+    // Each producer's messages arrive in the order it sent them
+    std::map<int, int> next;
+    for (const auto& message : messages) {
+        int producer = std::stoi(message);
+        int index = std::stoi(message.substr(message.find(':') + 1));
+        EXPECT_EQ(index, next[producer]++);
+    }
+
+    auto stats = publisher.getStats();
+    EXPECT_EQ(stats.sent, stats.enqueued);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_LE(stats.max_depth, 256u);
+    EXPECT_LE(stats.batches, stats.sent);
+}
+
+TEST(AsyncPublisherTest, SlowSocketDoesNotBlockProducers) {
+    auto inner = std::make_shared<SocketLikePublisher>();
+    inner->delay = 20ms;
+    AsyncPublisher publisher(inner, 64);
+    publisher.start();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        publisher.send("mode:1;");
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 20ms);
+
+    publisher.stop();
+    EXPECT_EQ(inner->getMessages().size(), 10u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "ControlAssembly.hpp"
+#include "ControlFrame.hpp"
+#include "LatencyHistogram.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "TestUtils.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, BucketsAndPercentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.snapshot().percentileUs(50), 0u);
+
+    for (int i = 0; i < 90; ++i) {
+        histogram.record(800); // <= 1ms
+    }
+    for (int i = 0; i < 9; ++i) {
+        histogram.record(15000); // <= 20ms
+    }
+    histogram.record(1500000); // above 1s
+
+    LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 100u);
+    EXPECT_EQ(snapshot.buckets[0], 90u);
+    EXPECT_EQ(snapshot.buckets[4], 9u);
+    EXPECT_EQ(snapshot.buckets[LatencyHistogram::kBuckets - 1], 1u);
+    EXPECT_EQ(snapshot.max_us, 1500000u);
+    EXPECT_EQ(snapshot.avg_us, (90 * 800 + 9 * 15000 + 1500000) / 100u);
+    EXPECT_EQ(snapshot.percentileUs(50), 1000u);
+    EXPECT_EQ(snapshot.percentileUs(95), 20000u);
+    EXPECT_EQ(snapshot.percentileUs(100), 1500000u);
+    EXPECT_EQ(snapshot.toString(),
+              "<=1ms:90 <=2ms:0 <=5ms:0 <=10ms:0 <=20ms:9 <=50ms:0 <=100ms:0 "
+              "<=200ms:0 <=500ms:0 <=1s:0 >1s:1");
+
+    // Bounds are inclusive
+    histogram.reset();
+    histogram.record(1000);
+    histogram.record(1001);
+    snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.buckets[0], 1u);
+    EXPECT_EQ(snapshot.buckets[1], 1u);
+}
+
+class AutonomousLatencyTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        control.bind("inproc://autonomy-control");
+        autonomy.bind("inproc://autonomy-commands");
+        assembly = std::make_unique<ControlAssembly>("inproc://autonomy-control", context, motors,
+                                                     servo, nullptr, "inproc://autonomy-commands");
+        assembly->start();
+    }
+
+    void TearDown() override {
+        assembly->stop();
+        assembly.reset();
+        restoreOutput();
+    }
+
+    // PUB/SUB joins asynchronously; resend until `done`
+    template <typename Done>
+    bool resend(zmq::socket_t &socket, const std::string &message, Done done) {
+        return waitForCondition(
+            [&] {
+                socket.send(zmq::buffer(message), zmq::send_flags::none);
+                std::this_thread::sleep_for(5ms);
+                return done();
+            },
+            2000, 1);
+    }
+
+    static std::string command(int throttle, uint32_t sequence,
+                               std::chrono::milliseconds age = 0ms) {
+        uint64_t frame_ns = control_frame::nowNs() -
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(age).count();
+        return "throttle:" + std::to_string(throttle) + ";steering:0;frame_ts:" +
+               std::to_string(frame_ns) + ";seq:" + std::to_string(sequence) + ";";
+    }
+
+    zmq::context_t context{1};
+    zmq::socket_t control{context, zmq::socket_type::pub};
+    zmq::socket_t autonomy{context, zmq::socket_type::pub};
+    std::shared_ptr<MockBackMotors> motors = std::make_shared<MockBackMotors>();
+    std::shared_ptr<MockFServo> servo = std::make_shared<MockFServo>();
+    std::unique_ptr<ControlAssembly> assembly;
+};
+
+TEST_F(AutonomousLatencyTest, RecordsFrameToActuationLatency) {
+    ASSERT_TRUE(resend(control, "auto_mode:1;", [&] {
+        return assembly->getArbiterStats().transitions > 0;
+    }));
+
+    uint32_t sequence = 1;
+    ASSERT_TRUE(resend(autonomy, command(30, sequence++), [&] {
+        return motors->getCurrentSpeed() == 30;
+    }));
+    // Resent duplicates above count as stale; let the queued ones drain
+    std::this_thread::sleep_for(50ms);
+    const uint64_t stale = assembly->getAutonomousLinkStats().link.stale;
+    // 30 frames at about 33 Hz, as from the camera
+    for (int i = 0; i < 30; ++i) {
+        autonomy.send(zmq::buffer(command(30 + i % 2, sequence++)), zmq::send_flags::none);
+        std::this_thread::sleep_for(33ms);
+    }
+
+    ControlAssembly::AutonomousLinkStats stats = assembly->getAutonomousLinkStats();
+    EXPECT_GE(stats.actuation.count, 25u);
+    EXPECT_EQ(stats.too_old, 0u);
+    EXPECT_EQ(stats.link.stale, stale);
+    EXPECT_GE(stats.link.frames, 30u);
+    restoreOutput();
+    std::cout << "Frame to actuation: avg " << stats.actuation.avg_us << "us, p99 <= "
+              << stats.actuation.percentileUs(99) << "us, max " << stats.actuation.max_us
+              << "us (" << stats.actuation.toString() << ")" << std::endl;
+    suppressOutput();
+    // Receiver poll plus one actuator tick, 10ms each
+    if (!isRunningInCI()) {
+        EXPECT_LE(stats.actuation.percentileUs(99), 50000u);
+    }
+}
+
+TEST_F(AutonomousLatencyTest, RejectsOldAndReorderedCommands) {
+    EXPECT_THROW(assembly->setAutonomousMaxAge(-1ms), std::invalid_argument);
+    assembly->setAutonomousMaxAge(100ms);
+    ASSERT_TRUE(resend(control, "auto_mode:1;", [&] {
+        return assembly->getArbiterStats().transitions > 0;
+    }));
+    ASSERT_TRUE(resend(autonomy, command(40, 10), [&] {
+        return motors->getCurrentSpeed() == 40;
+    }));
+
+    // Computed from a frame captured 300ms ago
+    ASSERT_TRUE(resend(autonomy, command(90, 11, 300ms), [&] {
+        return assembly->getAutonomousLinkStats().too_old > 0;
+    }));
+    // Older than one already seen, from a frame captured before it
+    autonomy.send(zmq::buffer(command(70, 5, 400ms)), zmq::send_flags::none);
+    ASSERT_TRUE(waitForCondition(
+        [&] { return assembly->getAutonomousLinkStats().link.stale > 0; }, 1000, 1));
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(motors->getCurrentSpeed(), 40);
+
+    // Commands without a timestamp are still applied as they come
+    ASSERT_TRUE(resend(autonomy, "throttle:25;steering:0;", [&] {
+        return motors->getCurrentSpeed() == 25;
+    }));
+    EXPECT_GT(assembly->getAutonomousLinkStats().link.text_messages, 0u);
+
+    // 0 accepts any age
+    assembly->setAutonomousMaxAge(0ms);
+    ASSERT_TRUE(resend(autonomy, command(60, 20, 300ms), [&] {
+        return motors->getCurrentSpeed() == 60;
+    }));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
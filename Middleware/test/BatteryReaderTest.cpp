@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "BatteryReader.hpp"
+#include <chrono>
 #include <memory>
+#include <thread>
 
 class BatteryReaderTest : public ::testing::Test {
 protected:
@@ -120,6 +122,37 @@ TEST_F(BatteryReaderTest, ErrorHandling) {
     EXPECT_FLOAT_EQ(shunt, 0.0f); // Should specifically return 0.0f for negative values
 }
 
+TEST_F(BatteryReaderTest, GettersServedFromCachedSample) {
+    batteryReader->setTestAdcValue(0x02, 3000);
+    batteryReader->setTestAdcValue(0x01, 0);
+    batteryReader->setTestChargeValue(100);
+
+    uint32_t before = batteryReader->getTransactionCount();
+    for (int i = 0; i < 100; ++i) {
+        batteryReader->getPercentage();
+        batteryReader->isCharging();
+    }
+
+    // One sample (bus + shunt) instead of three round-trips per call pair
+    EXPECT_EQ(batteryReader->getTransactionCount() - before, 2u);
+    EXPECT_TRUE(batteryReader->isCharging());
+}
+
+TEST_F(BatteryReaderTest, SampleRefreshedAfterInterval) {
+    auto reader = std::make_unique<BatteryReader>(true, std::chrono::milliseconds(20));
+    reader->getVoltage();
+    auto first_sample = reader->getSampleTime();
+    uint32_t after_first = reader->getTransactionCount();
+
+    reader->getVoltage();
+    EXPECT_EQ(reader->getTransactionCount(), after_first);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    reader->getVoltage();
+    EXPECT_GT(reader->getTransactionCount(), after_first);
+    EXPECT_GT(reader->getSampleTime(), first_sample);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
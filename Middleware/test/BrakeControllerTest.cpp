@@ -0,0 +1,431 @@
+#include <gtest/gtest.h>
+#include "ActuatorController.hpp"
+#include "BrakeController.hpp"
+#include "ISensor.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "TestUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// The car with its H-bridge: driving follows a first-order motor model
+// (20 mm/s per percent above an 8% deadband, 300ms time constant), the
+// short brake (all channels high) is the same model at zero volts, and
+// throttle 0 coasts. Rolling friction 300 mm/s^2, traction limit 6000 mm/s^2.
+class BrakePlant {
+public:
+    enum class Mode { Drive, ShortBrake };
+
+    void step(Mode mode, double throttle, double dt_s) {
+        double motor = 0;
+        if (mode == Mode::ShortBrake) {
+            motor = -speed / 0.3;
+        } else if (throttle != 0) {
+            double magnitude = std::max(std::abs(throttle) - 8.0, 0.0);
+            motor = (20.0 * (throttle < 0 ? -magnitude : magnitude) - speed) / 0.3;
+        }
+        motor = std::max(-6000.0, std::min(6000.0, motor));
+
+        double friction = 300.0;
+        double accel = motor;
+        if (speed != 0) {
+            accel -= speed > 0 ? friction : -friction;
+        } else if (std::abs(motor) > friction) {
+            accel -= motor > 0 ? friction : -friction;
+        } else {
+            accel = 0;
+        }
+        double next = speed + accel * dt_s;
+        // Friction stops the car; it does not push it backwards
+        if (speed != 0 && (next > 0) != (speed > 0) && std::abs(motor) <= friction) {
+            next = 0;
+        }
+        speed = next;
+        position += speed * dt_s;
+        farthest = std::max(farthest, position);
+        history.push_back({std::abs(speed) * dt_s, dt_s});
+        history_time += dt_s;
+        while (history_time - history.front().second > kWindow_s - 1e-9) {
+            history_time -= history.front().second;
+            history.pop_front();
+        }
+        since_sample += dt_s;
+    }
+
+    // Speed sensor as sent by the Arduino: one frame every 50ms with the
+    // magnitude averaged over the last 200ms (Speed's longest window), 10 mm/s
+    // steps, no pulses below 30 mm/s. Returns true when a new reading is out.
+    bool sample() {
+        if (since_sample < kPeriod_s - 1e-9) {
+            return false;
+        }
+        double distance = 0;
+        for (const auto& entry : history) {
+            distance += entry.first;
+        }
+        double average = history_time > 0 ? distance / history_time : 0;
+        reading = average < 30 ? 0 : std::round(average / 10) * 10;
+        since_sample = 0;
+        return true;
+    }
+
+    // Standing or cruising at `mms` for a whole window
+    void settle(double mms) {
+        speed = mms;
+        reading = std::abs(mms);
+        history.assign(200, {std::abs(mms) * 0.001, 0.001});
+        history_time = kWindow_s;
+    }
+
+    static constexpr double kPeriod_s = 0.05;
+    static constexpr double kWindow_s = 0.2;
+
+    double speed = 0;    // signed mm/s
+    double position = 0; // mm, from the brake point
+    double farthest = 0;
+    double reading = 0;
+
+private:
+    std::deque<std::pair<double, double>> history; // distance, duration
+    double history_time = 0;
+    double since_sample = 0;
+};
+
+struct Outcome {
+    double farthest_mm;
+    double backwards_mm; // travelled back from the farthest point
+    double stop_ms;      // until the car stands, -1 if it never does
+};
+
+// One strategy decides the bridge state every `tick_ms` from the latest
+// reading
+using Strategy = std::function<void(double reading, BrakePlant::Mode& mode, double& throttle)>;
+
+Outcome simulate(double initial_mms, const Strategy& strategy, int tick_ms = 2) {
+    BrakePlant plant;
+    plant.settle(initial_mms);
+    BrakePlant::Mode mode = BrakePlant::Mode::Drive;
+    double throttle = 0;
+    double stop_ms = -1;
+    for (int ms = 0; ms < 3000; ++ms) {
+        if (ms % tick_ms == 0) {
+            strategy(plant.reading, mode, throttle);
+        }
+        plant.step(mode, throttle, 0.001);
+        plant.sample();
+        if (stop_ms < 0 && plant.speed == 0) {
+            stop_ms = ms + 1;
+        }
+    }
+    return {plant.farthest, plant.farthest - plant.position, stop_ms};
+}
+
+Strategy lockWheels() {
+    return [](double, BrakePlant::Mode& mode, double&) { mode = BrakePlant::Mode::ShortBrake; };
+}
+
+// The commented-out draft: full reverse while the sensor reports motion
+Strategy reverseUntilZero() {
+    auto done = std::make_shared<bool>(false);
+    return [done](double reading, BrakePlant::Mode& mode, double& throttle) {
+        mode = BrakePlant::Mode::Drive;
+        *done = *done || reading <= 10;
+        throttle = *done ? 0 : -100;
+    };
+}
+
+Strategy adaptive(double initial_mms, int tick_ms = 2) {
+    auto controller = std::make_shared<BrakeController>();
+    auto started = std::make_shared<bool>(false);
+    return [controller, started, initial_mms, tick_ms](double reading, BrakePlant::Mode& mode,
+                                                       double& throttle) {
+        BrakeController::Command command = *started
+                                               ? controller->update(reading, tick_ms / 1000.0)
+                                               : controller->begin(1, initial_mms);
+        *started = true;
+        mode = command.hold ? BrakePlant::Mode::ShortBrake : BrakePlant::Mode::Drive;
+        throttle = command.throttle;
+    };
+}
+
+// Motors on a plant simulated in real time, reporting the speed reading and
+// the calls the actuator owner made
+class PlantMotors : public MockBackMotors {
+public:
+    PlantMotors() : speed_data(std::make_shared<SensorData>("speed", true)) {}
+    ~PlantMotors() override { stopPlant(); }
+
+    void setSpeed(int speed) override {
+        MockBackMotors::setSpeed(speed);
+        std::lock_guard<std::mutex> lock(mutex);
+        mode = BrakePlant::Mode::Drive;
+        throttle = speed;
+        calls.push_back("speed:" + std::to_string(speed));
+    }
+    void emergencyBrake() override {
+        MockBackMotors::emergencyBrake();
+        std::lock_guard<std::mutex> lock(mutex);
+        mode = BrakePlant::Mode::ShortBrake;
+        calls.push_back("brake");
+    }
+
+    void startPlant() {
+        running = true;
+        plant_thread = std::thread([this] {
+            while (running) {
+                std::this_thread::sleep_for(1ms);
+                std::lock_guard<std::mutex> lock(mutex);
+                plant.step(mode, throttle, 0.001);
+                if (plant.sample()) {
+                    speed_data->value = static_cast<unsigned int>(plant.reading);
+                }
+            }
+        });
+    }
+    void stopPlant() {
+        running = false;
+        if (plant_thread.joinable()) {
+            plant_thread.join();
+        }
+    }
+
+    std::vector<std::string> getCalls() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls;
+    }
+    double speed() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return plant.speed;
+    }
+
+    std::shared_ptr<SensorData> speed_data;
+
+private:
+    std::mutex mutex;
+    BrakePlant plant;
+    BrakePlant::Mode mode = BrakePlant::Mode::Drive;
+    double throttle = 0;
+    std::vector<std::string> calls;
+    std::atomic<bool> running{false};
+    std::thread plant_thread;
+};
+
+} // namespace
+
+TEST(BrakeControllerTest, CounterTorqueThenHold) {
+    BrakeController controller;
+    auto command = controller.begin(1, 1500);
+    EXPECT_FALSE(command.hold);
+    EXPECT_EQ(command.throttle, -100);
+    EXPECT_TRUE(controller.isActive());
+
+    // Reverse travel gets forward counter-torque
+    BrakeController reversing;
+    EXPECT_EQ(reversing.begin(-1, 800).throttle, 100);
+
+    // Readings every 50ms, predicted 150ms ahead (half the 200ms window
+    // plus one period): 1400 -> 1100, 1100 -> 200, 800 -> -100 (hold)
+    EXPECT_DOUBLE_EQ(controller.getConfig().lookahead(), 0.15);
+    EXPECT_FALSE(controller.update(1400, 0.05).hold);
+    EXPECT_FALSE(controller.update(1100, 0.05).hold);
+    EXPECT_TRUE(controller.update(800, 0.05).hold);
+    // Once holding, never back to counter-torque
+    EXPECT_TRUE(controller.update(900, 0.05).hold);
+    EXPECT_TRUE(controller.isActive());
+    EXPECT_TRUE(controller.update(0, 0.05).hold);
+
+    EXPECT_FALSE(controller.isActive());
+    const auto& result = controller.getResult();
+    EXPECT_TRUE(result.stopped);
+    EXPECT_DOUBLE_EQ(result.initial_speed_mms, 1500);
+    EXPECT_NEAR(result.time_ms, 250, 1e-6);
+    EXPECT_NEAR(result.reverse_ms, 150, 1e-6);
+    EXPECT_NEAR(result.distance_mm, (1400 + 1100 + 800 + 900) * 0.05, 1e-6);
+}
+
+TEST(BrakeControllerTest, RisingReadingHoldsAtOnce) {
+    BrakeController::Config config;
+    config.averaging_window_s = 0; // short lookahead: 50ms
+    BrakeController controller(config);
+    controller.begin(1, 1500);
+    // Measured before the brake took hold: still accelerating
+    EXPECT_FALSE(controller.update(1550, 0.05).hold);
+    EXPECT_FALSE(controller.update(1450, 0.05).hold);
+    EXPECT_FALSE(controller.update(1400, 0.05).hold);
+    // Under counter-torque only driving backwards makes the magnitude rise
+    EXPECT_TRUE(controller.update(1420, 0.05).hold);
+    EXPECT_NEAR(controller.getResult().reverse_ms, 200, 1e-6);
+}
+
+TEST(BrakeControllerTest, ReverseTimeIsBounded) {
+    // 650 mm/s stops in no less than 100ms at 6500 mm/s^2. The readings
+    // never change here, as when the sensor frames stop.
+    BrakeController controller;
+    EXPECT_FALSE(controller.begin(-1, 650).hold);
+    EXPECT_FALSE(controller.update(650, 0.03).hold);
+    EXPECT_FALSE(controller.update(650, 0.03).hold);
+    // Another 30ms tick would overrun the bound
+    EXPECT_TRUE(controller.update(650, 0.03).hold);
+    EXPECT_NEAR(controller.getResult().reverse_ms, 90, 1e-6);
+}
+
+TEST(BrakeControllerTest, HoldsWithoutDirectionAndTimesOut) {
+    BrakeController::Config config;
+    config.timeout_s = 0.1;
+    BrakeController controller(config);
+    EXPECT_TRUE(controller.begin(0, 900).hold);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(controller.update(900, 0.02).hold);
+    }
+    EXPECT_TRUE(controller.isActive());
+    controller.update(900, 0.02);
+    EXPECT_TRUE(controller.isFinished());
+    EXPECT_FALSE(controller.getResult().stopped);
+
+    // Standing already: nothing to measure
+    controller.begin(1, 0);
+    EXPECT_TRUE(controller.isFinished());
+    EXPECT_TRUE(controller.getResult().stopped);
+
+    config = BrakeController::Config();
+    config.max_reverse = 150;
+    EXPECT_THROW(BrakeController{config}, std::invalid_argument);
+    config = BrakeController::Config();
+    config.max_decel_mms2 = 0;
+    EXPECT_THROW(BrakeController{config}, std::invalid_argument);
+}
+
+TEST(BrakeControllerTest, StrategiesFromTheBrakePoint) {
+    std::cout << std::fixed << std::setprecision(0)
+              << "Stopping distance / time (backwards travel):" << std::endl;
+    for (double initial : {500.0, 1000.0, 1500.0}) {
+        Outcome lock = simulate(initial, lockWheels());
+        Outcome reverse = simulate(initial, reverseUntilZero());
+        Outcome adapt = simulate(initial, adaptive(initial));
+
+        // The draft reverses through zero between two readings: the
+        // magnitude-only sensor never reads zero and the car drives back
+        EXPECT_GT(reverse.backwards_mm, 100);
+        EXPECT_LT(adapt.backwards_mm, 1);
+        EXPECT_GT(adapt.stop_ms, 0);
+        EXPECT_LT(adapt.farthest_mm, lock.farthest_mm * 0.7);
+        EXPECT_LT(adapt.stop_ms, lock.stop_ms);
+
+        std::cout << "  " << initial << " mm/s: lock " << lock.farthest_mm << " mm / "
+                  << lock.stop_ms << " ms, reverse-until-zero " << reverse.farthest_mm
+                  << " mm (" << reverse.backwards_mm << " mm back), adaptive "
+                  << adapt.farthest_mm << " mm / " << adapt.stop_ms << " ms ("
+                  << adapt.backwards_mm << " mm back)" << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+
+    // At 1 m/s the 20 cm emergency threshold is enough with counter-torque
+    EXPECT_LT(simulate(1000, adaptive(1000)).farthest_mm, 200);
+}
+
+TEST(BrakeControllerTest, NeverDrivesBackwards) {
+    // Whatever the speed, and with the 2ms brake tick or the 10ms actuator
+    // tick, the short brake takes over before the wheels turn back
+    for (int tick_ms : {2, 10}) {
+        for (double initial = 100; initial <= 2500; initial += 50) {
+            Outcome adapt = simulate(initial, adaptive(initial, tick_ms), tick_ms);
+            EXPECT_DOUBLE_EQ(adapt.backwards_mm, 0) << initial << " mm/s, " << tick_ms << "ms tick";
+            EXPECT_GT(adapt.stop_ms, 0) << initial << " mm/s, " << tick_ms << "ms tick";
+        }
+    }
+}
+
+class AdaptiveBrakeTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        motors = std::make_shared<PlantMotors>();
+        servo = std::make_shared<MockFServo>();
+        motors->startPlant();
+    }
+
+    void TearDown() override {
+        motors->stopPlant();
+        restoreOutput();
+    }
+
+    std::shared_ptr<PlantMotors> motors;
+    std::shared_ptr<MockFServo> servo;
+};
+
+TEST_F(AdaptiveBrakeTest, OwnerStopsTheCarAndLogsTheStop) {
+    ActuatorController actuators(motors, servo, 10ms);
+    auto speed_data = motors->speed_data;
+    actuators.enableAdaptiveBraking(
+        [speed_data] { return static_cast<double>(speed_data->value.load()); });
+    actuators.start();
+
+    actuators.setThrottle(60);
+    ASSERT_TRUE(waitForCondition([&] { return speed_data->value.load() > 900; }, 3000, 5));
+    actuators.emergencyBrake();
+    ASSERT_TRUE(waitForCondition([&] { return actuators.getStats().emergency_brakes == 1; },
+                                 1000, 1));
+    actuators.emergencyBrake(); // repeated while stopping: same stop
+    ASSERT_TRUE(waitForCondition([&] { return actuators.getBrakeStats().stops == 1; }, 3000, 2));
+    // The sensor reads zero below 30 mm/s; the short brake does the rest
+    EXPECT_TRUE(waitForCondition([&] { return motors->speed() == 0; }, 1000, 5));
+
+    auto stats = actuators.getBrakeStats();
+    EXPECT_EQ(stats.timeouts, 0u);
+    EXPECT_GT(stats.last.initial_speed_mms, 900);
+    EXPECT_GT(stats.last.reverse_ms, 0);
+    EXPECT_GT(stats.last.distance_mm, 0);
+    EXPECT_EQ(actuators.getStats().emergency_brakes, 2u);
+
+    // Counter-torque first, then one short brake to hold
+    auto calls = motors->getCalls();
+    auto reverse = std::find(calls.begin(), calls.end(), "speed:-100");
+    ASSERT_NE(reverse, calls.end());
+    EXPECT_EQ(std::count(reverse, calls.end(), "brake"), 1);
+    EXPECT_EQ(calls.back(), "brake");
+
+    // The next throttle releases the hold
+    actuators.setThrottle(0);
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCalls().back() == "speed:0"; }, 1000, 2));
+    actuators.stop();
+
+    restoreOutput();
+    std::cout << "Owner-thread stop from " << stats.last.initial_speed_mms << " mm/s: "
+              << stats.last.distance_mm << " mm in " << stats.last.time_ms << " ms"
+              << std::endl;
+    suppressOutput();
+}
+
+TEST_F(AdaptiveBrakeTest, WithoutDirectionItLocksTheWheels) {
+    ActuatorController actuators(motors, servo, 10ms);
+    actuators.enableAdaptiveBraking([] { return 0.0; });
+    actuators.emergencyBrake();
+
+    EXPECT_EQ(motors->getCalls(), std::vector<std::string>{"brake"});
+    auto stats = actuators.getBrakeStats();
+    EXPECT_EQ(stats.stops, 1u);
+    EXPECT_DOUBLE_EQ(stats.last.distance_mm, 0);
+    EXPECT_THROW(actuators.enableAdaptiveBraking(nullptr), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
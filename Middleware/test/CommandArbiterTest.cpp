@@ -0,0 +1,365 @@
+#include <gtest/gtest.h>
+#include "CommandArbiter.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+using Source = CommandArbiter::Source;
+using Action = CommandArbiter::Action;
+using Command = CommandArbiter::Command;
+using Decision = CommandArbiter::Decision;
+
+namespace {
+
+// Test clock: milliseconds as steady-clock nanoseconds
+int64_t at(int64_t ms) { return ms * 1000000; }
+
+Command drive(int throttle, int steering) {
+    Command command;
+    command.has_throttle = true;
+    command.throttle = throttle;
+    command.has_steering = true;
+    command.steering = steering;
+    return command;
+}
+
+Command throttleOnly(int throttle) {
+    Command command;
+    command.has_throttle = true;
+    command.throttle = throttle;
+    return command;
+}
+
+void expectThrottle(const Decision &decision, Action action, int value, bool changed) {
+    EXPECT_EQ(decision.throttle.action, action);
+    if (action == Action::Set) {
+        EXPECT_EQ(decision.throttle.value, value);
+    }
+    EXPECT_EQ(decision.throttle.changed, changed);
+}
+
+} // namespace
+
+TEST(CommandArbiterTest, ManualDrivesByDefault) {
+    CommandArbiter arbiter;
+    Decision decision = arbiter.arbitrate(at(1), 0);
+    EXPECT_EQ(decision.authority, Source::Manual);
+    expectThrottle(decision, Action::Hold, 0, false);
+    EXPECT_EQ(decision.steering.action, Action::Hold);
+
+    arbiter.submit(Source::Manual, drive(40, -10), at(2));
+    decision = arbiter.arbitrate(at(3), 0);
+    expectThrottle(decision, Action::Set, 40, true);
+    EXPECT_EQ(decision.steering.action, Action::Set);
+    EXPECT_EQ(decision.steering.value, -10);
+    EXPECT_TRUE(decision.steering.changed);
+
+    // Nothing new: the same level, nothing to write
+    decision = arbiter.arbitrate(at(4), 0);
+    expectThrottle(decision, Action::Set, 40, false);
+    EXPECT_FALSE(decision.steering.changed);
+
+    // Throttle-only commands keep the last steering
+    arbiter.submit(Source::Manual, throttleOnly(55), at(5));
+    decision = arbiter.arbitrate(at(6), 0);
+    expectThrottle(decision, Action::Set, 55, true);
+    EXPECT_EQ(decision.steering.value, -10);
+    EXPECT_FALSE(decision.steering.changed);
+}
+
+TEST(CommandArbiterTest, AutoModeSwitchesAuthority) {
+    CommandArbiter arbiter;
+    arbiter.submit(Source::Manual, drive(25, 5), at(1));
+    // Sent before AUTO mode: never applied
+    arbiter.submit(Source::Autonomous, drive(80, 30), at(2));
+    expectThrottle(arbiter.arbitrate(at(3), 0), Action::Set, 25, true);
+
+    EXPECT_FALSE(arbiter.engage(Source::Autonomous, true, at(4)));
+    Decision decision = arbiter.arbitrate(at(5), 0);
+    EXPECT_EQ(decision.authority, Source::Autonomous);
+    expectThrottle(decision, Action::Hold, 0, false);
+    EXPECT_EQ(decision.steering.action, Action::Hold);
+
+    // Manual input is ignored in AUTO mode
+    arbiter.submit(Source::Manual, drive(-50, 0), at(6));
+    expectThrottle(arbiter.arbitrate(at(7), 0), Action::Hold, 0, false);
+
+    arbiter.submit(Source::Autonomous, drive(30, 12), at(8));
+    decision = arbiter.arbitrate(at(9), 0);
+    expectThrottle(decision, Action::Set, 30, true);
+    EXPECT_EQ(decision.steering.value, 12);
+
+    // Back to manual: holds until the driver sends something new
+    EXPECT_TRUE(arbiter.engage(Source::Autonomous, false, at(10)));
+    decision = arbiter.arbitrate(at(11), 0);
+    EXPECT_EQ(decision.authority, Source::Manual);
+    expectThrottle(decision, Action::Hold, 0, false);
+    arbiter.submit(Source::Manual, drive(20, 0), at(12));
+    decision = arbiter.arbitrate(at(13), 0);
+    expectThrottle(decision, Action::Set, 20, true);
+    EXPECT_TRUE(decision.steering.changed);
+
+    EXPECT_EQ(arbiter.getStats().transitions, 2u);
+}
+
+TEST(CommandArbiterTest, EmergencyBrakesOverEverything) {
+    CommandArbiter arbiter;
+    arbiter.submit(Source::Manual, drive(60, 0), at(1));
+    expectThrottle(arbiter.arbitrate(at(2), 0), Action::Set, 60, true);
+
+    EXPECT_FALSE(arbiter.engage(Source::Emergency, true, at(3)));
+    EXPECT_TRUE(arbiter.isEngaged(Source::Emergency));
+    Decision decision = arbiter.arbitrate(at(4), 500);
+    EXPECT_EQ(decision.authority, Source::Emergency);
+    expectThrottle(decision, Action::Brake, 0, true);
+
+    // Forward throttle keeps braking without braking again
+    arbiter.submit(Source::Manual, drive(70, 15), at(5));
+    decision = arbiter.arbitrate(at(6), 300);
+    expectThrottle(decision, Action::Brake, 0, false);
+    // Steering is never blocked
+    EXPECT_EQ(decision.steering.value, 15);
+    EXPECT_TRUE(decision.steering.changed);
+
+    // Reverse while still moving: keep braking
+    arbiter.submit(Source::Manual, throttleOnly(-30), at(7));
+    expectThrottle(arbiter.arbitrate(at(8), 100), Action::Brake, 0, false);
+
+    EXPECT_EQ(arbiter.getStats().brakes, 1u);
+}
+
+TEST(CommandArbiterTest, ReverseBacksAwayOnceStopped) {
+    CommandArbiter arbiter;
+    // Reverse requested before the brake does not count
+    arbiter.submit(Source::Manual, throttleOnly(-20), at(1));
+    arbiter.engage(Source::Emergency, true, at(2));
+    expectThrottle(arbiter.arbitrate(at(3), 0), Action::Brake, 0, true);
+
+    arbiter.submit(Source::Manual, throttleOnly(-30), at(4));
+    Decision decision = arbiter.arbitrate(at(5), 0);
+    EXPECT_EQ(decision.authority, Source::Emergency);
+    expectThrottle(decision, Action::Set, -30, true);
+
+    // Moving backwards away from the obstacle keeps the reverse
+    arbiter.submit(Source::Manual, throttleOnly(-40), at(6));
+    expectThrottle(arbiter.arbitrate(at(7), 200), Action::Set, -40, true);
+
+    // Forward again: brake
+    arbiter.submit(Source::Manual, throttleOnly(10), at(8));
+    expectThrottle(arbiter.arbitrate(at(9), 200), Action::Brake, 0, true);
+    // and reverse needs a standstill again
+    arbiter.submit(Source::Manual, throttleOnly(-30), at(10));
+    expectThrottle(arbiter.arbitrate(at(11), 150), Action::Brake, 0, false);
+    expectThrottle(arbiter.arbitrate(at(12), 0), Action::Set, -30, true);
+}
+
+TEST(CommandArbiterTest, AutonomousNeverReversesDuringEmergency) {
+    CommandArbiter arbiter;
+    arbiter.engage(Source::Autonomous, true, at(1));
+    arbiter.engage(Source::Emergency, true, at(2));
+    arbiter.submit(Source::Autonomous, drive(-30, 0), at(3));
+    expectThrottle(arbiter.arbitrate(at(4), 0), Action::Brake, 0, true);
+}
+
+TEST(CommandArbiterTest, ReleasedBrakeStopsUntilNewCommand) {
+    CommandArbiter arbiter;
+    arbiter.engage(Source::Emergency, true, at(1));
+    arbiter.submit(Source::Manual, drive(50, 0), at(2));
+    expectThrottle(arbiter.arbitrate(at(3), 0), Action::Brake, 0, true);
+
+    EXPECT_TRUE(arbiter.engage(Source::Emergency, false, at(4)));
+    // Repeated releases do not move the barrier
+    EXPECT_FALSE(arbiter.engage(Source::Emergency, false, at(6)));
+    Decision decision = arbiter.arbitrate(at(5), 0);
+    EXPECT_EQ(decision.authority, Source::Manual);
+    expectThrottle(decision, Action::Set, 0, true);
+    expectThrottle(arbiter.arbitrate(at(6), 0), Action::Set, 0, false);
+
+    arbiter.submit(Source::Manual, throttleOnly(35), at(7));
+    expectThrottle(arbiter.arbitrate(at(8), 0), Action::Set, 35, true);
+}
+
+TEST(CommandArbiterTest, WatchdogStopsBelowEmergency) {
+    CommandArbiter arbiter;
+    arbiter.submit(Source::Manual, drive(45, 8), at(1));
+    expectThrottle(arbiter.arbitrate(at(2), 0), Action::Set, 45, true);
+
+    arbiter.engage(Source::Watchdog, true, at(3));
+    Decision decision = arbiter.arbitrate(at(4), 0);
+    EXPECT_EQ(decision.authority, Source::Watchdog);
+    expectThrottle(decision, Action::Set, 0, true);
+    // Centred
+    EXPECT_EQ(decision.steering.value, 0);
+    EXPECT_TRUE(decision.steering.changed);
+
+    arbiter.submit(Source::Manual, drive(45, 8), at(5));
+    expectThrottle(arbiter.arbitrate(at(6), 0), Action::Set, 0, false);
+
+    // Emergency outranks the watchdog, and hands back to it
+    arbiter.engage(Source::Emergency, true, at(7));
+    EXPECT_EQ(arbiter.arbitrate(at(8), 0).authority, Source::Emergency);
+    arbiter.engage(Source::Emergency, false, at(9));
+    decision = arbiter.arbitrate(at(10), 0);
+    EXPECT_EQ(decision.authority, Source::Watchdog);
+    expectThrottle(decision, Action::Set, 0, true);
+
+    // Released: commands from before the release stay ignored
+    arbiter.engage(Source::Watchdog, false, at(11));
+    decision = arbiter.arbitrate(at(12), 0);
+    EXPECT_EQ(decision.authority, Source::Manual);
+    expectThrottle(decision, Action::Set, 0, false);
+    arbiter.submit(Source::Manual, throttleOnly(20), at(13));
+    expectThrottle(arbiter.arbitrate(at(14), 0), Action::Set, 20, true);
+}
+
+TEST(CommandArbiterTest, WatchdogRampsThrottleDown) {
+    CommandArbiter arbiter;
+    arbiter.setWatchdogRamp(std::chrono::milliseconds(500));
+    arbiter.submit(Source::Manual, drive(-80, 20), at(1));
+    expectThrottle(arbiter.arbitrate(at(2), 0), Action::Set, -80, true);
+
+    arbiter.engage(Source::Watchdog, true, at(100));
+    expectThrottle(arbiter.arbitrate(at(100), 0), Action::Set, -80, false);
+    expectThrottle(arbiter.arbitrate(at(225), 0), Action::Set, -60, true);
+    expectThrottle(arbiter.arbitrate(at(350), 0), Action::Set, -40, true);
+    expectThrottle(arbiter.arbitrate(at(599), 0), Action::Set, 0, true);
+    expectThrottle(arbiter.arbitrate(at(700), 0), Action::Set, 0, false);
+
+    // A brake during the ramp wins and ends it
+    arbiter.engage(Source::Watchdog, false, at(710));
+    arbiter.submit(Source::Manual, throttleOnly(60), at(720));
+    expectThrottle(arbiter.arbitrate(at(721), 0), Action::Set, 60, true);
+    arbiter.engage(Source::Watchdog, true, at(800));
+    expectThrottle(arbiter.arbitrate(at(925), 0), Action::Set, 45, true);
+    arbiter.engage(Source::Emergency, true, at(930));
+    expectThrottle(arbiter.arbitrate(at(931), 0), Action::Brake, 0, true);
+    arbiter.engage(Source::Emergency, false, at(940));
+    expectThrottle(arbiter.arbitrate(at(941), 0), Action::Set, 0, true);
+}
+
+TEST(CommandArbiterTest, StaleAuthorityStops) {
+    CommandArbiter arbiter;
+    arbiter.setMaxAge(Source::Autonomous, std::chrono::milliseconds(100));
+    arbiter.engage(Source::Autonomous, true, at(1));
+    arbiter.submit(Source::Autonomous, drive(30, 4), at(10));
+    expectThrottle(arbiter.arbitrate(at(110), 0), Action::Set, 30, true);
+
+    Decision decision = arbiter.arbitrate(at(111), 0);
+    EXPECT_TRUE(decision.stale);
+    expectThrottle(decision, Action::Set, 0, true);
+    EXPECT_EQ(decision.steering.value, 4);
+
+    arbiter.submit(Source::Autonomous, throttleOnly(30), at(120));
+    decision = arbiter.arbitrate(at(121), 0);
+    EXPECT_FALSE(decision.stale);
+    expectThrottle(decision, Action::Set, 30, true);
+    EXPECT_EQ(arbiter.getStats().stale, 1u);
+
+    // Manual has no limit by default
+    arbiter.engage(Source::Autonomous, false, at(130));
+    arbiter.submit(Source::Manual, throttleOnly(15), at(140));
+    expectThrottle(arbiter.arbitrate(at(100000), 0), Action::Set, 15, true);
+}
+
+TEST(CommandArbiterTest, SteeringAssistBlendsIntoAuthority) {
+    CommandArbiter arbiter;
+    EXPECT_THROW(arbiter.setSteeringLimit(0), std::invalid_argument);
+    EXPECT_THROW(arbiter.assist(91, at(1)), std::invalid_argument);
+    arbiter.setSteeringLimit(45);
+    arbiter.setAssistMaxAge(std::chrono::milliseconds(100));
+
+    // Before any steering command the assist steers from the centre
+    EXPECT_TRUE(arbiter.assist(-8, at(1)));
+    Decision decision = arbiter.arbitrate(at(2), 0);
+    EXPECT_EQ(decision.assist, -8);
+    EXPECT_EQ(decision.steering.value, -8);
+    EXPECT_TRUE(decision.steering.changed);
+
+    arbiter.submit(Source::Manual, drive(30, 10), at(3));
+    decision = arbiter.arbitrate(at(4), 0);
+    EXPECT_EQ(decision.steering.value, 2);
+    EXPECT_FALSE(arbiter.assist(-8, at(5)));
+
+    // Clamped to the limit
+    arbiter.submit(Source::Manual, drive(30, -40), at(6));
+    EXPECT_EQ(arbiter.arbitrate(at(7), 0).steering.value, -45);
+
+    // Back in the lane: the authority's steering again, without a new command
+    EXPECT_TRUE(arbiter.assist(0, at(8)));
+    decision = arbiter.arbitrate(at(9), 0);
+    EXPECT_EQ(decision.steering.value, -40);
+    EXPECT_TRUE(decision.steering.changed);
+    EXPECT_FALSE(arbiter.arbitrate(at(10), 0).steering.changed);
+
+    // An assist without lane messages lapses
+    arbiter.assist(12, at(20));
+    EXPECT_EQ(arbiter.arbitrate(at(100), 0).steering.value, -28);
+    decision = arbiter.arbitrate(at(121), 0);
+    EXPECT_EQ(decision.assist, 0);
+    EXPECT_EQ(decision.steering.value, -40);
+    EXPECT_TRUE(arbiter.assist(12, at(130)));
+
+    // The watchdog centres regardless
+    arbiter.engage(Source::Watchdog, true, at(140));
+    decision = arbiter.arbitrate(at(141), 0);
+    EXPECT_EQ(decision.assist, 0);
+    EXPECT_EQ(decision.steering.value, 0);
+    arbiter.engage(Source::Watchdog, false, at(150));
+    EXPECT_EQ(arbiter.arbitrate(at(151), 0).steering.value, 12);
+    EXPECT_EQ(arbiter.getStats().assisted, 5u);
+}
+
+TEST(CommandArbiterTest, SteeringAssistAfterLongUptime) {
+    // Past 2^55 ns (about 417 days) the time no longer fits beside the
+    // correction in one word
+    const int64_t uptime = int64_t(500) * 24 * 3600 * 1000000000;
+    CommandArbiter arbiter;
+    arbiter.setAssistMaxAge(std::chrono::milliseconds(100));
+
+    EXPECT_TRUE(arbiter.assist(-8, uptime + at(1)));
+    EXPECT_EQ(arbiter.arbitrate(uptime + at(2), 0).assist, -8);
+    EXPECT_FALSE(arbiter.assist(-8, uptime + at(3)));
+    EXPECT_EQ(arbiter.arbitrate(uptime + at(200), 0).assist, 0);
+}
+
+TEST(CommandArbiterTest, ManualCannotBeEngaged) {
+    CommandArbiter arbiter;
+    EXPECT_THROW(arbiter.engage(Source::Manual, true, at(1)), std::invalid_argument);
+    EXPECT_FALSE(arbiter.isEngaged(Source::Watchdog));
+}
+
+// One writer per slot, arbiter on its own thread: every snapshot pairs the
+// throttle and steering of one command
+TEST(CommandArbiterTest, SlotsReadConsistentlyUnderConcurrentWrites) {
+    CommandArbiter arbiter;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 1; i <= 200000; ++i) {
+            arbiter.submit(Source::Manual, drive(i, -i), at(i));
+        }
+        done = true;
+    });
+
+    int checked = 0;
+    int last = 0;
+    while (!done || checked == 0) {
+        Decision decision = arbiter.arbitrate(at(1000000), 0);
+        if (decision.throttle.action == Action::Set) {
+            ASSERT_EQ(decision.steering.value, -decision.throttle.value);
+            ASSERT_GE(decision.throttle.value, last);
+            last = decision.throttle.value;
+            ++checked;
+        }
+    }
+    writer.join();
+    expectThrottle(arbiter.arbitrate(at(1000001), 0), Action::Set, 200000,
+                   last != 200000);
+    EXPECT_GT(checked, 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include "ControlAssembly.hpp"
+#include "ControlFrame.hpp"
+#include "ControlLinkMonitor.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "TestUtils.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+using Verdict = ControlLinkMonitor::Verdict;
+
+namespace {
+
+std::string encodeFrame(const control_frame::Frame& frame) {
+    uint8_t buffer[control_frame::kFrameSize];
+    size_t size = control_frame::encode(frame, buffer, sizeof(buffer));
+    return std::string(reinterpret_cast<const char*>(buffer), size);
+}
+
+control_frame::Frame driveFrame(uint32_t sequence, float throttle, float steering) {
+    control_frame::Frame frame;
+    frame.flags = control_frame::kHasThrottle | control_frame::kHasSteering;
+    frame.sequence = sequence;
+    frame.timestamp_ns = control_frame::nowNs();
+    frame.throttle = throttle;
+    frame.steering = steering;
+    return frame;
+}
+
+} // namespace
+
+TEST(ControlFrameTest, RoundTrip) {
+    control_frame::Frame frame = driveFrame(0xDEADBEEF, -42.5f, 30.0f);
+    frame.flags |= control_frame::kHasAutoMode | control_frame::kAutoMode;
+    frame.timestamp_ns = 0x0123456789ABCDEFull;
+
+    std::string data = encodeFrame(frame);
+    ASSERT_EQ(data.size(), control_frame::kFrameSize);
+    EXPECT_EQ(static_cast<uint8_t>(data[0]), control_frame::kMagic);
+
+    control_frame::Frame decoded;
+    ASSERT_TRUE(control_frame::decode(data.data(), data.size(), decoded));
+    EXPECT_EQ(decoded.flags, frame.flags);
+    EXPECT_EQ(decoded.sequence, 0xDEADBEEFu);
+    EXPECT_EQ(decoded.timestamp_ns, 0x0123456789ABCDEFull);
+    EXPECT_EQ(decoded.throttle, -42.5f);
+    EXPECT_EQ(decoded.steering, 30.0f);
+
+    auto command = control_frame::toCommand(decoded);
+    EXPECT_FALSE(command.init);
+    EXPECT_TRUE(command.has_throttle);
+    EXPECT_DOUBLE_EQ(command.throttle, -42.5);
+    EXPECT_TRUE(command.has_steering);
+    EXPECT_TRUE(command.has_auto_mode);
+    EXPECT_TRUE(command.auto_mode);
+}
+
+TEST(ControlFrameTest, RejectsMalformedFrames) {
+    std::string data = encodeFrame(driveFrame(1, 10.0f, 0.0f));
+    control_frame::Frame frame;
+
+    EXPECT_FALSE(control_frame::decode(data.data(), data.size() - 1, frame));
+    std::string longer = data + '\0';
+    EXPECT_FALSE(control_frame::decode(longer.data(), longer.size(), frame));
+
+    std::string version = data;
+    version[1] = 2;
+    EXPECT_FALSE(control_frame::decode(version.data(), version.size(), frame));
+
+    uint8_t small[8];
+    EXPECT_EQ(control_frame::encode(frame, small, sizeof(small)), 0u);
+
+    // Text commands are never mistaken for frames
+    std::string text = "throttle:10;steering:0;";
+    EXPECT_FALSE(control_frame::isFrame(text.data(), text.size()));
+    EXPECT_FALSE(control_frame::isFrame(text.data(), 0));
+}
+
+TEST(ControlLinkMonitorTest, ClassifiesSequences) {
+    ControlLinkMonitor monitor;
+    EXPECT_EQ(monitor.recordFrame(10, 0, 0), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(11, 0, 0), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(15, 0, 0), Verdict::Gap);
+    EXPECT_EQ(monitor.recordFrame(13, 0, 0), Verdict::Stale); // reordered
+    EXPECT_EQ(monitor.recordFrame(15, 0, 0), Verdict::Stale); // duplicate
+    EXPECT_EQ(monitor.recordFrame(16, 0, 0), Verdict::InOrder);
+
+    auto stats = monitor.getStats();
+    EXPECT_EQ(stats.frames, 6u);
+    EXPECT_EQ(stats.gaps, 1u);
+    EXPECT_EQ(stats.lost, 3u);
+    EXPECT_EQ(stats.stale, 2u);
+}
+
+TEST(ControlLinkMonitorTest, HandlesWrapAndRestart) {
+    ControlLinkMonitor monitor;
+    EXPECT_EQ(monitor.recordFrame(0xFFFFFFFEu, 0, 0), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(0xFFFFFFFFu, 0, 0), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(0, 0, 0), Verdict::InOrder);
+
+    // Sender restarted: announced by an init frame or a large jump back
+    EXPECT_EQ(monitor.recordFrame(5000, 0, 0), Verdict::Gap);
+    EXPECT_EQ(monitor.recordFrame(0, 0, 0, true), Verdict::Restarted);
+    EXPECT_EQ(monitor.recordFrame(1, 0, 0), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(4000, 0, 0), Verdict::Gap);
+    EXPECT_EQ(monitor.recordFrame(0, 0, 0), Verdict::Restarted);
+    EXPECT_EQ(monitor.getStats().restarts, 2u);
+
+    monitor.reset();
+    EXPECT_EQ(monitor.getStats().frames, 0u);
+    EXPECT_EQ(monitor.recordFrame(0, 0, 0), Verdict::InOrder);
+}
+
+TEST(ControlLinkMonitorTest, RestartWithLostInitFrame) {
+    ControlLinkMonitor monitor;
+    EXPECT_EQ(monitor.recordFrame(500, 1000, 1000), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(501, 2000, 2000), Verdict::InOrder);
+    // Reordered or duplicated: sent no later than frame 501
+    EXPECT_EQ(monitor.recordFrame(499, 900, 2100), Verdict::Stale);
+    EXPECT_EQ(monitor.recordFrame(501, 2000, 2200), Verdict::Stale);
+
+    // New run within the reorder window, its init frame never arrived
+    EXPECT_EQ(monitor.recordFrame(1, 5000, 5000), Verdict::Restarted);
+    EXPECT_EQ(monitor.recordFrame(2, 6000, 6000), Verdict::InOrder);
+    EXPECT_EQ(monitor.recordFrame(1, 5000, 6100), Verdict::Stale);
+
+    auto stats = monitor.getStats();
+    EXPECT_EQ(stats.restarts, 1u);
+    EXPECT_EQ(stats.stale, 3u);
+}
+
+TEST(ControlLinkMonitorTest, MeasuresLatency) {
+    ControlLinkMonitor monitor;
+    monitor.recordFrame(0, 1000000, 1100000);  // 100 us
+    monitor.recordFrame(1, 2000000, 2300000);  // 300 us
+    monitor.recordFrame(2, 5000000, 4000000);  // clock mismatch, ignored
+    monitor.recordText();
+
+    auto stats = monitor.getStats();
+    EXPECT_EQ(stats.latency_last_us, 300u);
+    EXPECT_EQ(stats.latency_avg_us, 200u);
+    EXPECT_EQ(stats.latency_max_us, 300u);
+    EXPECT_EQ(stats.text_messages, 1u);
+}
+
+class ControlAssemblyFrameTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        sender.bind("inproc://control-frame");
+        motors = std::make_shared<MockBackMotors>();
+        servo = std::make_shared<MockFServo>();
+        assembly = std::make_unique<ControlAssembly>("inproc://control-frame", context,
+                                                     motors, servo);
+        assembly->start();
+    }
+
+    void TearDown() override {
+        assembly->stop();
+        assembly.reset();
+        restoreOutput();
+    }
+
+    // PUB/SUB joins asynchronously; resend until the first message lands
+    void sendUntil(const std::string& data, const std::function<bool()>& done) {
+        ASSERT_TRUE(waitForCondition([&] {
+            sender.send(zmq::buffer(data), zmq::send_flags::none);
+            std::this_thread::sleep_for(5ms);
+            return done();
+        }, 2000, 1));
+    }
+
+    void send(const std::string& data) {
+        sender.send(zmq::buffer(data), zmq::send_flags::none);
+    }
+
+    zmq::context_t context{1};
+    zmq::socket_t sender{context, zmq::socket_type::pub};
+    std::shared_ptr<MockBackMotors> motors;
+    std::shared_ptr<MockFServo> servo;
+    std::unique_ptr<ControlAssembly> assembly;
+};
+
+TEST_F(ControlAssemblyFrameTest, AppliesFramesAndDropsStaleOnes) {
+    control_frame::Frame init;
+    init.flags = control_frame::kInit;
+    init.timestamp_ns = control_frame::nowNs();
+    sendUntil(encodeFrame(init), [&] { return assembly->getControlLinkStats().frames > 0; });
+
+    uint32_t sequence = 1;
+    send(encodeFrame(driveFrame(sequence++, 40.0f, -20.0f)));
+    // Throttle and steering are applied one after the other; wait for both
+    ASSERT_TRUE(waitForCondition([&] {
+        return motors->getCurrentSpeed() == 40 && servo->getSteeringAngle() == -20;
+    }, 1000, 5));
+
+    // Skip two frames, then replay an old one
+    sequence += 2;
+    const control_frame::Frame replayed = driveFrame(sequence - 1, 5.0f, 45.0f);
+    send(encodeFrame(driveFrame(sequence, 60.0f, 10.0f)));
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCurrentSpeed() == 60; }, 1000, 5));
+    send(encodeFrame(replayed));
+    ASSERT_TRUE(waitForCondition([&] { return assembly->getControlLinkStats().stale == 1; },
+                                 1000, 5));
+    EXPECT_EQ(motors->getCurrentSpeed(), 60);
+    EXPECT_EQ(servo->getSteeringAngle(), 10);
+
+    auto stats = assembly->getControlLinkStats();
+    EXPECT_EQ(stats.gaps, 1u);
+    EXPECT_EQ(stats.lost, 2u);
+    EXPECT_LT(stats.latency_max_us, 1000000u);
+}
+
+TEST_F(ControlAssemblyFrameTest, BurstIsNotConflatedIntoGaps) {
+    control_frame::Frame init;
+    init.flags = control_frame::kInit;
+    init.timestamp_ns = control_frame::nowNs();
+    sendUntil(encodeFrame(init), [&] { return assembly->getControlLinkStats().frames > 0; });
+    const uint64_t frames = assembly->getControlLinkStats().frames;
+
+    // Faster than the receiver drains: every frame is queued and applied in
+    // order, none is reported lost
+    for (uint32_t sequence = 1; sequence <= 50; ++sequence) {
+        send(encodeFrame(driveFrame(sequence, static_cast<float>(sequence), 0.0f)));
+    }
+    ASSERT_TRUE(waitForCondition(
+        [&] { return assembly->getControlLinkStats().frames >= frames + 50; }, 2000, 5));
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCurrentSpeed() == 50; }, 1000, 5));
+
+    auto stats = assembly->getControlLinkStats();
+    EXPECT_EQ(stats.gaps, 0u);
+    EXPECT_EQ(stats.lost, 0u);
+}
+
+TEST_F(ControlAssemblyFrameTest, RestartWithLostInitFrameIsApplied) {
+    uint32_t sequence = 700;
+    sendUntil(encodeFrame(driveFrame(sequence++, 40.0f, 0.0f)),
+              [&] { return motors->getCurrentSpeed() == 40; });
+    // Resent duplicates above count as stale
+    const uint64_t stale = assembly->getControlLinkStats().stale;
+    send(encodeFrame(driveFrame(sequence++, 50.0f, 0.0f)));
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCurrentSpeed() == 50; }, 1000, 5));
+
+    // The Controller restarts and its init frame is lost (slow joiner); the
+    // new run's commands, the stop included, must still be applied
+    send(encodeFrame(driveFrame(1, 30.0f, 0.0f)));
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCurrentSpeed() == 30; }, 1000, 5));
+    send(encodeFrame(driveFrame(2, 0.0f, 0.0f)));
+    ASSERT_TRUE(waitForCondition([&] { return motors->getCurrentSpeed() == 0; }, 1000, 5));
+
+    auto stats = assembly->getControlLinkStats();
+    EXPECT_EQ(stats.restarts, 1u);
+    EXPECT_EQ(stats.stale, stale);
+}
+
+TEST_F(ControlAssemblyFrameTest, TextCommandsStillAccepted) {
+    sendUntil("throttle:25;steering:15;", [&] { return motors->getCurrentSpeed() == 25; });
+    EXPECT_EQ(servo->getSteeringAngle(), 15);
+    EXPECT_GE(assembly->getControlLinkStats().text_messages, 1u);
+
+    // Auto mode toggle through a frame
+    control_frame::Frame toggle;
+    toggle.flags = control_frame::kHasAutoMode | control_frame::kAutoMode;
+    send(encodeFrame(toggle));
+    ASSERT_TRUE(waitForCondition([&] { return assembly->getControlLinkStats().frames == 1; },
+                                 1000, 5));
+
+    // Manual commands are ignored in auto mode
+    send(encodeFrame(driveFrame(1, 80.0f, 0.0f)));
+    ASSERT_TRUE(waitForCondition([&] { return assembly->getControlLinkStats().frames == 2; },
+                                 1000, 5));
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(motors->getCurrentSpeed(), 25);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
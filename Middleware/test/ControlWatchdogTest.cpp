@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include "ControlAssembly.hpp"
+#include "ControlWatchdog.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "TestUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Source = CommandArbiter::Source;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Event {
+    Source source;
+    bool expired;
+    Clock::time_point at;
+};
+
+class EventLog {
+public:
+    ControlWatchdog::Handler handler() {
+        return [this](Source source, bool expired) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back({source, expired, Clock::now()});
+        };
+    }
+    std::vector<Event> get() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events;
+    }
+    size_t size() { return get().size(); }
+
+private:
+    std::mutex mutex;
+    std::vector<Event> events;
+};
+
+ControlWatchdog::Config config(std::chrono::milliseconds manual,
+                               std::chrono::milliseconds autonomous) {
+    ControlWatchdog::Config result;
+    result.manual_timeout = manual;
+    result.autonomous_timeout = autonomous;
+    return result;
+}
+
+// Records every throttle write with its time
+class RecordingMotors : public MockBackMotors {
+public:
+    void setSpeed(int speed) override {
+        MockBackMotors::setSpeed(speed);
+        std::lock_guard<std::mutex> lock(mutex);
+        writes.push_back(speed);
+        last = speed;
+    }
+    int current() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return last;
+    }
+    std::vector<int> since(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::vector<int>(writes.begin() + std::min(index, writes.size()), writes.end());
+    }
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return writes.size();
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<int> writes;
+    int last = 0;
+};
+
+class RecordingPublisher : public IPublisher {
+public:
+    void send(const std::string &message) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back({message, Clock::now()});
+    }
+    // Time `message` was first (or last) sent, if it was
+    bool sentAt(const std::string &message, Clock::time_point &at, bool last = false) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool found = false;
+        for (const auto &sent : messages) {
+            if (sent.first == message && (last || !found)) {
+                at = sent.second;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::pair<std::string, Clock::time_point>> messages;
+};
+
+} // namespace
+
+class ControlWatchdogTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override { suppressOutput(); }
+    void TearDown() override { restoreOutput(); }
+};
+
+TEST_F(ControlWatchdogTest, RejectsInvalidConfiguration) {
+    EXPECT_THROW(ControlWatchdog(nullptr), std::invalid_argument);
+    EventLog log;
+    EXPECT_THROW(ControlWatchdog(log.handler(), config(-1ms, 100ms)), std::invalid_argument);
+    ControlWatchdog::Config ramp;
+    ramp.ramp_down = -1ms;
+    EXPECT_THROW(ControlWatchdog(log.handler(), ramp), std::invalid_argument);
+}
+
+TEST_F(ControlWatchdogTest, QuietUntilFirstFeed) {
+    EventLog log;
+    ControlWatchdog watchdog(log.handler(), config(30ms, 30ms));
+    watchdog.start();
+    std::this_thread::sleep_for(100ms);
+    watchdog.stop();
+    EXPECT_EQ(log.size(), 0u);
+    EXPECT_FALSE(watchdog.isExpired(Source::Manual));
+}
+
+TEST_F(ControlWatchdogTest, ExpiresWhenFeedsStopAndRecovers) {
+    EventLog log;
+    ControlWatchdog watchdog(log.handler(), config(50ms, 0ms));
+    watchdog.start();
+
+    // Fed at 100 Hz for 300ms: never expires
+    Clock::time_point last_feed;
+    for (int i = 0; i < 30; ++i) {
+        watchdog.feed(Source::Manual);
+        last_feed = Clock::now();
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(log.size(), 0u);
+
+    ASSERT_TRUE(waitForCondition([&] { return log.size() == 1; }, 1000, 1));
+    Event expired = log.get()[0];
+    EXPECT_EQ(expired.source, Source::Manual);
+    EXPECT_TRUE(expired.expired);
+    EXPECT_TRUE(watchdog.isExpired(Source::Manual));
+    auto detected = std::chrono::duration_cast<std::chrono::microseconds>(
+        expired.at - last_feed - 50ms);
+    EXPECT_GE(detected.count(), 0);
+
+    // A feed counts at once; the thread reports the recovery
+    watchdog.feed(Source::Manual);
+    EXPECT_FALSE(watchdog.isExpired(Source::Manual));
+    ASSERT_TRUE(waitForCondition([&] { return log.size() == 2; }, 1000, 1));
+    EXPECT_FALSE(log.get()[1].expired);
+
+    // Unwatched sources are ignored
+    watchdog.feed(Source::Autonomous);
+    watchdog.stop();
+
+    ControlWatchdog::Stats stats = watchdog.getStats();
+    EXPECT_EQ(stats.timeouts, 1u);
+    EXPECT_EQ(stats.recoveries, 1u);
+    restoreOutput();
+    std::cout << "Detection latency: " << detected.count() << "us after the deadline (watchdog "
+              << stats.latency_max_us << "us)" << std::endl;
+    suppressOutput();
+    // timerfd wake-up, not a polling period
+    if (!isRunningInCI()) {
+        EXPECT_LT(stats.latency_max_us, 5000);
+    }
+}
+
+TEST_F(ControlWatchdogTest, SourcesTimeOutIndependently) {
+    EventLog log;
+    ControlWatchdog watchdog(log.handler(), config(40ms, 120ms));
+    watchdog.start();
+    watchdog.feed(Source::Manual);
+    watchdog.feed(Source::Autonomous);
+    ASSERT_TRUE(waitForCondition([&] { return log.size() == 2; }, 1000, 1));
+    watchdog.stop();
+
+    std::vector<Event> events = log.get();
+    EXPECT_EQ(events[0].source, Source::Manual);
+    EXPECT_EQ(events[1].source, Source::Autonomous);
+    EXPECT_GE(events[1].at - events[0].at, 60ms);
+}
+
+// The Controller stand-in publishes at 100 Hz and then goes silent
+TEST_F(ControlWatchdogTest, ControlAssemblyStopsWhenControllerGoesSilent) {
+    auto motors = std::make_shared<RecordingMotors>();
+    auto servo = std::make_shared<MockFServo>();
+    auto cluster = std::make_shared<RecordingPublisher>();
+    zmq::context_t context{1};
+    zmq::socket_t controller{context, zmq::socket_type::pub};
+    controller.bind("inproc://watchdog-controller");
+    auto assembly = std::make_unique<ControlAssembly>("inproc://watchdog-controller", context,
+                                                      motors, servo, cluster);
+    ControlWatchdog::Config watchdog = config(150ms, 0ms);
+    watchdog.ramp_down = 200ms;
+    assembly->enableWatchdog(watchdog);
+    assembly->start();
+    EXPECT_THROW(assembly->enableWatchdog(), std::logic_error);
+
+    const std::string command = "throttle:50;steering:20;";
+    Clock::time_point last_sent;
+    auto send = [&] {
+        controller.send(zmq::buffer(command), zmq::send_flags::none);
+        last_sent = Clock::now();
+    };
+    ASSERT_TRUE(waitForCondition(
+        [&] {
+            send();
+            std::this_thread::sleep_for(10ms);
+            return motors->current() == 50;
+        },
+        2000, 1));
+    for (int i = 0; i < 30; ++i) {
+        send();
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(assembly->getWatchdogStats().timeouts, 0u);
+
+    const Clock::time_point silent = last_sent;
+    const size_t before = motors->count();
+    Clock::time_point lost;
+    ASSERT_TRUE(waitForCondition([&] { return cluster->sentAt("watchdog:1;", lost); }, 2000,
+                                 1));
+    ASSERT_TRUE(waitForCondition([&] { return motors->current() == 0; }, 2000, 1));
+    EXPECT_EQ(servo->getSteeringAngle(), 0);
+
+    // Ramped down, not cut
+    std::vector<int> ramp = motors->since(before);
+    EXPECT_GT(ramp.size(), 3u);
+    EXPECT_TRUE(std::is_sorted(ramp.rbegin(), ramp.rend()));
+    EXPECT_TRUE(std::any_of(ramp.begin(), ramp.end(), [](int v) { return v > 0 && v < 50; }));
+
+    auto detection = std::chrono::duration_cast<std::chrono::milliseconds>(lost - silent);
+    restoreOutput();
+    std::cout << "Silent to watchdog:1 " << detection.count() << "ms (timeout 150ms), ramp "
+              << ramp.size() << " writes" << std::endl;
+    suppressOutput();
+    EXPECT_GE(detection, 150ms);
+    EXPECT_LT(detection, 150ms + (isRunningInCI() ? 200ms : 50ms));
+
+    // The Controller comes back
+    ASSERT_TRUE(waitForCondition(
+        [&] {
+            send();
+            std::this_thread::sleep_for(10ms);
+            return motors->current() == 50;
+        },
+        2000, 1));
+    Clock::time_point restored;
+    EXPECT_TRUE(waitForCondition(
+        [&] { return cluster->sentAt("watchdog:0;", restored, true) && restored > lost; }, 1000,
+        1));
+    EXPECT_EQ(servo->getSteeringAngle(), 20);
+    ControlWatchdog::Stats stats = assembly->getWatchdogStats();
+    EXPECT_EQ(stats.timeouts, 1u);
+    EXPECT_EQ(stats.recoveries, 1u);
+
+    assembly->stop();
+    assembly.reset();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
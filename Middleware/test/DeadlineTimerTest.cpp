@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "DeadlineTimer.hpp"
+#include "TestUtils.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+using Clock = DeadlineTimer::Clock;
+
+class DeadlineTimerTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override { suppressOutput(); }
+    void TearDown() override { restoreOutput(); }
+};
+
+TEST_F(DeadlineTimerTest, FlushesAtTheReturnedDeadline) {
+    std::atomic<int> flushes{0};
+    DeadlineTimer timer("test", [&](Clock::time_point now) {
+        flushes++;
+        return now + 20ms;
+    });
+    timer.start();
+    EXPECT_TRUE(waitForCondition([&] { return flushes >= 5; }, 1000, 5));
+    timer.stop();
+
+    const int stopped = flushes;
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(flushes, stopped);
+}
+
+TEST_F(DeadlineTimerTest, WakeFlushesBeforeTheDeadline) {
+    std::atomic<int> flushes{0};
+    DeadlineTimer timer("test", [&](Clock::time_point) {
+        flushes++;
+        return Clock::time_point::max(); // nothing scheduled
+    });
+    timer.start();
+    ASSERT_TRUE(waitForCondition([&] { return flushes == 1; }, 1000, 1));
+
+    timer.wake();
+    EXPECT_TRUE(waitForCondition([&] { return flushes == 2; }, 200, 1));
+}
+
+TEST_F(DeadlineTimerTest, KeepsRunningAfterAFlushThrows) {
+    std::atomic<int> flushes{0};
+    DeadlineTimer timer("test", [&](Clock::time_point now) -> Clock::time_point {
+        if (flushes++ == 0) {
+            throw std::runtime_error("publisher gone");
+        }
+        return now + 10ms;
+    });
+    timer.start();
+    timer.wake();
+    EXPECT_TRUE(waitForCondition([&] { return flushes >= 2; }, 2000, 5));
+}
+
+TEST_F(DeadlineTimerTest, StartAndStopAreIdempotent) {
+    DeadlineTimer timer("test", [](Clock::time_point now) { return now + 10ms; });
+    timer.stop(); // never started
+    timer.start();
+    timer.start();
+    timer.stop();
+    timer.stop();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "DistanceFilter.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Emergency threshold used by Distance::calculateCollisionRisk
+constexpr uint16_t kEmergencyCm = 20;
+
+bool isEmergency(uint16_t cm) { return cm > 0 && cm < kEmergencyCm; }
+
+// Recorded-style SRF08 trace: an obstacle held at ~60 cm with +-2 cm noise and
+// periodic missed-echo spikes, then a real approach down to 10 cm
+std::vector<uint16_t> makeTrace(size_t& approach_start) {
+    std::vector<uint16_t> trace;
+    const int noise[] = {0, 1, -1, 2, -2, 1, 0, -1};
+    for (size_t i = 0; i < 200; ++i) {
+        uint16_t sample = static_cast<uint16_t>(60 + noise[i % 8]);
+        if (i % 17 == 5) {
+            sample = 6; // multipath spike
+        } else if (i % 23 == 11) {
+            sample = 250; // missed echo
+        }
+        trace.push_back(sample);
+    }
+    approach_start = trace.size();
+    for (int cm = 58; cm >= 10; cm -= 4) {
+        trace.push_back(static_cast<uint16_t>(cm));
+    }
+    return trace;
+}
+
+} // namespace
+
+TEST(DistanceFilterTest, PassesCleanSignal) {
+    DistanceFilter filter;
+    for (uint16_t cm : {50, 51, 49, 50, 52, 48, 50}) {
+        EXPECT_EQ(filter.filter(cm), cm);
+        EXPECT_FALSE(filter.lastRejected());
+    }
+    EXPECT_EQ(filter.getRejectedCount(), 0u);
+}
+
+TEST(DistanceFilterTest, RejectsSingleSpike) {
+    DistanceFilter filter;
+    for (int i = 0; i < 5; ++i) {
+        filter.filter(80);
+    }
+    uint16_t out = filter.filter(5);
+    EXPECT_TRUE(filter.lastRejected());
+    EXPECT_EQ(out, 80);
+    EXPECT_EQ(filter.filter(80), 80);
+    EXPECT_EQ(filter.getRejectedCount(), 1u);
+}
+
+TEST(DistanceFilterTest, StepChangeDelayedAtMostOneFrame) {
+    DistanceFilter filter;
+    for (int i = 0; i < 5; ++i) {
+        filter.filter(100);
+    }
+    // First frame of the step is held back, the second must pass
+    EXPECT_EQ(filter.filter(15), 100);
+    EXPECT_EQ(filter.filter(15), 15);
+    EXPECT_EQ(filter.filter(15), 15);
+}
+
+TEST(DistanceFilterTest, SmallWindowDisablesFiltering) {
+    DistanceFilter filter(2);
+    for (int i = 0; i < 5; ++i) {
+        filter.filter(100);
+    }
+    EXPECT_EQ(filter.filter(5), 5);
+    EXPECT_EQ(filter.getRejectedCount(), 0u);
+}
+
+TEST(DistanceFilterTest, WindowClampedToMaximum) {
+    DistanceFilter filter(64);
+    EXPECT_EQ(filter.getWindow(), DistanceFilter::maxWindow);
+}
+
+TEST(DistanceFilterTest, ResetClearsHistory) {
+    DistanceFilter filter;
+    for (int i = 0; i < 5; ++i) {
+        filter.filter(100);
+    }
+    filter.filter(5);
+    filter.reset();
+    EXPECT_EQ(filter.getRejectedCount(), 0u);
+    EXPECT_EQ(filter.filter(5), 5); // No history to judge against
+}
+
+TEST(DistanceFilterTest, TraceReplayFalseBrakeRateAndDelay) {
+    size_t approach_start = 0;
+    auto trace = makeTrace(approach_start);
+
+    DistanceFilter filter;
+    int raw_false_brakes = 0;
+    int filtered_false_brakes = 0;
+    long raw_detect = -1;
+    long filtered_detect = -1;
+
+    for (size_t i = 0; i < trace.size(); ++i) {
+        uint16_t raw = trace[i];
+        uint16_t filtered = filter.filter(raw);
+
+        if (i < approach_start) {
+            raw_false_brakes += isEmergency(raw) ? 1 : 0;
+            filtered_false_brakes += isEmergency(filtered) ? 1 : 0;
+        } else {
+            if (raw_detect < 0 && isEmergency(raw)) {
+                raw_detect = static_cast<long>(i);
+            }
+            if (filtered_detect < 0 && isEmergency(filtered)) {
+                filtered_detect = static_cast<long>(i);
+            }
+        }
+    }
+
+    EXPECT_GT(raw_false_brakes, 0);
+    EXPECT_EQ(filtered_false_brakes, 0);
+    ASSERT_GE(raw_detect, 0);
+    ASSERT_GE(filtered_detect, 0);
+    EXPECT_LE(filtered_detect - raw_detect, 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -282,6 +282,48 @@ TEST_F(DistanceTest, FixedThresholds_SafeAtFarDistance) {
     EXPECT_EQ(sensorData["obs"]->value.load(), 0); // Safe level
 }
 
+TEST_F(DistanceTest, SingleSpikeDoesNotTriggerEmergencyBrake) {
+    int brake_toggles = 0;
+    distance->setEmergencyBrakeCallback([&brake_toggles](bool) {
+        brake_toggles++;
+    });
+
+    auto& bus = CanMessageBus::getInstance();
+    const uint16_t trace[] = {60, 61, 59, 60, 8, 60, 61};
+    for (uint16_t cm : trace) {
+        uint8_t test_data[8] = {static_cast<uint8_t>(cm), 0, 0, 0, 0, 0, 0, 0};
+        bus.injectTestMessage(CanMessage(0x101, test_data, 8));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        distance->updateSensorData();
+
+        if (cm == 8) {
+            // Raw value is exposed, collision detection uses the filtered one
+            EXPECT_EQ(distance->getRawDistance(), 8);
+            EXPECT_EQ(distance->getFilteredDistance(), 60);
+        }
+    }
+
+    EXPECT_EQ(brake_toggles, 0);
+    EXPECT_EQ(distance->getRejectedSamples(), 1u);
+}
+
+TEST_F(DistanceTest, FilterDisabledPassesRawValues) {
+    auto unfiltered = std::make_shared<Distance>(1);
+    unfiltered->start();
+
+    auto& bus = CanMessageBus::getInstance();
+    for (uint16_t cm : {60, 60, 60, 60, 8}) {
+        uint8_t test_data[8] = {static_cast<uint8_t>(cm), 0, 0, 0, 0, 0, 0, 0};
+        bus.injectTestMessage(CanMessage(0x101, test_data, 8));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        unfiltered->updateSensorData();
+    }
+
+    EXPECT_EQ(unfiltered->getFilteredDistance(), 8);
+    EXPECT_EQ(unfiltered->getSensorData()["obs"]->value.load(), 2);
+    unfiltered->stop();
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
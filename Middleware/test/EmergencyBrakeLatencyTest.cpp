@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include "BackMotors.hpp"
+#include "ControlAssembly.hpp"
+#include "Distance.hpp"
+#include "MockFServo.hpp"
+#include "TestUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <zmq.hpp>
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// PCA9685 on a 100kHz bus: every transaction holds the bus for the time its
+// bytes take on the wire (9 clocks per byte, address byte included), and
+// transactions are serialized like the kernel's adapter lock does. Records
+// when channels 0-7 first all read 4095 after being armed.
+class TimedPca9685Bus : public II2cDevice {
+public:
+    static constexpr double kBitsPerSecond = 100000.0;
+
+    void writeBursts(const I2cBurst* bursts, size_t count) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t bytes = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bytes += 2 + bursts[i].length; // address, register, data
+        }
+        auto done = Clock::now() + std::chrono::nanoseconds(
+                                       static_cast<int64_t>(bytes * 9 / kBitsPerSecond * 1e9));
+        while (Clock::now() < done) {
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (bursts[i].reg == Pca9685::kAllLed) {
+                for (int channel = 0; channel < 16; ++channel) {
+                    std::memcpy(&registers[Pca9685::kLed0 + 4 * channel], bursts[i].data, 4);
+                }
+            } else {
+                std::memcpy(&registers[bursts[i].reg], bursts[i].data, bursts[i].length);
+            }
+        }
+        transactions++;
+        if (armed && braked()) {
+            armed = false;
+            brakedAt = Clock::now();
+            landed = true;
+        }
+    }
+
+    void readRegisters(uint8_t reg, uint8_t* out, size_t length) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::memcpy(out, &registers[reg], length);
+    }
+
+    void arm() {
+        std::lock_guard<std::mutex> lock(mutex);
+        armed = true;
+        landed = false;
+    }
+
+    bool braked() const {
+        for (int channel = 0; channel < 8; ++channel) {
+            int off = Pca9685::kLed0 + 4 * channel + 2;
+            if (registers[off] != 0xFF || registers[off + 1] != 0x0F) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint8_t offHigh(int channel) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return registers[Pca9685::kLed0 + 4 * channel + 3];
+    }
+
+    std::atomic<bool> landed{false};
+    Clock::time_point brakedAt;
+    int transactions = 0;
+
+private:
+    std::mutex mutex;
+    bool armed = false;
+    uint8_t registers[256] = {};
+};
+
+// BackMotors on the timed bus instead of /dev/i2c-1
+class BusBackMotors : public BackMotors {
+public:
+    explicit BusBackMotors(std::shared_ptr<TimedPca9685Bus> bus) : bus(std::move(bus)) {}
+    void open_i2c_bus() override { attachDevice(bus); }
+    bool init_motors() override { return true; }
+
+protected:
+    std::shared_ptr<TimedPca9685Bus> bus;
+};
+
+// The brake as it was: 16 channels, four single-byte transactions each
+class ByteWiseBrakeMotors : public BusBackMotors {
+public:
+    using BusBackMotors::BusBackMotors;
+    void emergencyBrake() override {
+        for (int channel = 0; channel < 16; ++channel) {
+            for (int reg = 0; reg < 4; ++reg) {
+                bus->writeRegister(Pca9685::kLed0 + 4 * channel + reg,
+                                   reg == 2 ? 0xFF : reg == 3 ? 0x0F : 0x00);
+            }
+        }
+    }
+};
+
+CanMessage distanceFrame(uint16_t cm) {
+    const uint8_t data[2] = {static_cast<uint8_t>(cm & 0xFF), static_cast<uint8_t>(cm >> 8)};
+    return CanMessage(0x101, data, 2); // stamped on arrival
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+} // namespace
+
+class EmergencyBrakeLatencyTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    static constexpr int kRuns = 15;
+
+    void SetUp() override {
+        suppressOutput();
+        bus = std::make_shared<TimedPca9685Bus>();
+        distance = std::make_shared<Distance>(0); // unfiltered: one frame decides
+    }
+
+    void TearDown() override { restoreOutput(); }
+
+    // Obstacle frame arrives -> Distance decides -> brake lands on the bus.
+    // `release` runs between obstacles with the road clear again.
+    std::vector<double> measure(const std::function<void()>& release) {
+        std::vector<double> latencies_us;
+        for (int run = 0; run < kRuns; ++run) {
+            distance->onCanMessage(distanceFrame(80));
+            distance->updateSensorData();
+            release();
+
+            bus->arm();
+            CanMessage obstacle = distanceFrame(10);
+            distance->onCanMessage(obstacle);
+            distance->updateSensorData();
+            EXPECT_TRUE(waitForCondition([&] { return bus->landed.load(); }, 1000, 1));
+            latencies_us.push_back(
+                std::chrono::duration<double, std::micro>(bus->brakedAt - obstacle.timestamp)
+                    .count());
+        }
+        return latencies_us;
+    }
+
+    std::shared_ptr<TimedPca9685Bus> bus;
+    std::shared_ptr<Distance> distance;
+};
+
+TEST_F(EmergencyBrakeLatencyTest, ObstacleToWheels) {
+    // Before: the Distance thread wrote the brake itself, byte by byte
+    auto legacy = std::make_shared<ByteWiseBrakeMotors>(bus);
+    distance->setEmergencyBrakeCallback([&](bool active) {
+        if (active) {
+            legacy->emergencyBrake();
+        }
+    });
+    auto releaseLegacy = [&] {
+        for (int channel = 0; channel < 8; ++channel) {
+            bus->writeRegister(Pca9685::kLed0 + 4 * channel + 3, 0);
+        }
+    };
+    auto before = measure(releaseLegacy);
+    distance->onCanMessage(distanceFrame(80));
+    distance->updateSensorData();
+    releaseLegacy();
+
+    // After: Distance -> ControlAssembly -> actuator owner -> ALL_LED write
+    zmq::context_t context{1};
+    zmq::socket_t controller{context, zmq::socket_type::pub};
+    controller.bind("inproc://brake-latency");
+    auto motors = std::make_shared<BusBackMotors>(bus);
+    auto assembly = std::make_unique<ControlAssembly>("inproc://brake-latency", context,
+                                                      motors, std::make_shared<MockFServo>());
+    assembly->start();
+    distance->setEmergencyBrakeCallback(
+        [&](bool active) { assembly->handleEmergencyBrake(active); });
+    auto after = measure([&] {
+        // Releasing the brake sets throttle 0 through the owner thread
+        ASSERT_TRUE(waitForCondition([&] { return bus->offHigh(0) == 0; }, 1000, 1));
+    });
+    int transactions = motors->getPwmStats().transactions;
+    assembly->stop();
+    assembly.reset();
+
+    double before_us = median(before);
+    double after_us = median(after);
+    EXPECT_LT(after_us * 4, before_us);
+    EXPECT_GT(transactions, 0);
+    // Absolute bounds only where the scheduler is not shared
+    if (!isRunningInCI()) {
+        EXPECT_LT(after_us, 5000.0);
+    }
+
+    restoreOutput();
+    std::cout << "Obstacle to wheels (100kHz bus, median of " << kRuns << "): "
+              << before_us << " us byte-wise on the sensor thread -> " << after_us
+              << " us ALL_LED via actuator owner" << std::endl;
+    suppressOutput();
+}
+
+TEST_F(EmergencyBrakeLatencyTest, BrakeIsOneShortTransaction) {
+    BusBackMotors motors(bus);
+    motors.open_i2c_bus();
+    motors.setSpeed(60);
+    int before = bus->transactions;
+
+    auto start = Clock::now();
+    motors.emergencyBrake();
+    auto elapsed = Clock::now() - start;
+
+    EXPECT_EQ(bus->transactions - before, 1);
+    EXPECT_TRUE(bus->braked());
+    // 6 bytes on the wire: 540us, against 17ms for 64 single-byte writes
+    if (!isRunningInCI()) {
+        EXPECT_LT(elapsed, 5ms);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
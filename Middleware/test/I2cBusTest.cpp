@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include "BackMotors.hpp"
+#include "BatteryReader.hpp"
+#include "FServo.hpp"
+#include "I2cBus.hpp"
+#include "TestUtils.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Register files for every address on the bus. Records each transaction,
+// detects overlapping transfers and can hold a transfer until released.
+class FakeAdapter : public II2cAdapter {
+public:
+    struct Message {
+        uint16_t address;
+        bool read;
+        std::vector<uint8_t> bytes;
+    };
+
+    void transfer(I2cMessage* messages, size_t count) override {
+        if (busy.exchange(true)) {
+            overlapped = true;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (hold) {
+                held = true;
+                released.wait(lock, [this] { return !hold; });
+            }
+        }
+        std::this_thread::sleep_for(delay);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        busy = false;
+        if (fail) {
+            throw std::runtime_error("NACK");
+        }
+        std::vector<Message> transaction;
+        for (size_t i = 0; i < count; ++i) {
+            I2cMessage& message = messages[i];
+            auto& file = registers[message.address];
+            bool read = message.flags & I2cMessage::kRead;
+            if (read) {
+                for (size_t b = 0; b < message.length; ++b) {
+                    message.buffer[b] = file[static_cast<uint8_t>(pointer[message.address] + b)];
+                }
+            } else if (message.length > 0) {
+                pointer[message.address] = message.buffer[0];
+                for (size_t b = 1; b < message.length; ++b) {
+                    file[static_cast<uint8_t>(message.buffer[0] + b - 1)] = message.buffer[b];
+                }
+            }
+            transaction.push_back(
+                {message.address, read,
+                 std::vector<uint8_t>(message.buffer, message.buffer + message.length)});
+        }
+        log.push_back(transaction);
+    }
+
+    void holdNext() {
+        std::lock_guard<std::mutex> lock(mutex);
+        hold = true;
+        held = false;
+    }
+    bool isHeld() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return held;
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            hold = false;
+        }
+        released.notify_all();
+    }
+    std::vector<std::vector<Message>> getLog() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return log;
+    }
+    void setRegister(uint16_t address, uint8_t reg, uint8_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        registers[address][reg] = value;
+    }
+
+    std::chrono::microseconds delay{0};
+    bool fail = false;
+    std::atomic<bool> overlapped{false};
+
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    bool hold = false;
+    bool held = false;
+    std::atomic<bool> busy{false};
+    std::map<uint16_t, std::map<uint8_t, uint8_t>> registers;
+    std::map<uint16_t, uint8_t> pointer;
+    std::vector<std::vector<Message>> log;
+};
+
+} // namespace
+
+class I2cBusTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        adapter = std::make_shared<FakeAdapter>();
+        bus = std::make_unique<I2cBus>(adapter);
+    }
+
+    void TearDown() override { restoreOutput(); }
+
+    std::shared_ptr<FakeAdapter> adapter;
+    std::unique_ptr<I2cBus> bus;
+};
+
+TEST_F(I2cBusTest, TypedTransactionsBecomeOneCombinedTransfer) {
+    const uint8_t data[2] = {0x12, 0x34};
+    bus->write(0x41, I2cPriority::Normal, 0x05, data, 2);
+
+    uint8_t out[2] = {};
+    bus->writeRead(0x41, I2cPriority::Normal, 0x05, out, 2);
+    EXPECT_EQ(out[0], 0x12);
+    EXPECT_EQ(out[1], 0x34);
+
+    const uint8_t a[4] = {1, 2, 3, 4};
+    const uint8_t b[4] = {5, 6, 7, 8};
+    I2cBurst bursts[2] = {{0x06, a, 4}, {0x16, b, 4}};
+    bus->burst(0x60, I2cPriority::Actuator, bursts, 2);
+
+    auto log = adapter->getLog();
+    ASSERT_EQ(log.size(), 3u);
+    ASSERT_EQ(log[0].size(), 1u);
+    EXPECT_EQ(log[0][0].bytes, (std::vector<uint8_t>{0x05, 0x12, 0x34}));
+
+    ASSERT_EQ(log[1].size(), 2u);
+    EXPECT_FALSE(log[1][0].read);
+    EXPECT_EQ(log[1][0].bytes, std::vector<uint8_t>{0x05});
+    EXPECT_TRUE(log[1][1].read);
+    EXPECT_EQ(log[1][1].address, 0x41);
+
+    ASSERT_EQ(log[2].size(), 2u);
+    EXPECT_EQ(log[2][0].address, 0x60);
+    EXPECT_EQ(log[2][1].bytes, (std::vector<uint8_t>{0x16, 5, 6, 7, 8}));
+}
+
+TEST_F(I2cBusTest, RejectsOversizedBurstsAndUnopenedBus) {
+    uint8_t data[I2cBus::kMaxBurstLength + 1] = {};
+    I2cBurst tooLong{0x06, data, sizeof(data)};
+    EXPECT_THROW(bus->burst(0x60, I2cPriority::Actuator, &tooLong, 1),
+                 std::invalid_argument);
+
+    I2cBus closed;
+    EXPECT_FALSE(closed.isOpen());
+    EXPECT_THROW(closed.write(0x60, I2cPriority::Actuator, 0, data, 1), std::runtime_error);
+    EXPECT_EQ(closed.getStats(0x60).errors, 1u);
+}
+
+TEST_F(I2cBusTest, CountsErrorsPerDevice) {
+    uint8_t value = 0;
+    adapter->fail = true;
+    EXPECT_THROW(bus->writeRead(0x41, I2cPriority::Background, 0x02, &value, 1),
+                 std::runtime_error);
+    adapter->fail = false;
+    bus->writeRead(0x41, I2cPriority::Background, 0x02, &value, 1);
+    bus->write(0x60, I2cPriority::Actuator, 0x00, &value, 1);
+
+    auto all = bus->getAllStats();
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(all[0x41].transactions, 2u);
+    EXPECT_EQ(all[0x41].errors, 1u);
+    EXPECT_EQ(all[0x60].transactions, 1u);
+    EXPECT_EQ(all[0x60].errors, 0u);
+
+    // A failed transaction still releases the bus
+    adapter->fail = true;
+    EXPECT_THROW(bus->write(0x60, I2cPriority::Actuator, 0x00, &value, 1), std::runtime_error);
+    adapter->fail = false;
+    EXPECT_NO_THROW(bus->write(0x60, I2cPriority::Actuator, 0x00, &value, 1));
+}
+
+TEST_F(I2cBusTest, ActuatorTrafficPreemptsQueuedBatteryPolling) {
+    auto run = [&](uint16_t address, I2cPriority priority) {
+        return std::thread([&, address, priority] {
+            uint8_t value = 0;
+            bus->writeRead(address, priority, 0x02, &value, 1);
+        });
+    };
+
+    // A battery read holds the bus while more polls and a motor write queue up
+    adapter->holdNext();
+    std::vector<std::thread> threads;
+    threads.push_back(run(0x41, I2cPriority::Background));
+    ASSERT_TRUE(waitForCondition([&] { return adapter->isHeld(); }, 1000, 1));
+    for (int i = 0; i < 3; ++i) {
+        threads.push_back(run(0x41, I2cPriority::Background));
+        std::this_thread::sleep_for(10ms);
+    }
+    threads.push_back(run(0x40, I2cPriority::Normal));
+    std::this_thread::sleep_for(10ms);
+    threads.push_back(run(0x60, I2cPriority::Actuator));
+    std::this_thread::sleep_for(10ms);
+
+    adapter->release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<uint16_t> order;
+    for (const auto& transaction : adapter->getLog()) {
+        order.push_back(transaction[0].address);
+    }
+    EXPECT_EQ(order, (std::vector<uint16_t>{0x41, 0x60, 0x40, 0x41, 0x41, 0x41}));
+    EXPECT_FALSE(adapter->overlapped.load());
+    EXPECT_GT(bus->getStats(0x41).wait_max_us, bus->getStats(0x60).wait_max_us);
+}
+
+TEST_F(I2cBusTest, DriversShareOneBus) {
+    auto motors = std::make_shared<BackMotors>();
+    auto servo = std::make_shared<FServo>();
+    motors->attachDevice(bus->device(0x60, I2cPriority::Actuator));
+    servo->attachDevice(bus->device(0x40, I2cPriority::Actuator));
+
+    // INA219 bus voltage 12V with conversion ready set
+    uint16_t busRaw = static_cast<uint16_t>((3000 << 3) | 0x0002);
+    adapter->setRegister(0x41, 0x02, busRaw >> 8);
+    adapter->setRegister(0x41, 0x03, busRaw & 0xFF);
+    BatteryReader battery(bus->device(0x41, I2cPriority::Background), 0ms);
+
+    adapter->delay = 100us;
+    std::atomic<bool> running{true};
+    std::thread poller([&] {
+        while (running) {
+            battery.getVoltage();
+        }
+    });
+    for (int i = 0; i < 50; ++i) {
+        motors->setSpeed(i % 2 ? 40 : -40);
+        servo->set_steering(i % 2 ? 20 : -20);
+    }
+    running = false;
+    poller.join();
+
+    EXPECT_NEAR(battery.getVoltage(), 12.0, 0.01);
+    EXPECT_FALSE(adapter->overlapped.load());
+
+    auto all = bus->getAllStats();
+    EXPECT_EQ(all[0x60].transactions, 50u);
+    EXPECT_EQ(all[0x40].transactions, 50u);
+    EXPECT_GT(all[0x41].transactions, 0u);
+    EXPECT_EQ(all[0x60].errors + all[0x40].errors + all[0x41].errors, 0u);
+
+    // Register helpers of the drivers go through the same bus
+    motors->writeByteData(-1, 0xFE, 100);
+    EXPECT_EQ(motors->readByteData(-1, 0xFE), 100);
+
+    restoreOutput();
+    std::cout << "Actuator wait on a shared bus: avg " << all[0x60].wait_avg_us << " us, max "
+              << all[0x60].wait_max_us << " us (battery max " << all[0x41].wait_max_us
+              << " us)" << std::endl;
+    suppressOutput();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include "KeyValueCodec.hpp"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+// Counts heap allocations made by the calling thread
+namespace {
+thread_local size_t allocations = 0;
+}
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using namespace kv_codec;
+
+TEST(KeyValueCodecTest, KeyLookupIsExact) {
+    for (size_t i = 0; i < kKeyCount; ++i) {
+        Key key = static_cast<Key>(i + 1);
+        EXPECT_EQ(lookupKey(kKeyNames[i]), key);
+        EXPECT_EQ(keyName(key), kKeyNames[i]);
+    }
+    EXPECT_EQ(lookupKey(""), Key::Unknown);
+    EXPECT_EQ(lookupKey("throttl"), Key::Unknown);
+    EXPECT_EQ(lookupKey("Throttle"), Key::Unknown);
+    EXPECT_EQ(lookupKey("steering_"), Key::Unknown);
+    EXPECT_EQ(keyName(Key::Unknown), "");
+}
+
+TEST(KeyValueCodecTest, ParsesControlCommands) {
+    auto command = parseControl("throttle:50;steering:-30;");
+    EXPECT_FALSE(command.init);
+    ASSERT_TRUE(command.has_throttle);
+    EXPECT_DOUBLE_EQ(command.throttle, 50.0);
+    ASSERT_TRUE(command.has_steering);
+    EXPECT_DOUBLE_EQ(command.steering, -30.0);
+    EXPECT_FALSE(command.has_auto_mode);
+
+    command = parseControl("auto_mode:1;throttle:12.5");
+    ASSERT_TRUE(command.has_auto_mode);
+    EXPECT_TRUE(command.auto_mode);
+    EXPECT_DOUBLE_EQ(command.throttle, 12.5);
+
+    command = parseControl("auto_mode:0;");
+    ASSERT_TRUE(command.has_auto_mode);
+    EXPECT_FALSE(command.auto_mode);
+
+    EXPECT_TRUE(parseControl("init;").init);
+    EXPECT_FALSE(parseControl("init;throttle:0;").init);
+}
+
+TEST(KeyValueCodecTest, ParsesFrameTimestampAndSequence) {
+    auto command = parseControl("throttle:20;steering:4;frame_ts:123456789012345;seq:42;");
+    ASSERT_TRUE(command.has_frame_ts);
+    EXPECT_EQ(command.frame_ts_ns, 123456789012345u);
+    ASSERT_TRUE(command.has_sequence);
+    EXPECT_EQ(command.sequence, 42u);
+    EXPECT_DOUBLE_EQ(command.throttle, 20.0);
+
+    // Sequences wrap at 32 bits
+    command = parseControl("seq:4294967297;frame_ts:-5;");
+    EXPECT_EQ(command.sequence, 1u);
+    EXPECT_FALSE(command.has_frame_ts);
+    EXPECT_FALSE(parseControl("throttle:1;").has_sequence);
+}
+
+TEST(KeyValueCodecTest, IgnoresUnknownKeysAndBadValues) {
+    auto command = parseControl(";;foo:1;throttle:abc;steering:1e2;speed:3;");
+    EXPECT_FALSE(command.has_throttle);
+    ASSERT_TRUE(command.has_steering);
+    EXPECT_DOUBLE_EQ(command.steering, 100.0);
+
+    command = parseControl("throttle:;steering:nan;auto_mode");
+    EXPECT_FALSE(command.has_throttle);
+    EXPECT_FALSE(command.has_steering);
+    EXPECT_FALSE(command.has_auto_mode);
+}
+
+TEST(KeyValueCodecTest, ParsesNumbers) {
+    double value = 0.0;
+    EXPECT_TRUE(parseDouble("0.1", value));
+    EXPECT_EQ(value, 0.1);
+    EXPECT_TRUE(parseDouble("-123.456", value));
+    EXPECT_EQ(value, -123.456);
+    EXPECT_TRUE(parseDouble("+7.", value));
+    EXPECT_EQ(value, 7.0);
+    EXPECT_TRUE(parseDouble(".5", value));
+    EXPECT_EQ(value, 0.5);
+    EXPECT_TRUE(parseDouble("1234567890.1234567", value));
+    EXPECT_EQ(value, 1234567890.1234567);
+    EXPECT_TRUE(parseDouble("-2.5e-3", value));
+    EXPECT_EQ(value, -2.5e-3);
+    EXPECT_FALSE(parseDouble("", value));
+    EXPECT_FALSE(parseDouble("-", value));
+    EXPECT_FALSE(parseDouble(".", value));
+    EXPECT_FALSE(parseDouble("1.2.3", value));
+    EXPECT_FALSE(parseDouble("12abc", value));
+    EXPECT_FALSE(parseDouble("inf", value));
+    EXPECT_FALSE(parseDouble("1e999", value));
+
+    int number = 0;
+    EXPECT_TRUE(parseInt("-42", number));
+    EXPECT_EQ(number, -42);
+    EXPECT_TRUE(parseInt(std::to_string(INT_MAX), number));
+    EXPECT_EQ(number, INT_MAX);
+    EXPECT_TRUE(parseInt(std::to_string(INT_MIN), number));
+    EXPECT_EQ(number, INT_MIN);
+    EXPECT_FALSE(parseInt("2147483648", number));
+    EXPECT_FALSE(parseInt("1.5", number));
+    EXPECT_FALSE(parseInt("+", number));
+
+    uint64_t unsigned_number = 0;
+    EXPECT_TRUE(parseUint64("18446744073709551615", unsigned_number));
+    EXPECT_EQ(unsigned_number, UINT64_MAX);
+    EXPECT_FALSE(parseUint64("18446744073709551616", unsigned_number));
+    EXPECT_FALSE(parseUint64("-1", unsigned_number));
+    EXPECT_FALSE(parseUint64("", unsigned_number));
+}
+
+TEST(KeyValueCodecTest, ParsesLaneAndTrafficSign) {
+    int lane = 5;
+    EXPECT_TRUE(parseLane("lane:-1;", lane));
+    EXPECT_EQ(lane, -1);
+    EXPECT_TRUE(parseLane("lane:2", lane));
+    EXPECT_EQ(lane, 2);
+    EXPECT_FALSE(parseLane("lane:", lane));
+    EXPECT_FALSE(parseLane("lane:1;extra", lane));
+    EXPECT_FALSE(parseLane("not_lane:1", lane));
+    EXPECT_EQ(lane, 2);
+
+    EXPECT_EQ(parseTrafficSign("traffic_sign:STOP;"), "STOP");
+    EXPECT_EQ(parseTrafficSign("YIELD"), "YIELD");
+    EXPECT_EQ(parseTrafficSign("traffic_sign:"), "traffic_sign:");
+}
+
+TEST(KeyValueCodecTest, WriterFormatsAndRoundTrips) {
+    MessageWriter<> writer;
+    writer.add(Key::Throttle, 12.5).add(Key::Steering, -30).add("mode", "1");
+    EXPECT_EQ(writer.view(), "throttle:12.5;steering:-30;mode:1;");
+    EXPECT_FALSE(writer.overflowed());
+
+    auto command = parseControl(writer.view());
+    EXPECT_DOUBLE_EQ(command.throttle, 12.5);
+    EXPECT_DOUBLE_EQ(command.steering, -30.0);
+
+    writer.clear();
+    EXPECT_TRUE(writer.view().empty());
+}
+
+TEST(KeyValueCodecTest, WriterDropsPairsThatDoNotFit) {
+    MessageWriter<16> writer;
+    writer.add("speed", 10).add("battery", 100);
+    EXPECT_EQ(writer.view(), "speed:10;");
+    EXPECT_TRUE(writer.overflowed());
+}
+
+// Parser this codec replaces: stringstream tokens into a hash map
+static std::unordered_map<std::string, double> parseWithStreams(const std::string& message) {
+    std::unordered_map<std::string, double> values;
+    std::stringstream ss(message);
+    std::string token;
+    while (std::getline(ss, token, ';')) {
+        if (token.empty())
+            continue;
+        std::string key;
+        double value;
+        std::stringstream ss_token(token);
+        std::getline(ss_token, key, ':');
+        ss_token >> value;
+        values[key] = value;
+    }
+    return values;
+}
+
+TEST(KeyValueCodecTest, ParsesWithoutAllocating) {
+    const std::string message = "throttle:42.5;steering:-17;auto_mode:1;";
+    constexpr int iterations = 100000;
+    double sink = 0.0;
+
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto command = parseControl(message);
+        sink += command.throttle + command.steering;
+    }
+    auto codec_time = std::chrono::steady_clock::now() - start;
+    size_t codec_allocations = allocations - before;
+
+    before = allocations;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto values = parseWithStreams(message);
+        sink += values["throttle"] + values["steering"];
+    }
+    auto stream_time = std::chrono::steady_clock::now() - start;
+    size_t stream_allocations = allocations - before;
+
+    before = allocations;
+    MessageWriter<> writer;
+    for (int i = 0; i < iterations; ++i) {
+        writer.clear();
+        writer.add(Key::Speed, i).add(Key::Battery, 87.5);
+        sink += writer.view().size();
+    }
+    size_t writer_allocations = allocations - before;
+
+    EXPECT_EQ(codec_allocations, 0u);
+    EXPECT_EQ(writer_allocations, 0u);
+    EXPECT_GT(stream_allocations, 0u);
+    EXPECT_NE(sink, 0.0);
+
+    auto per_message_ns = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / iterations;
+    };
+    std::cout << "Codec parse: " << per_message_ns(codec_time) << " ns/message, "
+              << codec_allocations / static_cast<double>(iterations)
+              << " allocations/message" << std::endl;
+    std::cout << "Stream parse: " << per_message_ns(stream_time) << " ns/message, "
+              << stream_allocations / static_cast<double>(iterations)
+              << " allocations/message" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "ControlAssembly.hpp"
+#include "LaneAssist.hpp"
+#include "LaneKeepingHandler.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "MockPublisher.hpp"
+#include "Reactor.hpp"
+#include "TestUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+int64_t at(int64_t ms) { return ms * 1000000; }
+
+LaneKeepingData lane(int status) {
+    LaneKeepingData data;
+    data.lane_status = status;
+    return data;
+}
+
+// Remembers when the steering last changed
+class RecordingServo : public MockFServo {
+public:
+    void set_steering(int angle) override {
+        MockFServo::set_steering(angle);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (angle != last) {
+            last = angle;
+            changed = Clock::now();
+        }
+    }
+    bool steeredTo(int angle, Clock::time_point &when) {
+        std::lock_guard<std::mutex> lock(mutex);
+        when = changed;
+        return last == angle;
+    }
+
+private:
+    std::mutex mutex;
+    int last = 0;
+    Clock::time_point changed;
+};
+
+} // namespace
+
+TEST(LaneAssistTest, RejectsInvalidConfiguration) {
+    LaneAssist::Config config;
+    config.max_correction = 60; // above max_steering
+    EXPECT_THROW(LaneAssist{config}, std::invalid_argument);
+    config = LaneAssist::Config();
+    config.initial = -1;
+    EXPECT_THROW(LaneAssist{config}, std::invalid_argument);
+    config = LaneAssist::Config();
+    config.max_steering = 91;
+    EXPECT_THROW(LaneAssist{config}, std::invalid_argument);
+}
+
+TEST(LaneAssistTest, SteersBackWithGrowingBoundedCorrection) {
+    LaneAssist assist; // 5 degrees, +20 per second, up to 15
+    EXPECT_EQ(assist.update(lane(0), at(0)), 0);
+
+    // Drifted left: steer right, more the longer it lasts
+    EXPECT_EQ(assist.update(lane(1), at(100)), 5);
+    EXPECT_EQ(assist.update(lane(1), at(300)), 9);
+    EXPECT_EQ(assist.update(lane(1), at(2000)), 15);
+
+    // Drifted right: steer left, from the initial correction again
+    EXPECT_EQ(assist.update(lane(2), at(2100)), -5);
+    EXPECT_EQ(assist.update(lane(2), at(2600)), -15);
+
+    EXPECT_EQ(assist.update(lane(0), at(2700)), 0);
+    EXPECT_EQ(assist.update(lane(2), at(2800)), -5);
+    // Unknown status counts as in the lane
+    EXPECT_EQ(assist.update(lane(7), at(2900)), 0);
+}
+
+// Lane messages through the LaneKeepingHandler on a reactor, as in main
+class LaneAssistPathTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        control.bind("inproc://lane-assist-control");
+        lanes.bind("inproc://lane-assist-lanes");
+        autonomy.bind("inproc://lane-assist-autonomous");
+        assembly = std::make_unique<ControlAssembly>("inproc://lane-assist-control", context,
+                                                     motors, servo, nullptr,
+                                                     "inproc://lane-assist-autonomous");
+        handler = std::make_unique<LaneKeepingHandler>("inproc://lane-assist-lanes", context,
+                                                       cluster);
+    }
+
+    void start() {
+        handler->setLaneCallback(
+            [this](const LaneKeepingData &data) { assembly->handleLaneKeeping(data); });
+        assembly->attachTo(reactor);
+        handler->attachTo(reactor);
+        assembly->start();
+        handler->start();
+        reactor.start();
+    }
+
+    void TearDown() override {
+        reactor.stop();
+        handler->stop();
+        assembly->stop();
+        handler.reset();
+        assembly.reset();
+        restoreOutput();
+    }
+
+    // PUB/SUB joins asynchronously; resend until `done`
+    template <typename Done>
+    bool resend(zmq::socket_t &socket, const std::string &message, Done done) {
+        return waitForCondition(
+            [&] {
+                socket.send(zmq::buffer(message), zmq::send_flags::none);
+                std::this_thread::sleep_for(5ms);
+                return done();
+            },
+            2000, 1);
+    }
+
+    zmq::context_t context{1};
+    zmq::socket_t control{context, zmq::socket_type::pub};
+    zmq::socket_t lanes{context, zmq::socket_type::pub};
+    zmq::socket_t autonomy{context, zmq::socket_type::pub};
+    std::shared_ptr<MockBackMotors> motors = std::make_shared<MockBackMotors>();
+    std::shared_ptr<RecordingServo> servo = std::make_shared<RecordingServo>();
+    std::shared_ptr<MockPublisher> cluster = std::make_shared<MockPublisher>();
+    std::unique_ptr<ControlAssembly> assembly;
+    std::unique_ptr<LaneKeepingHandler> handler;
+    Reactor reactor;
+};
+
+TEST_F(LaneAssistPathTest, DisabledByDefault) {
+    start();
+    ASSERT_TRUE(resend(control, "throttle:20;steering:10;", [&] {
+        return servo->getSteeringAngle() == 10;
+    }));
+    ASSERT_TRUE(resend(lanes, "lane:1;", [&] { return cluster->messageCount() > 0; }));
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(servo->getSteeringAngle(), 10);
+    EXPECT_EQ(assembly->getLaneAssistStats().updates, 0u);
+}
+
+TEST_F(LaneAssistPathTest, CorrectsDeparturesWithinMilliseconds) {
+    LaneAssist::Config config;
+    config.rate = 0; // a fixed correction, to compare angles
+    assembly->enableLaneAssist(config);
+    start();
+    EXPECT_THROW(assembly->enableLaneAssist(), std::logic_error);
+
+    ASSERT_TRUE(resend(control, "throttle:20;steering:10;", [&] {
+        return servo->getSteeringAngle() == 10;
+    }));
+    // Joins the lane subscriber; still in the lane
+    ASSERT_TRUE(resend(lanes, "lane:0;", [&] {
+        return assembly->getLaneAssistStats().updates > 0;
+    }));
+
+    std::vector<double> latencies_ms;
+    for (int i = 0; i < 20; ++i) {
+        int status = i % 2 == 0 ? 1 : 2;
+        int expected = status == 1 ? 15 : 5;
+        Clock::time_point sent = Clock::now();
+        lanes.send(zmq::buffer("lane:" + std::to_string(status) + ";"), zmq::send_flags::none);
+        Clock::time_point steered;
+        ASSERT_TRUE(waitForCondition([&] { return servo->steeredTo(expected, steered); }, 1000,
+                                     0));
+        latencies_ms.push_back(std::chrono::duration<double, std::milli>(steered - sent).count());
+
+        // Back in the lane: the driver's steering again
+        lanes.send(zmq::buffer(std::string("lane:0;")), zmq::send_flags::none);
+        ASSERT_TRUE(waitForCondition([&] { return servo->steeredTo(10, steered); }, 1000, 0));
+        std::this_thread::sleep_for(5ms);
+    }
+
+    // The driver steering meanwhile is blended, not overridden
+    lanes.send(zmq::buffer(std::string("lane:1;")), zmq::send_flags::none);
+    ASSERT_TRUE(waitForCondition([&] { return servo->getSteeringAngle() == 15; }, 1000, 1));
+    ASSERT_TRUE(resend(control, "throttle:20;steering:-20;", [&] {
+        return servo->getSteeringAngle() == -15;
+    }));
+
+    // Lane messages stop: the correction lapses
+    ASSERT_TRUE(waitForCondition([&] { return servo->getSteeringAngle() == -20; }, 1000, 1));
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    ControlAssembly::LaneAssistStats stats = assembly->getLaneAssistStats();
+    EXPECT_GE(stats.corrections, 40u);
+    EXPECT_GT(stats.assisted_ticks, 0u);
+    EXPECT_GE(stats.latency.count, 40u);
+    restoreOutput();
+    std::cout << "Lane message to steering: median " << latencies_ms[latencies_ms.size() / 2]
+              << "ms, max " << latencies_ms.back() << "ms (arbiter "
+              << stats.latency.toString() << ")" << std::endl;
+    suppressOutput();
+    // Reactor wake-up plus an immediate arbiter tick, not a 10ms poll each
+    if (!isRunningInCI()) {
+        EXPECT_LT(latencies_ms[latencies_ms.size() / 2], 2.0);
+        EXPECT_LE(stats.latency.percentileUs(90), 2000u);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include "BackMotors.hpp"
+#include "FServo.hpp"
+#include "Pca9685.hpp"
+#include "TestUtils.hpp"
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Register file of a PCA9685 that counts bus transactions and can be made
+// to fail
+class FakePca9685Device : public II2cDevice {
+public:
+    void writeBursts(const I2cBurst* bursts, size_t count) override {
+        if (fail) {
+            throw std::runtime_error("bus error");
+        }
+        transactions++;
+        std::vector<std::pair<uint8_t, size_t>> transaction;
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t b = 0; b < bursts[i].length; ++b) {
+                registers[(bursts[i].reg + b) & 0xFF] = bursts[i].data[b];
+            }
+            transaction.emplace_back(bursts[i].reg, bursts[i].length);
+            if (bursts[i].length == 1) {
+                writes.emplace_back(bursts[i].reg, bursts[i].data[0]);
+            }
+        }
+        last = transaction;
+    }
+
+    void readRegisters(uint8_t reg, uint8_t* out, size_t length) override {
+        transactions++;
+        for (size_t i = 0; i < length; ++i) {
+            out[i] = registers[(reg + i) & 0xFF];
+        }
+    }
+
+    uint16_t off(int channel) const {
+        return registers[0x08 + 4 * channel] | (registers[0x09 + 4 * channel] << 8);
+    }
+    uint16_t on(int channel) const {
+        return registers[0x06 + 4 * channel] | (registers[0x07 + 4 * channel] << 8);
+    }
+
+    bool fail = false;
+    int transactions = 0;
+    uint8_t registers[256] = {};
+    std::vector<std::pair<uint8_t, size_t>> last;     // (reg, length) per burst
+    std::vector<std::pair<uint8_t, uint8_t>> writes;  // single-byte writes
+};
+
+// setMotorPwm() as it was before the shared driver: four byte writes,
+// each its own bus transaction
+class ByteWiseBackMotors : public BackMotors {
+public:
+    bool setMotorPwm(const int channel, int value) override {
+        value = std::min(std::max(value, 0), 4095);
+        writeByteData(_fdMotor, 0x06 + 4 * channel, 0);
+        writeByteData(_fdMotor, 0x07 + 4 * channel, 0);
+        writeByteData(_fdMotor, 0x08 + 4 * channel, value & 0xFF);
+        writeByteData(_fdMotor, 0x09 + 4 * channel, value >> 8);
+        return true;
+    }
+    void emergencyBrake() override {
+        for (int channel = 0; channel < 16; ++channel) {
+            setMotorPwm(channel, 4095);
+        }
+    }
+    void writeByteData(int, uint8_t, uint8_t) override {
+        transactions++;
+    }
+    int transactions = 0;
+};
+
+class ByteWiseFServo : public FServo {
+public:
+    bool setServoPwm(const int channel, int on_value, int off_value) override {
+        writeByteData(_fdServo, 0x06 + 4 * channel, on_value & 0xFF);
+        writeByteData(_fdServo, 0x07 + 4 * channel, on_value >> 8);
+        writeByteData(_fdServo, 0x08 + 4 * channel, off_value & 0xFF);
+        writeByteData(_fdServo, 0x09 + 4 * channel, off_value >> 8);
+        return true;
+    }
+    void writeByteData(int, uint8_t, uint8_t) override {
+        transactions++;
+    }
+    int transactions = 0;
+};
+
+} // namespace
+
+class Pca9685Test : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        device = std::make_shared<FakePca9685Device>();
+    }
+
+    void TearDown() override { restoreOutput(); }
+
+    std::shared_ptr<FakePca9685Device> device;
+};
+
+TEST_F(Pca9685Test, PrescaleMatchesDatasheetFormula) {
+    EXPECT_EQ(Pca9685::prescaleFor(60), 100);
+    EXPECT_EQ(Pca9685::prescaleFor(50), 121);
+    EXPECT_EQ(Pca9685::prescaleFor(1), 255);
+    EXPECT_EQ(Pca9685::prescaleFor(5000), 3);
+}
+
+TEST_F(Pca9685Test, InitSleepsSetsPrescaleAndEnablesAutoIncrement) {
+    Pca9685 pwm(device);
+    pwm.init(50);
+
+    std::vector<std::pair<uint8_t, uint8_t>> expected{
+        {0x00, 0x30}, {0xFE, 121}, {0x01, 0x04}, {0x00, 0x21}, {0x00, 0xA1}};
+    EXPECT_EQ(device->writes, expected);
+}
+
+TEST_F(Pca9685Test, SetPwmIsOneBurstAndSkipsUnchangedValues) {
+    Pca9685 pwm(device);
+    pwm.setPwm(3, 0, 310);
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(device->last, (std::vector<std::pair<uint8_t, size_t>>{{0x06 + 12, 4}}));
+    EXPECT_EQ(device->off(3), 310);
+
+    pwm.setPwm(3, 0, 310);
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(pwm.getStats().skipped, 1u);
+
+    // attach()/invalidate() forget what the chip holds
+    pwm.invalidate();
+    pwm.setPwm(3, 0, 310);
+    EXPECT_EQ(device->transactions, 2);
+}
+
+TEST_F(Pca9685Test, BatchMergesShortGapsOfKnownChannels) {
+    Pca9685 pwm(device);
+    {
+        Pca9685::Batch batch(pwm);
+        for (int channel = 0; channel < Pca9685::kChannels; ++channel) {
+            pwm.setPwm(channel, 0, 0);
+        }
+    }
+    ASSERT_EQ(device->transactions, 1);
+
+    {
+        Pca9685::Batch batch(pwm);
+        pwm.setPwm(0, 0, 100);
+        pwm.setPwm(2, 0, 100);   // gap of one known channel: merged
+        pwm.setPwm(10, 0, 100);  // gap of seven: separate burst
+        EXPECT_EQ(device->transactions, 1);
+    }
+    EXPECT_EQ(device->transactions, 2);
+    EXPECT_EQ(device->last,
+              (std::vector<std::pair<uint8_t, size_t>>{{0x06, 12}, {0x06 + 40, 4}}));
+    EXPECT_EQ(device->off(1), 0);
+    EXPECT_EQ(device->off(2), 100);
+}
+
+TEST_F(Pca9685Test, NeverResendsChannelsItHasNotWritten) {
+    Pca9685 pwm(device);
+    {
+        Pca9685::Batch batch(pwm);
+        pwm.setPwm(0, 0, 100);
+        pwm.setPwm(2, 0, 100);
+    }
+    EXPECT_EQ(device->last,
+              (std::vector<std::pair<uint8_t, size_t>>{{0x06, 4}, {0x06 + 8, 4}}));
+}
+
+TEST_F(Pca9685Test, FailedFlushKeepsChannelsDirty) {
+    Pca9685 pwm(device);
+    device->fail = true;
+    EXPECT_THROW(pwm.setPwm(1, 0, 500), std::runtime_error);
+
+    device->fail = false;
+    pwm.setPwm(1, 0, 500);
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(device->off(1), 500);
+}
+
+TEST_F(Pca9685Test, WithoutDeviceWritesFail) {
+    Pca9685 pwm;
+    EXPECT_FALSE(pwm.isAttached());
+    EXPECT_THROW(pwm.setPwm(0, 0, 1), std::runtime_error);
+    EXPECT_THROW(pwm.init(60), std::runtime_error);
+    EXPECT_THROW(pwm.setPwm(16, 0, 1), std::out_of_range);
+
+    // Without an attached bus the motors report the error instead of writing
+    BackMotors motors;
+    EXPECT_FALSE(motors.setMotorPwm(0, 100));
+}
+
+TEST_F(Pca9685Test, BackMotorsSetSpeedIsOneTransaction) {
+    ByteWiseBackMotors before;
+    before.setSpeed(50);
+    EXPECT_EQ(before.transactions, 24);
+
+    BackMotors motors;
+    motors.attachDevice(device);
+    motors.setSpeed(50);
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(device->off(0), 1739);  // 50% with left compensation
+    EXPECT_EQ(device->off(2), 1739);
+    EXPECT_EQ(device->off(5), 2047);
+    EXPECT_EQ(device->off(7), 2047);
+
+    // Same command again touches nothing; reversing only the changed channels
+    motors.setSpeed(50);
+    EXPECT_EQ(device->transactions, 1);
+    motors.setSpeed(-50);
+    EXPECT_EQ(device->transactions, 2);
+    EXPECT_EQ(device->off(1), 1739);
+    EXPECT_EQ(device->off(2), 0);
+    EXPECT_EQ(device->off(5), 0);
+    EXPECT_EQ(device->off(6), 2047);
+
+    restoreOutput();
+    std::cout << "setSpeed: " << before.transactions << " -> 1 I2C transactions" << std::endl;
+    suppressOutput();
+}
+
+TEST_F(Pca9685Test, BackMotorsEmergencyBrakeIsOneTransaction) {
+    ByteWiseBackMotors before;
+    before.emergencyBrake();
+    EXPECT_EQ(before.transactions, 64);
+
+    BackMotors motors;
+    motors.attachDevice(device);
+    motors.emergencyBrake();
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(device->last, (std::vector<std::pair<uint8_t, size_t>>{{0xFA, 4}}));
+    EXPECT_EQ(motors.getPwmStats().bytes, 4u);
+
+    // The shadow follows the ALL_LED write, so releasing the brake only
+    // sends the channels that leave 4095
+    motors.setSpeed(0);
+    EXPECT_EQ(device->transactions, 2);
+    EXPECT_EQ(device->last, (std::vector<std::pair<uint8_t, size_t>>{{0x06, 32}}));
+}
+
+TEST_F(Pca9685Test, SetAllWritesAllLedRegistersAndDropsStagedChannels) {
+    Pca9685 pwm(device);
+    {
+        Pca9685::Batch batch(pwm);
+        pwm.setPwm(4, 0, 1000);
+        pwm.setAll(0, 4095);
+    }
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(device->registers[0xFC], 0xFF);
+    EXPECT_EQ(device->registers[0xFD], 0x0F);
+    for (int channel = 0; channel < Pca9685::kChannels; ++channel) {
+        EXPECT_EQ(pwm.getOff(channel), 4095);
+    }
+
+    pwm.setPwm(4, 0, 4095);
+    EXPECT_EQ(device->transactions, 1);
+
+    // After a failed ALL_LED write nothing is assumed about the chip
+    device->fail = true;
+    EXPECT_THROW(pwm.setAll(0, 0), std::runtime_error);
+    device->fail = false;
+    pwm.setPwm(4, 0, 4095);
+    EXPECT_EQ(device->transactions, 2);
+}
+
+TEST_F(Pca9685Test, ServoSteeringIsOneTransaction) {
+    ByteWiseFServo before;
+    before.set_steering(45);
+    EXPECT_EQ(before.transactions, 4);
+
+    FServo servo;
+    servo.attachDevice(device);
+    servo.set_steering(45);
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(device->off(0), 385);
+
+    servo.set_steering(45);
+    EXPECT_EQ(device->transactions, 1);
+    EXPECT_EQ(servo.getPwmStats().skipped, 1u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -10,9 +10,16 @@
 #include <chrono>
 #include <atomic>
 #include <vector>
+#include <map>
 #include <mutex>
 #include <zmq.hpp>
 #include "../../zmq/inc/ZmqPublisher.hpp"
+#include "ShmTransport.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <sys/resource.h>
+#include <unistd.h>
 
 class PerformanceTest : public ::testing::Test {
 protected:
@@ -69,6 +76,256 @@ TEST_F(PerformanceTest, SensorHandlerThroughput) {
     EXPECT_GT(mock_nc_publisher->messageCount(), 0);
 }
 
+namespace {
+
+// Critical sensor with one channel that changes on every read ("live") and
+// one that never changes but is flagged updated every read ("still"), as
+// Speed used to do
+class ChurnSensor : public ISensor {
+public:
+    ChurnSensor() : _name("churn") {
+        _sensorData["live"] = std::make_shared<SensorData>("live", true);
+        _sensorData["still"] = std::make_shared<SensorData>("still", true);
+        _sensorData["still"]->value.store(7);
+    }
+
+    const std::string& getName() const override { return _name; }
+
+    std::unordered_map<std::string, std::shared_ptr<SensorData>> getSensorData() const override {
+        return _sensorData;
+    }
+
+    void updateSensorData() override {
+        unsigned int next = ++_value;
+        {
+            std::lock_guard<std::mutex> lock(_timesMutex);
+            _updateTimes[next] = std::chrono::steady_clock::now();
+        }
+        _sensorData["live"]->oldValue.store(next - 1);
+        _sensorData["live"]->value.store(next);
+        _sensorData["live"]->timestamp = std::chrono::steady_clock::now();
+        _sensorData["live"]->updated.store(true);
+        _sensorData["still"]->updated.store(true);
+    }
+
+    bool updateTime(unsigned int value, std::chrono::steady_clock::time_point& out) {
+        std::lock_guard<std::mutex> lock(_timesMutex);
+        auto it = _updateTimes.find(value);
+        if (it == _updateTimes.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+private:
+    void readSensor() override {}
+    void checkUpdated() override {}
+
+    std::string _name;
+    std::unordered_map<std::string, std::shared_ptr<SensorData>> _sensorData;
+    unsigned int _value = 0;
+    std::mutex _timesMutex;
+    std::map<unsigned int, std::chrono::steady_clock::time_point> _updateTimes;
+};
+
+// Records arrival time of every message
+class TimingPublisher : public IPublisher {
+public:
+    void send(const std::string& message) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        arrivals.emplace_back(message, std::chrono::steady_clock::now());
+    }
+
+    std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> getArrivals() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return arrivals;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::chrono::steady_clock::time_point>> arrivals;
+};
+
+} // namespace
+
+TEST_F(PerformanceTest, CriticalPublishLatencyAndVolume) {
+    auto timing_publisher = std::make_shared<TimingPublisher>();
+    auto sensor_handler = std::make_unique<SensorHandler>(
+        "tcp://127.0.0.1:5572",
+        "tcp://127.0.0.1:5573",
+        *zmq_context,
+        timing_publisher,
+        mock_nc_publisher,
+        false
+    );
+    auto churn = std::make_shared<ChurnSensor>();
+    sensor_handler->addSensor("churn", churn);
+
+    sensor_handler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    sensor_handler->stop();
+
+    size_t live_messages = 0;
+    size_t still_messages = 0;
+    double total_latency_us = 0.0;
+    double max_latency_us = 0.0;
+    size_t latency_samples = 0;
+    for (const auto& [message, arrival] : timing_publisher->getArrivals()) {
+        if (message.rfind("still:", 0) == 0) {
+            still_messages++;
+        } else if (message.rfind("live:", 0) == 0) {
+            live_messages++;
+            unsigned int value = std::stoul(message.substr(5));
+            std::chrono::steady_clock::time_point updated_at;
+            if (churn->updateTime(value, updated_at)) {
+                double latency_us = std::chrono::duration<double, std::micro>(
+                    arrival - updated_at).count();
+                total_latency_us += latency_us;
+                max_latency_us = std::max(max_latency_us, latency_us);
+                latency_samples++;
+            }
+        }
+    }
+
+    double avg_latency_us = latency_samples ? total_latency_us / latency_samples : 0.0;
+    std::cout << "Critical channel over 1s: live=" << live_messages
+              << " still=" << still_messages
+              << " avg latency=" << avg_latency_us << "us"
+              << " max latency=" << max_latency_us << "us" << std::endl;
+
+    EXPECT_GT(live_messages, 5u);
+    // An unchanged value goes out once, not on every tick
+    EXPECT_LE(still_messages, 1u);
+    // Changes are published on detection, not on the next polling tick
+    EXPECT_LT(avg_latency_us, 10000.0);
+}
+
+namespace {
+
+struct TransportResult {
+    size_t received = 0;
+    double avg_latency_us = 0.0;
+    double p99_latency_us = 0.0;
+    double cpu_us_per_message = 0.0;
+};
+
+double processCpuUs() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 +
+           usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Sends `count` paced messages carrying their send time; the receiver blocks
+// in recv() and records one-way latency. CPU covers both sides of the link.
+TransportResult runTransport(const std::function<void(const std::string&)>& send,
+                             const std::function<std::string(int)>& receive,
+                             size_t count) {
+    std::vector<double> latencies;
+    latencies.reserve(count);
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done || latencies.size() < count) {
+            std::string message = receive(100);
+            if (message.empty()) {
+                if (done) break;
+                continue;
+            }
+            latencies.push_back((nowNs() - std::stoll(message)) / 1000.0);
+        }
+    });
+
+    double cpu_start = processCpuUs();
+    for (size_t i = 0; i < count; ++i) {
+        send(std::to_string(nowNs()));
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    done = true;
+    reader.join();
+    double cpu_used = processCpuUs() - cpu_start;
+
+    TransportResult result;
+    result.received = latencies.size();
+    if (!latencies.empty()) {
+        double total = 0.0;
+        for (double l : latencies) total += l;
+        result.avg_latency_us = total / latencies.size();
+        std::sort(latencies.begin(), latencies.end());
+        result.p99_latency_us = latencies[latencies.size() * 99 / 100];
+        result.cpu_us_per_message = cpu_used / latencies.size();
+    }
+    return result;
+}
+
+TransportResult runZmqTransport(zmq::context_t& context, const std::string& endpoint,
+                                size_t count) {
+    zmq::socket_t pub(context, zmq::socket_type::pub);
+    zmq::socket_t sub(context, zmq::socket_type::sub);
+    pub.set(zmq::sockopt::linger, 0);
+    sub.set(zmq::sockopt::linger, 0);
+    pub.bind(endpoint);
+    // Resolves a wildcard tcp port to the one actually bound
+    sub.connect(pub.get(zmq::sockopt::last_endpoint));
+    sub.set(zmq::sockopt::subscribe, "");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200)); // slow joiner
+
+    return runTransport(
+        [&](const std::string& message) {
+            pub.send(zmq::message_t(message.data(), message.size()),
+                     zmq::send_flags::none);
+        },
+        [&](int timeout_ms) {
+            zmq::pollitem_t items[] = {{static_cast<void*>(sub), 0, ZMQ_POLLIN, 0}};
+            zmq::poll(&items[0], 1, std::chrono::milliseconds(timeout_ms));
+            zmq::message_t msg;
+            if (!(items[0].revents & ZMQ_POLLIN) ||
+                !sub.recv(msg, zmq::recv_flags::dontwait)) {
+                return std::string();
+            }
+            return msg.to_string();
+        },
+        count);
+}
+
+} // namespace
+
+TEST_F(PerformanceTest, TransportLatencyAndCpuComparison) {
+    SKIP_IN_CI();
+    constexpr size_t kMessages = 2000;
+    const std::string suffix = std::to_string(getpid());
+    const std::string ipc_path = "/tmp/perf_transport_" + suffix;
+
+    std::map<std::string, TransportResult> results;
+    // Any free port, so parallel runs do not collide
+    results["tcp"] = runZmqTransport(*zmq_context, "tcp://127.0.0.1:*", kMessages);
+    results["ipc"] = runZmqTransport(*zmq_context, "ipc://" + ipc_path, kMessages);
+    std::remove(ipc_path.c_str());
+    {
+        ShmPublisher publisher("shm://perf_transport_" + suffix);
+        ShmSubscriber subscriber("shm://perf_transport_" + suffix);
+        results["shm"] = runTransport(
+            [&](const std::string& message) { publisher.send(message); },
+            [&](int timeout_ms) { return subscriber.receive(timeout_ms); },
+            kMessages);
+    }
+
+    for (const auto& [name, result] : results) {
+        std::cout << name << ": received=" << result.received
+                  << " avg latency=" << result.avg_latency_us << "us"
+                  << " p99 latency=" << result.p99_latency_us << "us"
+                  << " cpu/msg=" << result.cpu_us_per_message << "us" << std::endl;
+        EXPECT_GE(result.received, kMessages * 9 / 10) << name;
+    }
+    // The ring is never lapped at this rate, so nothing is lost
+    EXPECT_EQ(results["shm"].received, kMessages);
+}
+
 TEST_F(PerformanceTest, ControlAssemblyResponseTime) {
     SKIP_IN_CI();
 
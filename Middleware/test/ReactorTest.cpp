@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "Reactor.hpp"
+#include "MockPublisher.hpp"
+#include "TestUtils.hpp"
+#include "TrafficSignHandler.hpp"
+#include "ZmqSubscriber.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <zmq.hpp>
+
+using namespace std::chrono_literals;
+
+class ReactorTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        for (int i = 0; i < 2; ++i) {
+            publishers[i].set(zmq::sockopt::linger, 0);
+            publishers[i].bind("inproc://reactor-test-" + std::to_string(i));
+        }
+    }
+
+    void TearDown() override {
+        reactor.stop();
+        for (auto& publisher : publishers) {
+            publisher.close();
+        }
+        restoreOutput();
+    }
+
+    void publish(int index, const std::string& message) {
+        publishers[index].send(zmq::message_t(message.data(), message.size()),
+                               zmq::send_flags::none);
+    }
+
+    zmq::context_t context{1};
+    zmq::socket_t publishers[2] = {{context, zmq::socket_type::pub},
+                                   {context, zmq::socket_type::pub}};
+    Reactor reactor;
+};
+
+TEST_F(ReactorTest, RejectsInvalidRegistrations) {
+    EXPECT_THROW(reactor.addSocket(nullptr, [] {}), std::invalid_argument);
+    EXPECT_THROW(reactor.addTimer(0ms, [] {}), std::invalid_argument);
+}
+
+TEST_F(ReactorTest, SocketHandlerRunsWhenReadable) {
+    ZmqSubscriber subscriber("inproc://reactor-test-0", context);
+    ASSERT_NE(subscriber.handle(), nullptr);
+
+    std::string received;
+    reactor.addSocket(subscriber.handle(), [&] {
+        subscriber.drain([&](std::string_view message) { received = message; });
+    });
+
+    EXPECT_EQ(reactor.runOnce(10ms), 0u);
+
+    publish(0, "lane:1;");
+    EXPECT_EQ(reactor.runOnce(500ms), 1u);
+    EXPECT_EQ(received, "lane:1;");
+}
+
+TEST_F(ReactorTest, FdHandlerRunsWhenReadable) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    int reads = 0;
+    reactor.addFd(fds[0], [&] {
+        char byte;
+        ASSERT_EQ(read(fds[0], &byte, 1), 1);
+        reads++;
+    });
+
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+    EXPECT_EQ(reactor.runOnce(500ms), 1u);
+    EXPECT_EQ(reads, 1);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_F(ReactorTest, TimersFireOnSchedule) {
+    std::atomic<int> fast{0};
+    std::atomic<int> slow{0};
+    reactor.addTimer(10ms, [&] { fast++; });
+    reactor.addTimer(1000ms, [&] { slow++; });
+
+    // The poll timeout tracks the nearest timer, so one call waits for it
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(reactor.runOnce(std::chrono::milliseconds(-1)), 1u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 10ms);
+    EXPECT_EQ(fast.load(), 1);
+
+    reactor.start();
+    EXPECT_TRUE(waitForCondition([&] { return fast.load() >= 5; }, 2000, 5));
+    reactor.stop();
+    EXPECT_EQ(slow.load(), 0);
+}
+
+TEST_F(ReactorTest, StopWakesIdleLoop) {
+    // No timers: the loop blocks in poll until stop() signals the eventfd
+    reactor.start();
+    EXPECT_TRUE(reactor.isRunning());
+    std::this_thread::sleep_for(20ms);
+
+    auto start = std::chrono::steady_clock::now();
+    reactor.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+    EXPECT_FALSE(reactor.isRunning());
+}
+
+TEST_F(ReactorTest, StopBeforeRunIsNotLost) {
+    // The owner stops before the runner thread reaches run()
+    std::atomic<bool> returned{false};
+    reactor.stop();
+    std::thread runner([&] {
+        reactor.run();
+        returned = true;
+    });
+    bool stopped = waitForCondition([&] { return returned.load(); }, 1000, 5);
+    if (!stopped) {
+        reactor.stop(); // do not hang the test on failure
+    }
+    runner.join();
+    EXPECT_TRUE(stopped);
+    EXPECT_FALSE(reactor.isRunning());
+
+    // The stop was consumed: the reactor runs again, here until a handler
+    // stops it
+    std::atomic<int> ticks{0};
+    reactor.addTimer(5ms, [&] {
+        if (++ticks == 3) {
+            reactor.stop();
+        }
+    });
+    reactor.run();
+    EXPECT_EQ(ticks.load(), 3);
+
+    // start() after a stop() of an idle reactor still runs
+    reactor.stop();
+    reactor.start();
+    EXPECT_TRUE(waitForCondition([&] { return ticks.load() >= 6; }, 2000, 5));
+    EXPECT_TRUE(reactor.isRunning());
+}
+
+TEST_F(ReactorTest, HandlerExceptionDoesNotStopLoop) {
+    std::atomic<int> ticks{0};
+    reactor.addTimer(5ms, [&] {
+        ticks++;
+        throw std::runtime_error("handler failure");
+    });
+    reactor.start();
+    EXPECT_TRUE(waitForCondition([&] { return ticks.load() >= 3; }, 2000, 5));
+    reactor.stop();
+}
+
+TEST_F(ReactorTest, OneThreadServesAllSubscribers) {
+    ZmqSubscriber first("inproc://reactor-test-0", context);
+    ZmqSubscriber second("inproc://reactor-test-1", context);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> received{0};
+    auto handlerFor = [&](ZmqSubscriber& subscriber) {
+        return [&] {
+            subscriber.drain([&](std::string_view) {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+                received++;
+            });
+        };
+    };
+    reactor.addSocket(first.handle(), handlerFor(first));
+    reactor.addSocket(second.handle(), handlerFor(second));
+    reactor.start();
+
+    for (int i = 0; i < 10; ++i) {
+        publish(i % 2, "value:" + std::to_string(i) + ";");
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_TRUE(waitForCondition([&] { return received.load() >= 10; }, 2000, 5));
+    reactor.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(threads.size(), 1u);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0u);
+}
+
+TEST_F(ReactorTest, TrafficSignHandlerReceivesOnReactor) {
+    auto nc_publisher = std::make_shared<MockPublisher>();
+    TrafficSignHandler handler("inproc://reactor-test-0", context, nc_publisher);
+    handler.attachTo(reactor);
+    handler.start();
+    reactor.start();
+
+    // Publish until the subscription has propagated
+    EXPECT_TRUE(waitForCondition([&] {
+        publish(0, "traffic_sign:STOP");
+        return nc_publisher->hasMessage("sign:stop");
+    }, 2000, 10));
+
+    // Messages arriving after stop() are drained but not handled
+    handler.stop();
+    nc_publisher->clearMessages();
+    publish(0, "traffic_sign:YIELD");
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(nc_publisher->messageCount(), 0u);
+
+    reactor.stop();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
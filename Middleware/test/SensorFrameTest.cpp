@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "SensorFrame.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace sensor_frame;
+
+TEST(SensorFrameTest, RoundTrip) {
+    Record records[] = {
+        {Channel::Speed, 123, 1000000001ULL},
+        {Channel::Battery, 87, 0xFFFFFFFF00000002ULL},
+        {Channel::Obstacle, 0xFFFFFFFFu, 3},
+    };
+    uint8_t buffer[kMaxFrameSize];
+    size_t size = encode(42, records, 3, buffer, sizeof(buffer));
+    ASSERT_EQ(size, encodedSize(3));
+    EXPECT_EQ(size, 56u);
+    EXPECT_TRUE(isFrame(buffer, size));
+
+    Header header{};
+    std::vector<Record> decoded;
+    ASSERT_TRUE(decode(buffer, size, header,
+                       [&](const Record& r) { decoded.push_back(r); }));
+    EXPECT_EQ(header.sequence, 42u);
+    EXPECT_EQ(header.count, 3u);
+    ASSERT_EQ(decoded.size(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(decoded[i].channel, records[i].channel);
+        EXPECT_EQ(decoded[i].value, records[i].value);
+        EXPECT_EQ(decoded[i].timestamp_ns, records[i].timestamp_ns);
+    }
+}
+
+TEST(SensorFrameTest, LittleEndianLayout) {
+    Record record{Channel::Speed, 0x01020304u, 0};
+    uint8_t buffer[kMaxFrameSize];
+    ASSERT_EQ(encode(0x0A0B0C0Du, &record, 1, buffer, sizeof(buffer)), 24u);
+    EXPECT_EQ(buffer[0], kMagic);
+    EXPECT_EQ(buffer[1], kVersion);
+    EXPECT_EQ(buffer[2], 1);
+    EXPECT_EQ(buffer[3], 0);
+    EXPECT_EQ(buffer[4], 0x0D);
+    EXPECT_EQ(buffer[7], 0x0A);
+    EXPECT_EQ(buffer[8], static_cast<uint8_t>(Channel::Speed));
+    EXPECT_EQ(buffer[12], 0x04);
+    EXPECT_EQ(buffer[15], 0x01);
+}
+
+TEST(SensorFrameTest, RejectsMalformedFrames) {
+    Record record{Channel::Odo, 5, 6};
+    uint8_t buffer[kMaxFrameSize];
+    size_t size = encode(1, &record, 1, buffer, sizeof(buffer));
+    Header header{};
+    auto ignore = [](const Record&) {};
+
+    EXPECT_FALSE(decode(buffer, size - 1, header, ignore)); // truncated
+    EXPECT_FALSE(decode(buffer, kHeaderSize - 1, header, ignore));
+
+    buffer[1] = kVersion + 1;
+    EXPECT_FALSE(decode(buffer, size, header, ignore));
+    buffer[1] = kVersion;
+
+    buffer[0] = 's';
+    EXPECT_FALSE(isFrame(buffer, size));
+    EXPECT_FALSE(decode(buffer, size, header, ignore));
+
+    const char text[] = "speed:10;";
+    EXPECT_FALSE(isFrame(text, sizeof(text) - 1));
+}
+
+TEST(SensorFrameTest, EncodeRespectsCapacity) {
+    Record records[kMaxRecords + 1] = {};
+    uint8_t buffer[kMaxFrameSize];
+    EXPECT_EQ(encode(0, records, kMaxRecords + 1, buffer, sizeof(buffer)), 0u);
+    EXPECT_EQ(encode(0, records, 2, buffer, encodedSize(2) - 1), 0u);
+    EXPECT_EQ(encode(0, records, kMaxRecords, buffer, sizeof(buffer)),
+              kMaxFrameSize);
+}
+
+TEST(SensorFrameTest, ChannelNames) {
+    for (const char* name : {"speed", "odo", "battery", "charging", "obs"}) {
+        Channel channel = channelFromName(name);
+        EXPECT_NE(channel, Channel::Unknown) << name;
+        EXPECT_STREQ(channelName(channel), name);
+    }
+    EXPECT_EQ(channelFromName("test"), Channel::Unknown);
+    EXPECT_STREQ(channelName(Channel::Unknown), "unknown");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
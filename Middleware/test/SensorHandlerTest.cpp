@@ -534,6 +534,185 @@ TEST_F(SensorHandlerTest, ComplexStartStopCycles) {
     EXPECT_GT(nc_publisher->messageCount(), 0);
 }
 
+TEST_F(SensorHandlerTest, UnchangedValueNotRepublished) {
+    // Sensor that raises updated on every read without changing its value
+    class StuckSensor : public ISensor {
+    public:
+        StuckSensor() : _name("stuck") {
+            _sensorData["stuck"] = std::make_shared<SensorData>("stuck", true);
+            _sensorData["stuck"]->value.store(5);
+        }
+        const std::string& getName() const override { return _name; }
+        std::unordered_map<std::string, std::shared_ptr<SensorData>> getSensorData() const override {
+            return _sensorData;
+        }
+        void updateSensorData() override { _sensorData.at("stuck")->updated.store(true); }
+
+    private:
+        void readSensor() override {}
+        void checkUpdated() override {}
+        std::string _name;
+        std::unordered_map<std::string, std::shared_ptr<SensorData>> _sensorData;
+    };
+
+    sensor_handler->addSensor("stuck", std::make_shared<StuckSensor>());
+    sensor_handler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    sensor_handler->stop();
+
+    size_t stuck_messages = 0;
+    for (const auto& msg : c_publisher->getMessages()) {
+        if (msg == "stuck:5;") {
+            stuck_messages++;
+        }
+    }
+    EXPECT_EQ(stuck_messages, 1u);
+}
+
+TEST_F(SensorHandlerTest, PublishStatsCountMessages) {
+    auto criticalSensor = std::make_shared<MockSensor>("stats_c", true);
+    auto nonCriticalSensor = std::make_shared<MockSensor>("stats_nc", false);
+    sensor_handler->addSensor("stats_c", criticalSensor);
+    sensor_handler->addSensor("stats_nc", nonCriticalSensor);
+
+    sensor_handler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    sensor_handler->stop();
+
+    auto stats = sensor_handler->getPublishStats();
+    EXPECT_EQ(stats.critical_messages, c_publisher->messageCount() - 2);     // minus init
+    EXPECT_EQ(stats.non_critical_messages, nc_publisher->messageCount() - 2); // minus init
+    EXPECT_GT(stats.critical_messages, 0u);
+    // Critical changes are sent on detection, well inside one read period
+    EXPECT_LT(stats.critical_latency_avg_us, 50000u);
+    EXPECT_GE(stats.critical_latency_max_us, stats.critical_latency_avg_us);
+}
+
+TEST_F(SensorHandlerTest, PushedDataWakesReader) {
+    // Receives values on another thread like the CAN sensors and notifies
+    class PushSensor : public ISensor {
+    public:
+        PushSensor() : _name("pushed") {
+            _sensorData["pushed"] = std::make_shared<SensorData>("pushed", true);
+        }
+        const std::string& getName() const override { return _name; }
+        std::unordered_map<std::string, std::shared_ptr<SensorData>> getSensorData() const override {
+            return _sensorData;
+        }
+        void push(unsigned int value) {
+            _pending.store(value);
+            notifyUpdate();
+        }
+        void updateSensorData() override {
+            unsigned int value = _pending.load();
+            if (value != _sensorData.at("pushed")->value.load()) {
+                _sensorData.at("pushed")->value.store(value);
+                _sensorData.at("pushed")->updated.store(true);
+            }
+        }
+
+    private:
+        void readSensor() override {}
+        void checkUpdated() override {}
+        std::string _name;
+        std::unordered_map<std::string, std::shared_ptr<SensorData>> _sensorData;
+        std::atomic<unsigned int> _pending{0};
+    };
+
+    auto sensor = std::make_shared<PushSensor>();
+    sensor_handler->addSensor("pushed", sensor);
+    sensor_handler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto published = [&](const std::string& message) {
+        for (const auto& msg : c_publisher->getMessages()) {
+            if (msg == message) {
+                return true;
+            }
+        }
+        return false;
+    };
+    // Pushed at different points of the 50ms read interval
+    std::chrono::duration<double, std::milli> total{0};
+    const int pushes = 10;
+    for (int i = 1; i <= pushes; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(7 * i));
+        auto pushed_at = std::chrono::steady_clock::now();
+        sensor->push(i);
+        std::string expected = "pushed:" + std::to_string(i) + ";";
+        while (!published(expected) &&
+               std::chrono::steady_clock::now() - pushed_at < std::chrono::seconds(1)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        ASSERT_TRUE(published(expected));
+        total += std::chrono::steady_clock::now() - pushed_at;
+    }
+    sensor_handler->stop();
+
+    std::cout << "Push to critical publish: avg " << total.count() / pushes << "ms"
+              << std::endl;
+    // Waiting out the read interval would average about 25ms
+    EXPECT_LT(total.count() / pushes, 10.0);
+}
+
+TEST_F(SensorHandlerTest, BinaryCriticalFrame) {
+    class SpeedLikeSensor : public ISensor {
+    public:
+        SpeedLikeSensor() {
+            _data["speed"] = std::make_shared<SensorData>("speed", true);
+            _data["test"] = std::make_shared<SensorData>("test", true);
+        }
+        const std::string& getName() const override { return _name; }
+        std::unordered_map<std::string, std::shared_ptr<SensorData>> getSensorData() const override {
+            return _data;
+        }
+        void updateSensorData() override {
+            ++_value;
+            for (auto& entry : _data) {
+                entry.second->value.store(_value);
+                entry.second->timestamp = std::chrono::steady_clock::now();
+                entry.second->updated.store(true);
+            }
+        }
+    private:
+        void readSensor() override {}
+        void checkUpdated() override {}
+        std::string _name = "speed_like";
+        std::unordered_map<std::string, std::shared_ptr<SensorData>> _data;
+        unsigned int _value = 0;
+    };
+
+    sensor_handler->setCriticalWireFormat(SensorHandler::WireFormat::Binary);
+    sensor_handler->addSensor("speed_like", std::make_shared<SpeedLikeSensor>());
+    c_publisher->clearMessages();
+
+    sensor_handler->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    sensor_handler->stop();
+
+    // start() re-announces with the text "init;" marker
+    auto messages = c_publisher->getMessages();
+    ASSERT_GT(messages.size(), 1u);
+    EXPECT_EQ(messages.front(), "init;");
+    messages.erase(messages.begin());
+    uint32_t last_value = 0;
+    uint32_t expected_sequence = 0;
+    for (const auto& message : messages) {
+        sensor_frame::Header header{};
+        std::vector<sensor_frame::Record> records;
+        ASSERT_TRUE(sensor_frame::decode(
+            message.data(), message.size(), header,
+            [&](const sensor_frame::Record& r) { records.push_back(r); }));
+        EXPECT_EQ(header.sequence, expected_sequence++);
+        // "test" has no channel id and is left out of the frame
+        ASSERT_EQ(records.size(), 1u);
+        EXPECT_EQ(records[0].channel, sensor_frame::Channel::Speed);
+        EXPECT_GT(records[0].value, last_value);
+        last_value = records[0].value;
+    }
+    EXPECT_EQ(sensor_handler->getPublishStats().critical_messages, messages.size());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "ShmTransport.hpp"
+#include "Transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// Unique per process so parallel test runs do not share rings
+std::string endpoint(const std::string& name) {
+    return "shm://shm_test_" + name + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+TEST(ShmTransportTest, ObjectName) {
+    EXPECT_EQ(shm_ring::objectName("shm://cluster"), "/cluster");
+    EXPECT_EQ(shm_ring::objectName("cluster"), "/cluster");
+    EXPECT_EQ(shm_ring::objectName("/cluster"), "/cluster");
+}
+
+TEST(ShmTransportTest, DeliversInOrder) {
+    ShmPublisher publisher(endpoint("order"));
+    ASSERT_TRUE(publisher.isConnected());
+    ShmSubscriber subscriber(endpoint("order"));
+    ASSERT_TRUE(subscriber.isConnected());
+
+    EXPECT_EQ(subscriber.receive(), "");
+    for (int i = 0; i < 10; ++i) {
+        publisher.send("speed:" + std::to_string(i) + ";");
+    }
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(subscriber.receive(), "speed:" + std::to_string(i) + ";");
+    }
+    EXPECT_EQ(subscriber.receive(), "");
+    EXPECT_EQ(subscriber.getDropped(), 0u);
+    EXPECT_EQ(publisher.getSequence(), 10u);
+}
+
+TEST(ShmTransportTest, SlowReaderSkipsAheadAndCountsDrops) {
+    ShmPublisher publisher(endpoint("lap"), 8, 64);
+    ShmSubscriber subscriber(endpoint("lap"));
+
+    for (int i = 0; i < 20; ++i) {
+        publisher.send(std::to_string(i));
+    }
+    // Only the last 8 are still in the ring
+    EXPECT_EQ(subscriber.receive(), "12");
+    EXPECT_EQ(subscriber.getDropped(), 12u);
+    for (int i = 13; i < 20; ++i) {
+        EXPECT_EQ(subscriber.receive(), std::to_string(i));
+    }
+}
+
+TEST(ShmTransportTest, OversizedMessageRejected) {
+    ShmPublisher publisher(endpoint("big"), 4, 16);
+    ShmSubscriber subscriber(endpoint("big"));
+
+    publisher.send(std::string(17, 'x'));
+    publisher.send(std::string(16, 'y'));
+    EXPECT_EQ(subscriber.receive(), std::string(16, 'y'));
+    EXPECT_EQ(publisher.getSequence(), 1u);
+}
+
+TEST(ShmTransportTest, SubscriberAttachesLazily) {
+    ShmSubscriber subscriber(endpoint("late"));
+    EXPECT_FALSE(subscriber.isConnected());
+    EXPECT_EQ(subscriber.receive(5), "");
+
+    ShmPublisher publisher(endpoint("late"));
+    EXPECT_EQ(subscriber.receive(), ""); // attaches, sees only new messages
+    EXPECT_TRUE(subscriber.isConnected());
+    publisher.send("odo:1;");
+    EXPECT_EQ(subscriber.receive(), "odo:1;");
+}
+
+TEST(ShmTransportTest, BlockingReceiveWakesOnPublish) {
+    ShmPublisher publisher(endpoint("wake"));
+    ShmSubscriber subscriber(endpoint("wake"));
+
+    std::atomic<bool> received{false};
+    auto start = std::chrono::steady_clock::now();
+    std::thread reader([&] {
+        received = subscriber.receive(2000) == "battery:80;";
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    publisher.send("battery:80;");
+    reader.join();
+
+    EXPECT_TRUE(received);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+
+    // Nothing published: the wait times out
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(subscriber.receive(30), "");
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+}
+
+TEST(ShmTransportTest, FactorySelectsTransportByScheme) {
+    zmq::context_t context(1);
+    EXPECT_TRUE(isShmEndpoint("shm://x"));
+    EXPECT_FALSE(isShmEndpoint("tcp://127.0.0.1:5555"));
+
+    auto publisher = createPublisher(endpoint("factory"), context);
+    auto subscriber = createSubscriber(endpoint("factory"), context);
+    EXPECT_NE(dynamic_cast<ShmPublisher*>(publisher.get()), nullptr);
+    EXPECT_NE(dynamic_cast<ShmSubscriber*>(subscriber.get()), nullptr);
+    publisher->send("sign:stop");
+    EXPECT_EQ(subscriber->receive(100), "sign:stop");
+
+    auto zmq_publisher = createPublisher("inproc://factory", context);
+    EXPECT_NE(dynamic_cast<ZmqPublisher*>(zmq_publisher.get()), nullptr);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
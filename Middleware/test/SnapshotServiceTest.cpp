@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "SnapshotService.hpp"
+#include "MockPublisher.hpp"
+#include "SensorFrame.hpp"
+#include "StatePublisher.hpp"
+#include "TelemetryPolicyPublisher.hpp"
+#include <memory>
+#include <string>
+
+class SnapshotServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        context = std::make_unique<zmq::context_t>(1);
+        service = std::make_unique<SnapshotService>("inproc://snapshot", *context,
+                                                    true);
+    }
+
+    void TearDown() override {
+        service.reset();
+        context.reset();
+    }
+
+    std::unique_ptr<zmq::context_t> context;
+    std::unique_ptr<SnapshotService> service;
+};
+
+TEST_F(SnapshotServiceTest, EmptySnapshot) {
+    EXPECT_EQ(service->snapshot(), "seq:0;");
+}
+
+TEST_F(SnapshotServiceTest, TapRecordsBeforeForwarding) {
+    auto inner = std::make_shared<MockPublisher>();
+    auto publisher = service->tap(inner);
+
+    publisher->send("init;");
+    publisher->send("odo:120;");
+    publisher->send("charging:1;");
+    publisher->send("odo:125;");
+    publisher->send("sign:stop");
+
+    EXPECT_EQ(inner->messageCount(), 5u);
+    EXPECT_EQ(service->getSequence(), 4u);
+    EXPECT_EQ(service->snapshot(), "seq:4;charging:1;odo:125;sign:stop;");
+}
+
+// As wired in main: telemetry policies in front of the tap, state
+// publishers straight into it
+TEST_F(SnapshotServiceTest, TapBehindPoliciesRecordsOnlyWhatIsSent) {
+    auto inner = std::make_shared<MockPublisher>();
+    auto tap = service->tap(inner);
+    TelemetryPolicyPublisher telemetry(tap);
+    telemetry.setPolicy("battery", {2.0, 0.0, std::chrono::milliseconds(0),
+                                    std::chrono::milliseconds(0)});
+    StatePublisher mode(tap, "mode");
+
+    telemetry.send("battery:80;");
+    telemetry.send("battery:81;"); // inside the dead-band, suppressed
+    mode.set("1");
+
+    EXPECT_EQ(inner->messageCount(), 2u);
+    EXPECT_EQ(service->getSequence(), inner->messageCount());
+    EXPECT_EQ(service->snapshot(), "seq:2;battery:80;mode:1;");
+}
+
+TEST_F(SnapshotServiceTest, RecordsMultiplePairs) {
+    service->record("battery:80;charging:0;");
+    EXPECT_EQ(service->snapshot(), "seq:1;battery:80;charging:0;");
+}
+
+TEST_F(SnapshotServiceTest, RecordsBinaryFrames) {
+    sensor_frame::Record records[] = {
+        {sensor_frame::Channel::Speed, 42, 1},
+        {sensor_frame::Channel::Odo, 7, 1},
+    };
+    uint8_t frame[sensor_frame::kMaxFrameSize];
+    size_t size = sensor_frame::encode(9, records, 2, frame, sizeof(frame));
+    service->record(std::string(reinterpret_cast<char*>(frame), size));
+
+    EXPECT_EQ(service->snapshot(), "seq:1;frame:9;odo:7;speed:42;");
+}
+
+TEST(SnapshotServiceSocketTest, ServesSnapshotOverRep) {
+    zmq::context_t context(1);
+    SnapshotService service("inproc://snapshot-rep", context);
+    service.record("battery:77;");
+    service.start();
+
+    zmq::socket_t client(context, zmq::socket_type::req);
+    client.set(zmq::sockopt::linger, 0);
+    client.set(zmq::sockopt::rcvtimeo, 2000);
+    client.connect("inproc://snapshot-rep");
+
+    for (int i = 0; i < 2; ++i) {
+        client.send(zmq::message_t(std::string("snapshot")), zmq::send_flags::none);
+        zmq::message_t reply;
+        ASSERT_TRUE(client.recv(reply));
+        EXPECT_EQ(reply.to_string(), "seq:1;battery:77;");
+    }
+    EXPECT_EQ(service.getRequestCount(), 2u);
+
+    service.stop();
+    client.close();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+#include "ActuatorController.hpp"
+#include "ControlAssembly.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "SpeedController.hpp"
+#include "TestUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// The car on the floor: first-order response to throttle, 300ms time
+// constant, 20 mm/s per percent, and no motion below 8% (static friction).
+// Full throttle tops out at 1840 mm/s. The sensor reports magnitude only.
+struct VehiclePlant {
+    static constexpr double kGain = 20.0;
+    static constexpr double kTauS = 0.3;
+    static constexpr double kDeadband = 8.0;
+
+    void step(double throttle, double dt_s) {
+        double magnitude = std::max(std::abs(throttle) - kDeadband, 0.0);
+        double drive = throttle < 0 ? -magnitude : magnitude;
+        speed += (kGain * drive - speed) * dt_s / kTauS;
+    }
+    double measured() const { return std::round(std::abs(speed)); }
+
+    double speed = 0; // signed mm/s
+};
+
+// PI without anti-windup, for comparison
+struct NaivePi {
+    double update(double target, double measured, double dt_s) {
+        double error = target - measured;
+        integral += error * dt_s;
+        double output = kp * error + ki * integral;
+        return std::min(std::max(output, 0.0), 100.0);
+    }
+    double kp = SpeedController::Config().kp;
+    double ki = SpeedController::Config().ki;
+    double integral = 0;
+};
+
+constexpr double kDt = 0.01; // 100 Hz, the actuator owner's default period
+
+// Seconds until the plant stays within `band` of `target`, simulating at most
+// `limit_s`
+template <typename Controller>
+double settle(Controller& controller, VehiclePlant& plant, double target, double band,
+              double limit_s) {
+    double inside_since = -1;
+    for (double t = 0; t < limit_s; t += kDt) {
+        plant.step(controller.update(target, plant.measured(), kDt), kDt);
+        if (std::abs(plant.measured() - target) <= band) {
+            if (inside_since < 0) {
+                inside_since = t;
+            }
+        } else {
+            inside_since = -1;
+        }
+    }
+    return inside_since < 0 ? limit_s : inside_since;
+}
+
+// Motors whose throttle drives a plant simulated in real time on its own
+// thread, publishing the measured speed like the Speed sensor does
+class PlantMotors : public MockBackMotors {
+public:
+    PlantMotors() : speed_data(std::make_shared<SensorData>("speed", true)) {}
+    ~PlantMotors() override { stopPlant(); }
+
+    void setSpeed(int speed) override {
+        MockBackMotors::setSpeed(speed);
+        throttle = speed;
+    }
+    void emergencyBrake() override {
+        MockBackMotors::emergencyBrake();
+        throttle = 0;
+    }
+
+    void startPlant() {
+        running = true;
+        plant_thread = std::thread([this] {
+            auto last = std::chrono::steady_clock::now();
+            while (running) {
+                std::this_thread::sleep_for(1ms);
+                auto now = std::chrono::steady_clock::now();
+                plant.step(throttle.load(), std::chrono::duration<double>(now - last).count());
+                last = now;
+                speed_data->value = static_cast<unsigned int>(plant.measured());
+            }
+        });
+    }
+    void stopPlant() {
+        running = false;
+        if (plant_thread.joinable()) {
+            plant_thread.join();
+        }
+    }
+
+    std::shared_ptr<SensorData> speed_data;
+
+private:
+    VehiclePlant plant;
+    std::atomic<int> throttle{0};
+    std::atomic<bool> running{false};
+    std::thread plant_thread;
+};
+
+} // namespace
+
+TEST(SpeedControllerTest, TracksTargetWithoutSteadyStateError) {
+    SpeedController controller;
+    VehiclePlant plant;
+    double peak = 0;
+    for (double t = 0; t < 5.0; t += kDt) {
+        plant.step(controller.update(800, plant.measured(), kDt), kDt);
+        peak = std::max(peak, plant.speed);
+    }
+    // The integrator overcomes the deadband a P loop would stall against
+    EXPECT_NEAR(plant.speed, 800, 5);
+    EXPECT_LT(peak, 800 * 1.15);
+}
+
+TEST(SpeedControllerTest, DrivesInTheTargetsDirection) {
+    SpeedController controller;
+    VehiclePlant plant;
+    for (double t = 0; t < 5.0; t += kDt) {
+        plant.step(controller.update(-500, plant.measured(), kDt), kDt);
+    }
+    EXPECT_NEAR(plant.speed, -500, 5);
+
+    // Zero target: no throttle and a clean integrator
+    EXPECT_EQ(controller.update(0, plant.measured(), kDt), 0.0);
+    double output = controller.update(300, 0, kDt);
+    EXPECT_NEAR(output, 300 * (0.075 + 0.25 * kDt), 1e-9);
+}
+
+TEST(SpeedControllerTest, AntiWindupRecoversFromSaturation) {
+    // Ask for more than the car can do for three seconds, then slow down
+    SpeedController controller;
+    NaivePi naive;
+    VehiclePlant plant, naive_plant;
+    settle(controller, plant, 2500, 0, 3.0);
+    settle(naive, naive_plant, 2500, 0, 3.0);
+    ASSERT_NEAR(plant.speed, 1840, 10);
+    EXPECT_GT(controller.getStats().saturated, 250u);
+
+    double recovery = settle(controller, plant, 600, 30, 5.0);
+    double naive_recovery = settle(naive, naive_plant, 600, 30, 5.0);
+    EXPECT_LT(recovery, 1.0);
+    EXPECT_GT(naive_recovery, recovery + 1.0);
+
+    std::cout << "Recovery from saturation to 600 mm/s: " << recovery * 1000
+              << " ms with anti-windup, " << naive_recovery * 1000 << " ms without"
+              << std::endl;
+}
+
+TEST(SpeedControllerTest, ReportsTrackingError) {
+    SpeedController controller;
+    controller.update(100, 60, kDt);
+    controller.update(100, 120, kDt);
+    controller.update(100, 100, kDt);
+
+    auto stats = controller.getStats();
+    EXPECT_EQ(stats.updates, 3u);
+    EXPECT_DOUBLE_EQ(stats.error_avg_mms, 20.0);
+    EXPECT_DOUBLE_EQ(stats.error_rms_mms, std::sqrt((1600.0 + 400.0) / 3));
+    EXPECT_DOUBLE_EQ(stats.error_max_mms, 40.0);
+    EXPECT_EQ(stats.last_measured_mms, 100);
+
+    controller.resetStats();
+    EXPECT_EQ(controller.getStats().updates, 0u);
+    EXPECT_THROW(SpeedController({-1.0, 0.0, 100.0}), std::invalid_argument);
+}
+
+class SpeedLoopTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        motors = std::make_shared<PlantMotors>();
+        servo = std::make_shared<MockFServo>();
+        motors->startPlant();
+    }
+
+    void TearDown() override {
+        motors->stopPlant();
+        restoreOutput();
+    }
+
+    std::shared_ptr<PlantMotors> motors;
+    std::shared_ptr<MockFServo> servo;
+};
+
+TEST_F(SpeedLoopTest, OwnerThreadClosesTheLoopAtFixedRate) {
+    ActuatorController actuators(motors, servo, 10ms);
+    EXPECT_THROW(actuators.setTargetSpeed(100), std::logic_error);
+    auto speed_data = motors->speed_data;
+    actuators.enableSpeedControl(
+        [speed_data] { return static_cast<double>(speed_data->value.load()); });
+    actuators.start();
+
+    actuators.setTargetSpeed(600);
+    EXPECT_TRUE(waitForCondition(
+        [&] {
+            return std::abs(static_cast<int>(motors->speed_data->value.load()) - 600) <= 20;
+        },
+        5000, 5));
+    std::this_thread::sleep_for(200ms);
+    auto stats = actuators.getSpeedLoopStats();
+    EXPECT_EQ(stats.target_requests, 1u);
+    EXPECT_GT(stats.steps, 20u);
+    EXPECT_GT(stats.jitter_max_us, 0.0);
+    EXPECT_NEAR(stats.tracking.last_measured_mms, 600, 30);
+
+    restoreOutput();
+    std::cout << "Speed loop at 100 Hz: " << stats.steps << " steps, jitter avg "
+              << stats.jitter_avg_us << " us, max " << stats.jitter_max_us
+              << " us; tracking error avg " << stats.tracking.error_avg_mms << " mm/s, rms "
+              << stats.tracking.error_rms_mms << " mm/s" << std::endl;
+    suppressOutput();
+
+    // An open-loop throttle takes over until the next target
+    actuators.setThrottle(20);
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(motors->getCurrentSpeed(), 20);
+    uint64_t steps = actuators.getSpeedLoopStats().steps;
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(actuators.getSpeedLoopStats().steps, steps);
+
+    // So does a brake
+    actuators.setTargetSpeed(400);
+    ASSERT_TRUE(waitForCondition(
+        [&] { return actuators.getSpeedLoopStats().steps > steps + 2; }, 1000, 5));
+    actuators.emergencyBrake();
+    ASSERT_TRUE(waitForCondition(
+        [&] { return actuators.getStats().emergency_brakes == 1; }, 1000, 1));
+    steps = actuators.getSpeedLoopStats().steps;
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(actuators.getSpeedLoopStats().steps, steps);
+    actuators.stop();
+}
+
+TEST_F(SpeedLoopTest, ControlAssemblyThrottleBecomesTargetSpeed) {
+    zmq::context_t context{1};
+    zmq::socket_t sender{context, zmq::socket_type::pub};
+    sender.bind("inproc://speed-loop");
+    auto assembly = std::make_unique<ControlAssembly>("inproc://speed-loop", context, motors,
+                                                      servo);
+    EXPECT_THROW(assembly->enableSpeedControl(), std::invalid_argument);
+    auto speed_data = motors->speed_data;
+    assembly->setSpeedDataAccessor([speed_data] { return speed_data; });
+    assembly->enableSpeedControl();
+    assembly->start();
+
+    // PUB/SUB joins asynchronously; resend until the command lands
+    const std::string command = "throttle:500;";
+    ASSERT_TRUE(waitForCondition(
+        [&] {
+            sender.send(zmq::buffer(command), zmq::send_flags::none);
+            std::this_thread::sleep_for(5ms);
+            return assembly->getSpeedLoopStats().target_requests > 0;
+        },
+        2000, 1));
+    EXPECT_TRUE(waitForCondition(
+        [&] { return std::abs(static_cast<int>(speed_data->value.load()) - 500) <= 20; },
+        5000, 5));
+    // 500 would be the PWM percentage open loop, clamped to 100
+    EXPECT_LT(motors->getCurrentSpeed(), 100);
+
+    assembly->stop();
+    assembly.reset();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
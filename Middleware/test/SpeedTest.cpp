@@ -24,6 +24,28 @@ protected:
         bus.stop();
     }
 
+    // Inject a timing frame (0x102) followed by its pulse frame (0x100), as
+    // sent by timing-capable firmware, then process it
+    void sendTimedFrame(uint16_t pulseDelta, uint32_t totalInterrupts,
+                        uint16_t intervalUs, uint32_t edgeUs, uint32_t sampleUs) {
+        uint8_t timing[8] = {
+            static_cast<uint8_t>(edgeUs), static_cast<uint8_t>(edgeUs >> 8),
+            static_cast<uint8_t>(edgeUs >> 16), static_cast<uint8_t>(edgeUs >> 24),
+            static_cast<uint8_t>(sampleUs), static_cast<uint8_t>(sampleUs >> 8),
+            static_cast<uint8_t>(sampleUs >> 16), static_cast<uint8_t>(sampleUs >> 24)};
+        uint8_t pulses[8] = {
+            static_cast<uint8_t>(pulseDelta), static_cast<uint8_t>(pulseDelta >> 8),
+            static_cast<uint8_t>(totalInterrupts), static_cast<uint8_t>(totalInterrupts >> 8),
+            static_cast<uint8_t>(totalInterrupts >> 16), static_cast<uint8_t>(totalInterrupts >> 24),
+            static_cast<uint8_t>(intervalUs), static_cast<uint8_t>(intervalUs >> 8)};
+
+        auto& bus = CanMessageBus::getInstance();
+        bus.injectTestMessage(CanMessage(0x102, timing, 8));
+        bus.injectTestMessage(CanMessage(0x100, pulses, 8));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        speed->updateSensorData();
+    }
+
     std::shared_ptr<Speed> speed;
 };
 
@@ -374,6 +396,94 @@ TEST_F(SpeedTest, ThreadSafety) {
     EXPECT_TRUE(true);
 }
 
+TEST_F(SpeedTest, DeviceTimingResolvesLowSpeed) {
+    // One physical pulse (two interrupts) every 100 ms on the device clock,
+    // i.e. 0 or 1 pulses per 50 ms frame: 11.69 mm / 0.1 s = 117 mm/s
+    uint32_t total = 0;
+    uint32_t edge = 0;
+    for (uint32_t frame = 1; frame <= 12; ++frame) {
+        uint32_t sample = frame * 50000;
+        uint16_t delta = 0;
+        if (frame % 2 == 0) {
+            total += 2;
+            edge = sample - 1000;
+            delta = 1;
+        }
+        sendTimedFrame(delta, total, 50000, edge, sample);
+    }
+
+    EXPECT_TRUE(speed->hasDeviceTiming());
+    auto sensorData = speed->getSensorData();
+    EXPECT_NEAR(static_cast<double>(sensorData["speed"]->value.load()), 117.0, 2.0);
+    EXPECT_EQ(speed->getDroppedFrames(), 0u);
+}
+
+TEST_F(SpeedTest, DeviceTimingIgnoresHostJitter) {
+    // Constant 4 pulses per 50 ms on the device clock while the host sees
+    // irregular arrival times: 4 * 11.69 mm / 0.05 s = 935 mm/s
+    uint32_t total = 0;
+    for (uint32_t frame = 1; frame <= 8; ++frame) {
+        total += 8;
+        uint32_t sample = frame * 50000;
+        sendTimedFrame(4, total, 50000, sample - 100, sample);
+        std::this_thread::sleep_for(std::chrono::milliseconds((frame * 37) % 50));
+    }
+
+    auto sensorData = speed->getSensorData();
+    EXPECT_NEAR(static_cast<double>(sensorData["speed"]->value.load()), 935.0, 3.0);
+}
+
+TEST_F(SpeedTest, DeviceTimingDecaysToStandstill) {
+    uint32_t total = 0;
+    for (uint32_t frame = 1; frame <= 4; ++frame) {
+        total += 4;
+        uint32_t sample = frame * 50000;
+        sendTimedFrame(2, total, 50000, sample - 100, sample);
+    }
+    unsigned int moving = speed->getSensorData()["speed"]->value.load();
+    ASSERT_GT(moving, 400u);
+
+    // Wheel stops: no new edges, device clock keeps advancing
+    uint32_t last_edge = 4 * 50000 - 100;
+    sendTimedFrame(0, total, 50000, last_edge, 5 * 50000 + 50000);
+    unsigned int slowing = speed->getSensorData()["speed"]->value.load();
+    EXPECT_LT(slowing, moving);
+
+    sendTimedFrame(0, total, 50000, last_edge, 4 * 50000 + 600000);
+    EXPECT_EQ(speed->getSensorData()["speed"]->value.load(), 0u);
+}
+
+TEST_F(SpeedTest, DroppedFramesCountedFromDeviceClock) {
+    sendTimedFrame(2, 4, 50000, 49000, 50000);
+    sendTimedFrame(2, 8, 50000, 99000, 100000);
+    // Frames at 150 ms and 200 ms are lost
+    sendTimedFrame(2, 20, 50000, 249000, 250000);
+
+    EXPECT_EQ(speed->getDroppedFrames(), 2u);
+
+    // Odometer follows the running total rather than the last frame's delta
+    auto sensorData = speed->getSensorData();
+    EXPECT_TRUE(sensorData["odo"]->updated.load());
+}
+
+TEST_F(SpeedTest, DroppedFramesCountedFromTotalWithoutTiming) {
+    auto& bus = CanMessageBus::getInstance();
+
+    uint8_t first[8] = {2, 0, 4, 0, 0, 0, 0, 0};
+    bus.injectTestMessage(CanMessage(0x100, first, 8));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    speed->updateSensorData();
+
+    // Total advanced by 12 interrupts while the frame only reports 2 pulses
+    uint8_t second[8] = {2, 0, 16, 0, 0, 0, 0, 0};
+    bus.injectTestMessage(CanMessage(0x100, second, 8));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    speed->updateSensorData();
+
+    EXPECT_EQ(speed->getDroppedFrames(), 1u);
+    EXPECT_FALSE(speed->hasDeviceTiming());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
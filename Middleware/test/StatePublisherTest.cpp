@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "StatePublisher.hpp"
+#include "ControlAssembly.hpp"
+#include "MockBackMotors.hpp"
+#include "MockFServo.hpp"
+#include "MockPublisher.hpp"
+#include "TestUtils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+using Clock = StatePublisher::Clock;
+
+class StatePublisherTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        inner = std::make_shared<MockPublisher>();
+        policy.retransmits = 3;
+        policy.initial_backoff = 50ms;
+        policy.heartbeat = 1000ms;
+        t0 = Clock::now();
+    }
+
+    void TearDown() override { restoreOutput(); }
+
+    std::shared_ptr<MockPublisher> inner;
+    StatePublishPolicy policy;
+    Clock::time_point t0;
+};
+
+TEST_F(StatePublisherTest, RequiresPublisher) {
+    EXPECT_THROW(StatePublisher(nullptr, "mode"), std::invalid_argument);
+}
+
+TEST_F(StatePublisherTest, SendsOnlyOnChange) {
+    StatePublisher publisher(inner, "mode", policy);
+    publisher.set("0", t0);
+    for (int i = 1; i <= 100; ++i) {
+        publisher.set("0", t0 + std::chrono::milliseconds(i));
+    }
+    EXPECT_EQ(inner->getMessages(), std::vector<std::string>{"mode:0;"});
+
+    publisher.set("1", t0 + 200ms);
+    EXPECT_EQ(inner->messageCount(), 2u);
+    EXPECT_EQ(inner->getMessages().back(), "mode:1;");
+    EXPECT_EQ(publisher.getValue(), "1");
+
+    auto stats = publisher.getStats();
+    EXPECT_EQ(stats.updates, 102u);
+    EXPECT_EQ(stats.changes, 2u);
+    EXPECT_EQ(stats.sent, 2u);
+}
+
+TEST_F(StatePublisherTest, RetransmitsWithBackoff) {
+    StatePublisher publisher(inner, "mode", policy);
+    publisher.set("1", t0);
+
+    // Repeats at +50, +150 (50 + 100) and +350 (150 + 200) ms
+    EXPECT_EQ(publisher.flushDue(t0 + 49ms), t0 + 50ms);
+    EXPECT_EQ(inner->messageCount(), 1u);
+    EXPECT_EQ(publisher.flushDue(t0 + 50ms), t0 + 150ms);
+    EXPECT_EQ(publisher.flushDue(t0 + 150ms), t0 + 350ms);
+    EXPECT_EQ(inner->messageCount(), 3u);
+
+    // After the last repeat only the heartbeat is left
+    EXPECT_EQ(publisher.flushDue(t0 + 350ms), t0 + 1350ms);
+    EXPECT_EQ(inner->messageCount(), 4u);
+    EXPECT_EQ(publisher.getStats().retransmits, 3u);
+}
+
+TEST_F(StatePublisherTest, ChangeRestartsRetransmits) {
+    StatePublisher publisher(inner, "mode", policy);
+    publisher.set("1", t0);
+    publisher.flushDue(t0 + 50ms);
+
+    publisher.set("0", t0 + 60ms);
+    EXPECT_EQ(publisher.flushDue(t0 + 60ms), t0 + 110ms);
+    publisher.flushDue(t0 + 110ms);
+
+    auto messages = inner->getMessages();
+    EXPECT_EQ(messages,
+              (std::vector<std::string>{"mode:1;", "mode:1;", "mode:0;", "mode:0;"}));
+}
+
+TEST_F(StatePublisherTest, HeartbeatWhenUnchanged) {
+    policy.retransmits = 0;
+    StatePublisher publisher(inner, "mode", policy);
+    publisher.set("0", t0);
+
+    EXPECT_EQ(publisher.flushDue(t0 + 999ms), t0 + 1000ms);
+    EXPECT_EQ(inner->messageCount(), 1u);
+    EXPECT_EQ(publisher.flushDue(t0 + 1000ms), t0 + 2000ms);
+    EXPECT_EQ(inner->messageCount(), 2u);
+    EXPECT_EQ(publisher.getStats().heartbeats, 1u);
+}
+
+TEST_F(StatePublisherTest, NothingBeforeFirstValue) {
+    StatePublisher publisher(inner, "mode", policy);
+    EXPECT_EQ(publisher.flushDue(t0 + 10s), Clock::time_point::max());
+    EXPECT_EQ(inner->messageCount(), 0u);
+}
+
+TEST_F(StatePublisherTest, TimerThreadSendsRetransmits) {
+    policy.initial_backoff = 10ms;
+    StatePublisher publisher(inner, "mode", policy);
+    publisher.start();
+    publisher.set("1");
+
+    EXPECT_TRUE(waitForCondition([&] { return inner->messageCount() == 4; }, 1000, 5));
+    publisher.stop();
+    EXPECT_EQ(publisher.getStats().retransmits, 3u);
+}
+
+TEST_F(StatePublisherTest, ControlAssemblyPublishesModeOnChangeOnly) {
+    zmq::context_t context(1);
+    zmq::socket_t sender(context, zmq::socket_type::pub);
+    sender.bind("inproc://state-publisher-control");
+
+    {
+        ControlAssembly assembly("inproc://state-publisher-control", context,
+                                 std::make_shared<MockBackMotors>(),
+                                 std::make_shared<MockFServo>(), inner);
+        assembly.start();
+
+        auto send = [&](const std::string& message) {
+            sender.send(zmq::buffer(message), zmq::send_flags::none);
+            std::this_thread::sleep_for(5ms);
+        };
+
+        // A stream of manual commands at control rate
+        for (int i = 0; i < 60; ++i) {
+            send("steering:" + std::to_string(i % 10) + ";");
+        }
+        auto messages = inner->getMessages();
+        auto mode0 = std::count(messages.begin(), messages.end(), "mode:0;");
+        EXPECT_GE(mode0, 1);
+        EXPECT_LE(mode0, 5); // initial send, retransmits, at most one heartbeat
+
+        // A mode change is published immediately, not tens of times
+        inner->clearMessages();
+        auto changed = [&] { return inner->hasMessage("mode:1;"); };
+        EXPECT_TRUE(waitForCondition([&] {
+            send("auto_mode:1;");
+            return changed();
+        }, 1000, 1));
+
+        std::this_thread::sleep_for(400ms);
+        messages = inner->getMessages();
+        EXPECT_LE(std::count(messages.begin(), messages.end(), "mode:1;"), 4);
+        assembly.stop();
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
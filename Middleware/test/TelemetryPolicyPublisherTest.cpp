@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "TelemetryPolicyPublisher.hpp"
+#include "MockPublisher.hpp"
+#include "TestUtils.hpp"
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+using Clock = TelemetryPolicyPublisher::Clock;
+
+class TelemetryPolicyPublisherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inner = std::make_shared<MockPublisher>();
+        publisher = std::make_unique<TelemetryPolicyPublisher>(inner);
+        t0 = Clock::now();
+    }
+
+    std::shared_ptr<MockPublisher> inner;
+    std::unique_ptr<TelemetryPolicyPublisher> publisher;
+    Clock::time_point t0;
+};
+
+TEST_F(TelemetryPolicyPublisherTest, RequiresPublisher) {
+    EXPECT_THROW(TelemetryPolicyPublisher(nullptr), std::invalid_argument);
+}
+
+TEST_F(TelemetryPolicyPublisherTest, UnconfiguredChannelsPassThrough) {
+    publisher->offer("init;", t0);
+    publisher->offer("mode:1;", t0);
+    publisher->offer("mode:1;", t0);
+    publisher->offer("a:1;b:2;", t0);
+
+    EXPECT_EQ(inner->messageCount(), 4u);
+    EXPECT_EQ(publisher->getStats().forwarded, 4u);
+}
+
+TEST_F(TelemetryPolicyPublisherTest, AbsoluteDeadband) {
+    TelemetryPolicy policy;
+    policy.abs_deadband = 2.0;
+    publisher->setPolicy("battery", policy);
+
+    publisher->offer("battery:80;", t0);
+    publisher->offer("battery:81;", t0 + 1ms);
+    publisher->offer("battery:79;", t0 + 2ms);
+    publisher->offer("battery:82;", t0 + 3ms); // 2 away from 80
+    publisher->offer("battery:83;", t0 + 4ms);
+
+    auto messages = inner->getMessages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0], "battery:80;");
+    EXPECT_EQ(messages[1], "battery:82;");
+    EXPECT_EQ(publisher->getStats().suppressed, 3u);
+}
+
+TEST_F(TelemetryPolicyPublisherTest, RelativeDeadband) {
+    TelemetryPolicy policy;
+    policy.rel_deadband = 0.1;
+    publisher->setPolicy("odo", policy);
+
+    publisher->offer("odo:1000;", t0);
+    publisher->offer("odo:1099;", t0 + 1ms);
+    publisher->offer("odo:1100;", t0 + 2ms);
+
+    auto messages = inner->getMessages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[1], "odo:1100;");
+}
+
+TEST_F(TelemetryPolicyPublisherTest, TextValuesSentOnChange) {
+    publisher->setPolicy("sign", TelemetryPolicy{});
+
+    publisher->offer("sign:stop", t0);
+    publisher->offer("sign:stop", t0 + 1ms);
+    publisher->offer("sign:yield", t0 + 2ms);
+
+    auto messages = inner->getMessages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[1], "sign:yield");
+}
+
+TEST_F(TelemetryPolicyPublisherTest, MinIntervalHoldsLatestValue) {
+    TelemetryPolicy policy;
+    policy.min_interval = 100ms;
+    publisher->setPolicy("obs", policy);
+
+    publisher->offer("obs:1;", t0);
+    publisher->offer("obs:2;", t0 + 10ms);
+    publisher->offer("obs:3;", t0 + 20ms);
+    EXPECT_EQ(inner->messageCount(), 1u);
+
+    EXPECT_EQ(publisher->flushDue(t0 + 50ms), t0 + 100ms);
+    EXPECT_EQ(inner->messageCount(), 1u);
+
+    publisher->flushDue(t0 + 100ms);
+    auto messages = inner->getMessages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[1], "obs:3;");
+
+    // A value back at the published one cancels the held-back change
+    publisher->offer("obs:4;", t0 + 110ms);
+    publisher->offer("obs:3;", t0 + 120ms);
+    publisher->flushDue(t0 + 250ms);
+    EXPECT_EQ(inner->messageCount(), 2u);
+}
+
+TEST_F(TelemetryPolicyPublisherTest, HeartbeatBoundsStaleness) {
+    TelemetryPolicy policy;
+    policy.abs_deadband = 5.0;
+    policy.heartbeat = 1000ms;
+    publisher->setPolicy("battery", policy);
+
+    publisher->offer("battery:80;", t0);
+    publisher->offer("battery:81;", t0 + 100ms); // inside the dead-band
+    EXPECT_EQ(publisher->flushDue(t0 + 500ms), t0 + 1000ms);
+    EXPECT_EQ(inner->messageCount(), 1u);
+
+    // Heartbeat carries the current value, not the last published one
+    EXPECT_EQ(publisher->flushDue(t0 + 1000ms), t0 + 2000ms);
+    auto messages = inner->getMessages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[1], "battery:81;");
+    EXPECT_EQ(publisher->getStats().heartbeats, 1u);
+}
+
+TEST_F(TelemetryPolicyPublisherTest, NoisyChannelTrafficReduced) {
+    TelemetryPolicy policy;
+    policy.abs_deadband = 3.0;
+    policy.min_interval = 1000ms;
+    policy.heartbeat = 5000ms;
+    publisher->setPolicy("battery", policy);
+
+    // 60 s of battery readings every 50 ms jittering +-1 around 80
+    size_t offered = 0;
+    for (int ms = 0; ms < 60000; ms += 50) {
+        int value = 80 + ((ms / 50) % 3) - 1;
+        publisher->offer("battery:" + std::to_string(value) + ";",
+                         t0 + std::chrono::milliseconds(ms));
+        publisher->flushDue(t0 + std::chrono::milliseconds(ms));
+        offered++;
+    }
+
+    // Initial value plus one heartbeat every 5 s
+    EXPECT_EQ(offered, 1200u);
+    EXPECT_LE(inner->messageCount(), 13u);
+    EXPECT_GE(inner->messageCount(), 12u);
+}
+
+TEST_F(TelemetryPolicyPublisherTest, FlushThreadSendsHeldValue) {
+    TelemetryPolicy policy;
+    policy.min_interval = 50ms;
+    publisher->setPolicy("odo", policy);
+    publisher->start();
+
+    publisher->send("odo:1;");
+    publisher->send("odo:2;");
+    EXPECT_EQ(inner->messageCount(), 1u);
+    EXPECT_TRUE(waitForCondition([&] { return inner->messageCount() == 2; },
+                                 1000, 10));
+    EXPECT_TRUE(inner->hasMessage("odo:2;"));
+
+    publisher->stop();
+    publisher->stop(); // idempotent
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "TelemetryPolicyPublisher.hpp"
+#include "ZmqPublisher.hpp"
+#include "ZmqSubscriber.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <zmq.hpp>
+
+// Counts heap allocations made by the calling thread. operator new and
+// libzmq both end up in malloc, so interposing it sees them all.
+namespace {
+thread_local size_t allocations = 0;
+}
+
+extern "C" void* __libc_malloc(size_t size);
+
+extern "C" void* malloc(size_t size) {
+    allocations++;
+    return __libc_malloc(size);
+}
+
+namespace {
+
+// Discards output without buffering it, so logging does not allocate
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+class ZmqPublisherAllocationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        oldCerr = std::cerr.rdbuf(&null);
+        publisher = std::make_shared<ZmqPublisher>("inproc://alloc", context);
+        ASSERT_TRUE(publisher->isConnected());
+        subscriber.set(zmq::sockopt::linger, 0);
+        subscriber.set(zmq::sockopt::rcvhwm, 0);
+        subscriber.connect("inproc://alloc");
+        subscriber.set(zmq::sockopt::subscribe, "");
+    }
+
+    void TearDown() override {
+        subscriber.close();
+        publisher.reset();
+        std::cerr.rdbuf(oldCerr);
+    }
+
+    std::string receive() {
+        zmq::message_t msg;
+        auto result = subscriber.recv(msg, zmq::recv_flags::dontwait);
+        return result ? msg.to_string() : std::string("<none>");
+    }
+
+    // Allocations in this thread for `count` sends after a warm-up send
+    template <typename Send>
+    size_t allocationsPerPublish(Send&& send, size_t count) {
+        send();
+        size_t before = allocations;
+        for (size_t i = 0; i < count; ++i) {
+            send();
+        }
+        return (allocations - before) / count;
+    }
+
+    NullBuffer null;
+    std::streambuf* oldCerr = nullptr;
+    zmq::context_t context{1};
+    std::shared_ptr<ZmqPublisher> publisher;
+    zmq::socket_t subscriber{context, zmq::socket_type::sub};
+};
+
+} // namespace
+
+TEST_F(ZmqPublisherAllocationTest, SmallMessageDoesNotAllocate) {
+    constexpr std::string_view message = "speed:123;";
+    EXPECT_EQ(allocationsPerPublish([&] { publisher->send(message); }, 1000), 0u);
+    EXPECT_EQ(receive(), "speed:123;");
+}
+
+TEST_F(ZmqPublisherAllocationTest, PolicyPublisherDoesNotAllocate) {
+    // The production non-critical path: forwarded, suppressed and
+    // pass-through messages all go through the policy as views. Longer than
+    // the small-string buffer, so a copy to std::string would allocate.
+    TelemetryPolicyPublisher policy(publisher);
+    TelemetryPolicy deadband;
+    deadband.abs_deadband = 5.0;
+    policy.setPolicy("wheel_speed", deadband);
+    policy.setPolicy("battery_percent", TelemetryPolicy());
+
+    constexpr std::string_view speeds[] = {"wheel_speed:100;", "wheel_speed:120;",
+                                           "wheel_speed:121;"};
+    constexpr std::string_view batteries[] = {"battery_percent:80;", "battery_percent:79;"};
+    size_t i = 0;
+    EXPECT_EQ(allocationsPerPublish(
+                  [&] {
+                      policy.send(speeds[i % 3]);
+                      policy.send(batteries[i % 2]);
+                      policy.send(std::string_view("odometer_m:12345;"));
+                      ++i;
+                  },
+                  1000),
+              0u);
+
+    auto stats = policy.getStats();
+    EXPECT_GT(stats.forwarded, 0u);
+    EXPECT_GT(stats.suppressed, 0u);
+}
+
+TEST_F(ZmqPublisherAllocationTest, LargeMessageAllocatesOnce) {
+    // Larger than a zmq_msg_t can hold inline: libzmq mallocs the reference
+    // count and payload as one block
+    const std::string message(200, 'f');
+    publisher->send(std::string_view(message)); // warm-up
+    ASSERT_EQ(receive(), message);
+    size_t send_allocations = 0;
+    for (int i = 0; i < 1000; ++i) {
+        size_t before = allocations;
+        publisher->send(std::string_view(message));
+        send_allocations += allocations - before;
+        ASSERT_EQ(receive(), message);
+    }
+    // Per publish; libzmq's queue may grow once along the way
+    EXPECT_EQ(send_allocations / 1000, 1u);
+}
+
+TEST_F(ZmqPublisherAllocationTest, QueuedLargeMessagesKeepTheirContent) {
+    // Nothing is received while sending, so every message is in flight
+    for (int i = 0; i < 100; ++i) {
+        publisher->send(std::string(2000, static_cast<char>('a' + i % 26)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(receive(), std::string(2000, static_cast<char>('a' + i % 26)));
+    }
+}
+
+TEST_F(ZmqPublisherAllocationTest, EmptyMessageSendsMarker) {
+    publisher->send(std::string_view());
+    EXPECT_EQ(receive(), "<EMPTY_MESSAGE>");
+}
+
+TEST_F(ZmqPublisherAllocationTest, MultipartSendsTwoFrames) {
+    publisher->sendMultipart("hdr", std::string(64, 'p'));
+    zmq::message_t part;
+    ASSERT_TRUE(subscriber.recv(part, zmq::recv_flags::dontwait));
+    EXPECT_EQ(part.to_string(), "hdr");
+    EXPECT_TRUE(part.more());
+    ASSERT_TRUE(subscriber.recv(part, zmq::recv_flags::dontwait));
+    EXPECT_EQ(part.to_string(), std::string(64, 'p'));
+    EXPECT_FALSE(part.more());
+}
+
+TEST_F(ZmqPublisherAllocationTest, SubscriberReceiveDoesNotAllocate) {
+    ZmqSubscriber reader("inproc://alloc", context);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::string buffer;
+    buffer.reserve(64);
+
+    publisher->send("speed:1;"); // warm-up
+    ASSERT_TRUE(reader.receiveView(500).has_value());
+
+    size_t receive_allocations = 0;
+    for (int i = 0; i < 200; ++i) {
+        publisher->send(i % 2 ? "speed:12;" : "speed:123456;");
+        size_t before = allocations;
+        bool received = i % 2 ? reader.receiveView(500).has_value()
+                              : reader.receiveInto(buffer, 500);
+        receive_allocations += allocations - before;
+        ASSERT_TRUE(received);
+    }
+    EXPECT_EQ(receive_allocations, 0u);
+    EXPECT_EQ(buffer, "speed:123456;");
+}
+
+TEST(IPublisherDefaultsTest, ViewAndMultipartFallBackToString) {
+    class StringOnlyPublisher : public IPublisher {
+    public:
+        void send(const std::string& message) override { last = message; }
+        using IPublisher::send;
+        std::string last;
+    } publisher;
+
+    IPublisher& base = publisher;
+    base.send(std::string_view("odo:1;"));
+    EXPECT_EQ(publisher.last, "odo:1;");
+    base.send("init;");
+    EXPECT_EQ(publisher.last, "init;");
+    base.sendMultipart("a:", "1;");
+    EXPECT_EQ(publisher.last, "a:1;");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
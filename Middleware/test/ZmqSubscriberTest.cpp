@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "ZmqSubscriber.hpp"
+#include "TestUtils.hpp"
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+class ZmqSubscriberTest : public ::testing::Test, protected OutputSuppressor {
+protected:
+    void SetUp() override {
+        suppressOutput();
+        publisher.set(zmq::sockopt::linger, 0);
+        publisher.bind("inproc://subscriber-test");
+        subscriber = std::make_unique<ZmqSubscriber>("inproc://subscriber-test", context);
+        ASSERT_TRUE(subscriber->isConnected());
+    }
+
+    void TearDown() override {
+        subscriber.reset();
+        publisher.close();
+        restoreOutput();
+    }
+
+    void publish(const std::string& message) {
+        publisher.send(zmq::message_t(message.data(), message.size()),
+                       zmq::send_flags::none);
+    }
+
+    zmq::context_t context{1};
+    zmq::socket_t publisher{context, zmq::socket_type::pub};
+    std::unique_ptr<ZmqSubscriber> subscriber;
+};
+
+TEST_F(ZmqSubscriberTest, ReceiveViewReturnsPayload) {
+    EXPECT_FALSE(subscriber->receiveView().has_value());
+
+    publish("throttle:0.5;");
+    auto view = subscriber->receiveView(500);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(*view, "throttle:0.5;");
+
+    EXPECT_FALSE(subscriber->receiveView(10).has_value());
+}
+
+TEST_F(ZmqSubscriberTest, EmptyMarkerIsAnEmptyMessage) {
+    publish("<EMPTY_MESSAGE>");
+    auto view = subscriber->receiveView(500);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_TRUE(view->empty());
+}
+
+TEST_F(ZmqSubscriberTest, ReceiveIntoReusesCallerBuffer) {
+    std::string buffer;
+    buffer.reserve(256);
+    const char* storage = buffer.data();
+
+    publish("lane:1;");
+    ASSERT_TRUE(subscriber->receiveInto(buffer, 500));
+    EXPECT_EQ(buffer, "lane:1;");
+    EXPECT_EQ(buffer.data(), storage);
+
+    EXPECT_FALSE(subscriber->receiveInto(buffer, 10));
+}
+
+TEST_F(ZmqSubscriberTest, ReceiveIntoSkipsEmptyMessages) {
+    std::string buffer = "lane:1;";
+    publish("<EMPTY_MESSAGE>");
+    EXPECT_FALSE(subscriber->receiveInto(buffer, 500));
+    EXPECT_EQ(buffer, "lane:1;");
+    // Consumed, not left queued
+    EXPECT_FALSE(subscriber->receiveView(10).has_value());
+}
+
+TEST_F(ZmqSubscriberTest, DeliverAllKeepsTheBacklog) {
+    ZmqSubscriber queued("inproc://subscriber-test", context, false,
+                         ZmqSubscriber::Delivery::All);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (int i = 0; i < 5; ++i) {
+        publish("seq:" + std::to_string(i) + ";");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::vector<std::string> received;
+    std::string buffer;
+    while (queued.receiveInto(buffer, received.empty() ? 500 : 0)) {
+        received.push_back(buffer);
+    }
+    EXPECT_EQ(received, (std::vector<std::string>{"seq:0;", "seq:1;", "seq:2;",
+                                                  "seq:3;", "seq:4;"}));
+    // The default subscriber conflated the same burst to its newest message
+    ASSERT_TRUE(subscriber->receiveInto(buffer, 500));
+    EXPECT_EQ(buffer, "seq:4;");
+    EXPECT_FALSE(subscriber->receiveInto(buffer, 10));
+}
+
+TEST(ISubscriberDefaultsTest, ReceiveIntoMatchesZmqContract) {
+    class StringOnlySubscriber : public ISubscriber {
+    public:
+        std::string receive(int) override {
+            std::string message = next;
+            next.clear();
+            return message;
+        }
+        bool isConnected() const override { return true; }
+        std::string next;
+    } subscriber;
+
+    std::string buffer;
+    subscriber.next = "sign:stop;";
+    EXPECT_TRUE(subscriber.receiveInto(buffer));
+    EXPECT_EQ(buffer, "sign:stop;");
+    EXPECT_FALSE(subscriber.receiveInto(buffer)); // nothing, or empty
+    EXPECT_EQ(buffer, "sign:stop;");
+}
+
+TEST_F(ZmqSubscriberTest, DrainHandsOverQueuedMessage) {
+    // The subscriber conflates, so at most the latest message is queued
+    publish("sign:stop");
+    publish("sign:yield");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::vector<std::string> received;
+    size_t count = subscriber->drain(
+        [&](std::string_view message) { received.emplace_back(message); }, 500);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(received.back(), "sign:yield");
+    EXPECT_EQ(subscriber->drain([](std::string_view) {}), 0u);
+}
+
+TEST_F(ZmqSubscriberTest, LegacyReceiveUnchanged) {
+    publish("steering:10;");
+    EXPECT_EQ(subscriber->receive(500), "steering:10;");
+    EXPECT_EQ(subscriber->receive(), "");
+}
+
+TEST(ZmqSubscriberTestMode, ViewOfTestMessage) {
+    zmq::context_t context(1);
+    ZmqSubscriber subscriber("inproc://unused", context, true);
+    subscriber.setTestMessage("mode:1;");
+    auto view = subscriber.receiveView();
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(*view, "mode:1;");
+    EXPECT_FALSE(subscriber.receiveView().has_value());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
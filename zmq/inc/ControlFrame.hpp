@@ -0,0 +1,140 @@
+#ifndef CONTROL_FRAME_HPP
+#define CONTROL_FRAME_HPP
+
+#include "KeyValueCodec.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Fixed-size binary drive command sent by the Controller to the Middleware
+// control socket, replacing "throttle:..;steering:..;auto_mode:..;" text.
+//
+// All fields are little endian, 24 bytes in total:
+//
+//   0  u8   magic (0xC7, never a printable character, so the receiver can
+//           tell frames from the legacy text commands on one socket)
+//   1  u8   version
+//   2  u16  flags (see Flag)
+//   4  u32  sequence number (per sender, wraps)
+//   8  u64  send time, steady_clock nanoseconds of the sender
+//   16 f32  throttle, -100..100
+//   20 f32  steering, degrees
+//
+// Sender and receiver run on the same host, so the send time is directly
+// comparable with the receiver's steady_clock.
+namespace control_frame {
+
+constexpr uint8_t kMagic = 0xC7;
+constexpr uint8_t kVersion = 1;
+constexpr size_t kFrameSize = 24;
+
+enum Flag : uint16_t {
+  kInit = 1 << 0, // reset marker, sent once when the sender starts
+  kHasThrottle = 1 << 1,
+  kHasSteering = 1 << 2,
+  kHasAutoMode = 1 << 3,
+  kAutoMode = 1 << 4, // requested mode, valid with kHasAutoMode
+};
+
+struct Frame {
+  uint8_t version = kVersion;
+  uint16_t flags = 0;
+  uint32_t sequence = 0;
+  uint64_t timestamp_ns = 0;
+  float throttle = 0.0f;
+  float steering = 0.0f;
+};
+
+inline uint64_t nowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+namespace detail {
+inline void put16(uint8_t *p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+inline void put32(uint8_t *p, uint32_t v) {
+  put16(p, static_cast<uint16_t>(v));
+  put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+inline void put64(uint8_t *p, uint64_t v) {
+  put32(p, static_cast<uint32_t>(v));
+  put32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+inline void putFloat(uint8_t *p, float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  put32(p, bits);
+}
+inline uint16_t get16(const uint8_t *p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+inline uint32_t get32(const uint8_t *p) {
+  return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+inline uint64_t get64(const uint8_t *p) {
+  return get32(p) | (static_cast<uint64_t>(get32(p + 4)) << 32);
+}
+inline float getFloat(const uint8_t *p) {
+  uint32_t bits = get32(p);
+  float v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+} // namespace detail
+
+// Returns the number of bytes written, or 0 if out is too small
+inline size_t encode(const Frame &frame, uint8_t *out, size_t capacity) {
+  if (capacity < kFrameSize) {
+    return 0;
+  }
+  out[0] = kMagic;
+  out[1] = frame.version;
+  detail::put16(out + 2, frame.flags);
+  detail::put32(out + 4, frame.sequence);
+  detail::put64(out + 8, frame.timestamp_ns);
+  detail::putFloat(out + 16, frame.throttle);
+  detail::putFloat(out + 20, frame.steering);
+  return kFrameSize;
+}
+
+inline bool isFrame(const void *data, size_t size) {
+  return size > 0 && static_cast<const uint8_t *>(data)[0] == kMagic;
+}
+
+// Validates magic, version and length
+inline bool decode(const void *data, size_t size, Frame &frame) {
+  if (!isFrame(data, size) || size != kFrameSize) {
+    return false;
+  }
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  frame.version = p[1];
+  frame.flags = detail::get16(p + 2);
+  frame.sequence = detail::get32(p + 4);
+  frame.timestamp_ns = detail::get64(p + 8);
+  frame.throttle = detail::getFloat(p + 16);
+  frame.steering = detail::getFloat(p + 20);
+  return frame.version == kVersion;
+}
+
+// The same command as the text protocol would have carried
+inline kv_codec::ControlCommand toCommand(const Frame &frame) {
+  kv_codec::ControlCommand command;
+  command.init = (frame.flags & kInit) != 0;
+  command.has_throttle = (frame.flags & kHasThrottle) != 0;
+  command.throttle = frame.throttle;
+  command.has_steering = (frame.flags & kHasSteering) != 0;
+  command.steering = frame.steering;
+  command.has_auto_mode = (frame.flags & kHasAutoMode) != 0;
+  command.auto_mode = (frame.flags & kAutoMode) != 0;
+  return command;
+}
+
+} // namespace control_frame
+
+#endif
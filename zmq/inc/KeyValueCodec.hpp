@@ -0,0 +1,361 @@
+#ifndef KEY_VALUE_CODEC_HPP
+#define KEY_VALUE_CODEC_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+// Allocation-free codec for the "key:value;key:value;" text protocol used on
+// every ZMQ channel.
+//
+// Parsing works on std::string_view slices of the received message; numbers
+// are converted without copies (decimal fast path, strtod on a stack buffer
+// for anything else) and known keys map to the Key enum through a
+// collision-free hash checked at compile time. Results go into fixed
+// structs. Serialization writes into a MessageWriter's stack buffer.
+//
+// <charconv> is not used: the GCC we target lacks from_chars for floating
+// point.
+namespace kv_codec {
+
+enum class Key : uint8_t {
+  Unknown = 0,
+  Throttle,
+  Steering,
+  AutoMode,
+  Lane,
+  TrafficSign,
+  Mode,
+  Sign,
+  Speed,
+  Odo,
+  Battery,
+  Charging,
+  Obstacle,
+  FrameTimestamp,
+  Sequence,
+};
+
+// Indexed by Key - 1
+inline constexpr std::string_view kKeyNames[] = {
+    "throttle", "steering", "auto_mode", "lane",    "traffic_sign", "mode",
+    "sign",     "speed",    "odo",       "battery", "charging",     "obs",
+    "frame_ts", "seq"};
+
+inline constexpr size_t kKeyCount = sizeof(kKeyNames) / sizeof(kKeyNames[0]);
+inline constexpr size_t kHashSize = 32;
+
+// Perfect for kKeyNames; if a new key collides, retune the multipliers
+constexpr size_t keyHash(std::string_view name) {
+  return name.empty() ? 0
+                      : (name.size() + static_cast<uint8_t>(name[0]) +
+                         6 * static_cast<uint8_t>(name[name.size() - 1])) %
+                            kHashSize;
+}
+
+struct KeyTable {
+  Key slots[kHashSize];
+  bool perfect;
+};
+
+constexpr KeyTable buildKeyTable() {
+  KeyTable table{};
+  table.perfect = true;
+  for (size_t i = 0; i < kKeyCount; ++i) {
+    size_t slot = keyHash(kKeyNames[i]);
+    if (table.slots[slot] != Key::Unknown) {
+      table.perfect = false;
+    }
+    table.slots[slot] = static_cast<Key>(i + 1);
+  }
+  return table;
+}
+
+inline constexpr KeyTable kKeyTable = buildKeyTable();
+static_assert(kKeyTable.perfect, "kv_codec key hash has a collision");
+
+inline std::string_view keyName(Key key) {
+  auto index = static_cast<size_t>(key);
+  return index == 0 || index > kKeyCount ? std::string_view()
+                                         : kKeyNames[index - 1];
+}
+
+inline Key lookupKey(std::string_view name) {
+  Key key = kKeyTable.slots[keyHash(name)];
+  return key != Key::Unknown && keyName(key) == name ? key : Key::Unknown;
+}
+
+// Calls handler(key, value) for every "key:value" token of a ';'-separated
+// message, splitting at the first ':'. Tokens without a colon (markers such
+// as "init") are passed with an empty value; empty tokens are skipped.
+template <typename Handler>
+void forEachPair(std::string_view message, Handler &&handler) {
+  size_t pos = 0;
+  while (pos < message.size()) {
+    size_t end = message.find(';', pos);
+    if (end == std::string_view::npos) {
+      end = message.size();
+    }
+    std::string_view token = message.substr(pos, end - pos);
+    if (!token.empty()) {
+      size_t colon = token.find(':');
+      if (colon == std::string_view::npos) {
+        handler(token, std::string_view());
+      } else {
+        handler(token.substr(0, colon), token.substr(colon + 1));
+      }
+    }
+    pos = end + 1;
+  }
+}
+
+// Strict integer parse: optional sign and digits only, no overflow
+inline bool parseInt(std::string_view text, int &out) {
+  size_t i = 0;
+  bool negative = false;
+  if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+    negative = text[i] == '-';
+    i++;
+  }
+  if (i == text.size()) {
+    return false;
+  }
+  const int64_t limit =
+      negative ? -static_cast<int64_t>(std::numeric_limits<int>::min())
+               : std::numeric_limits<int>::max();
+  int64_t value = 0;
+  for (; i < text.size(); ++i) {
+    if (text[i] < '0' || text[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (text[i] - '0');
+    if (value > limit) {
+      return false;
+    }
+  }
+  out = static_cast<int>(negative ? -value : value);
+  return true;
+}
+
+// Strict unsigned parse: digits only, no overflow
+inline bool parseUint64(std::string_view text, uint64_t &out) {
+  if (text.empty()) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    uint64_t digit = static_cast<uint64_t>(c - '0');
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  out = value;
+  return true;
+}
+
+// Finite floating-point parse of the whole text
+inline bool parseDouble(std::string_view text, double &out) {
+  // Fast path for plain decimals with up to 15 significant digits: the
+  // mantissa and the power of ten are exact doubles, so one division gives
+  // the correctly rounded result
+  static constexpr double kPow10[] = {1e0, 1e1, 1e2,  1e3,  1e4,  1e5,
+                                      1e6, 1e7, 1e8,  1e9,  1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15};
+  size_t i = 0;
+  bool negative = false;
+  if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+    negative = text[i] == '-';
+    i++;
+  }
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int fraction = 0;
+  bool dot = false;
+  bool simple = i < text.size();
+  for (; i < text.size() && simple; ++i) {
+    char c = text[i];
+    if (c >= '0' && c <= '9') {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+      digits++;
+      fraction += dot ? 1 : 0;
+    } else if (c == '.' && !dot) {
+      dot = true;
+    } else {
+      simple = false;
+    }
+  }
+  if (simple && digits > 0 && digits <= 15) {
+    double value = static_cast<double>(mantissa) / kPow10[fraction];
+    out = negative ? -value : value;
+    return true;
+  }
+
+  // Exponents, long mantissas etc.
+  char buffer[64];
+  if (text.empty() || text.size() >= sizeof(buffer)) {
+    return false;
+  }
+  std::memcpy(buffer, text.data(), text.size());
+  buffer[text.size()] = '\0';
+  char *end = nullptr;
+  double value = std::strtod(buffer, &end);
+  if (end != buffer + text.size() || !std::isfinite(value)) {
+    return false;
+  }
+  out = value;
+  return true;
+}
+
+// Manual or autonomous drive command. Autonomous commands may carry the
+// capture time of the perception frame they were computed from
+// ("frame_ts", steady-clock nanoseconds) and a sequence number ("seq",
+// wraps at 32 bits).
+struct ControlCommand {
+  bool init = false; // the whole message was the "init;" reset marker
+  bool has_throttle = false;
+  double throttle = 0.0;
+  bool has_steering = false;
+  double steering = 0.0;
+  bool has_auto_mode = false;
+  bool auto_mode = false;
+  bool has_frame_ts = false;
+  uint64_t frame_ts_ns = 0;
+  bool has_sequence = false;
+  uint32_t sequence = 0;
+};
+
+// Unknown keys and unparsable values are ignored
+inline ControlCommand parseControl(std::string_view message) {
+  ControlCommand command;
+  command.init = message == "init;";
+  forEachPair(message, [&command](std::string_view name,
+                                  std::string_view value) {
+    double number;
+    uint64_t integer;
+    switch (lookupKey(name)) {
+    case Key::Throttle:
+      if (parseDouble(value, number)) {
+        command.has_throttle = true;
+        command.throttle = number;
+      }
+      break;
+    case Key::Steering:
+      if (parseDouble(value, number)) {
+        command.has_steering = true;
+        command.steering = number;
+      }
+      break;
+    case Key::AutoMode:
+      if (parseDouble(value, number)) {
+        command.has_auto_mode = true;
+        command.auto_mode = number != 0.0;
+      }
+      break;
+    case Key::FrameTimestamp:
+      if (parseUint64(value, integer)) {
+        command.has_frame_ts = true;
+        command.frame_ts_ns = integer;
+      }
+      break;
+    case Key::Sequence:
+      if (parseUint64(value, integer)) {
+        command.has_sequence = true;
+        command.sequence = static_cast<uint32_t>(integer);
+      }
+      break;
+    default:
+      break;
+    }
+  });
+  return command;
+}
+
+// "lane:<int>" with an optional trailing ';' and nothing after it
+inline bool parseLane(std::string_view message, int &status) {
+  constexpr std::string_view prefix = "lane:";
+  if (message.substr(0, prefix.size()) != prefix) {
+    return false;
+  }
+  std::string_view value = message.substr(prefix.size());
+  if (!value.empty() && value.back() == ';') {
+    value.remove_suffix(1);
+  }
+  return parseInt(value, status);
+}
+
+// Sign name of "traffic_sign:<NAME>[;]" or a bare "<NAME>[;]"
+inline std::string_view parseTrafficSign(std::string_view message) {
+  constexpr std::string_view prefix = "traffic_sign:";
+  if (message.size() > prefix.size() &&
+      message.substr(0, prefix.size()) == prefix) {
+    message.remove_prefix(prefix.size());
+  }
+  if (!message.empty() && message.back() == ';') {
+    message.remove_suffix(1);
+  }
+  return message;
+}
+
+// Builds "key:value;..." in a fixed stack buffer. A pair that does not fit
+// is dropped and marks the writer as overflowed.
+template <size_t Capacity = 128> class MessageWriter {
+public:
+  MessageWriter &add(std::string_view name, std::string_view value) {
+    size_t needed = name.size() + value.size() + 2;
+    if (_size + needed > Capacity) {
+      _overflow = true;
+      return *this;
+    }
+    append(name);
+    _buffer[_size++] = ':';
+    append(value);
+    _buffer[_size++] = ';';
+    return *this;
+  }
+
+  MessageWriter &add(std::string_view name, int value) {
+    char text[16];
+    int length = std::snprintf(text, sizeof(text), "%d", value);
+    return add(name, std::string_view(text, static_cast<size_t>(length)));
+  }
+
+  MessageWriter &add(std::string_view name, double value) {
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%g", value);
+    return add(name, std::string_view(text, static_cast<size_t>(length)));
+  }
+
+  template <typename Value> MessageWriter &add(Key key, Value value) {
+    return add(keyName(key), value);
+  }
+
+  std::string_view view() const { return std::string_view(_buffer, _size); }
+  bool overflowed() const { return _overflow; }
+  void clear() {
+    _size = 0;
+    _overflow = false;
+  }
+
+private:
+  void append(std::string_view text) {
+    std::memcpy(_buffer + _size, text.data(), text.size());
+    _size += text.size();
+  }
+
+  char _buffer[Capacity];
+  size_t _size = 0;
+  bool _overflow = false;
+};
+
+} // namespace kv_codec
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include "zmq.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Single-threaded event loop multiplexing ZMQ sockets, plain file
+// descriptors and periodic timers with one zmq::poll call.
+//
+// A handler runs as soon as its socket is readable; the poll timeout is the
+// time until the next timer, so nothing sleeps on a fixed tick. stop() wakes
+// the loop through an eventfd that is part of every poll, so shutdown does
+// not wait for a timeout either.
+//
+// Handlers run on the reactor thread and must not block. ZMQ readiness is
+// level-triggered here: a handler should drain its socket, anything left is
+// reported again on the next iteration. Register everything before start()
+// or run(); registration is not synchronised with a running loop.
+class Reactor {
+public:
+  using Handler = std::function<void()>;
+  using Clock = std::chrono::steady_clock;
+
+  Reactor();
+  ~Reactor();
+
+  Reactor(const Reactor &) = delete;
+  Reactor &operator=(const Reactor &) = delete;
+
+  // socket is a libzmq socket handle (static_cast<void *>(zmq::socket_t))
+  void addSocket(void *socket, Handler handler);
+  void addFd(int fd, Handler handler);
+  // Runs handler every period, first one period from now
+  void addTimer(std::chrono::milliseconds period, Handler handler);
+
+  // Runs the loop on the calling thread until stop(); returns at once if
+  // stop() was called before it
+  void run();
+  // Polls once, waiting at most max_wait (or until the next timer), and
+  // dispatches whatever is ready. Returns the number of handlers run.
+  size_t runOnce(std::chrono::milliseconds max_wait);
+
+  // Runs the loop on an owned thread
+  void start();
+  // Wakes and ends the loop; safe to call from any thread
+  void stop();
+
+  bool isRunning() const { return running_flag.load(); }
+  uint64_t getDispatchCount() const { return dispatch_count.load(); }
+
+private:
+  struct Timer {
+    std::chrono::milliseconds period;
+    Clock::time_point due;
+    Handler handler;
+  };
+
+  void loop();
+  size_t dispatch(const Handler &handler);
+  void clearWakeup();
+
+  int _wakeFd = -1;
+  std::vector<zmq::pollitem_t> _items; // [0] is the wakeup eventfd
+  std::vector<Handler> _handlers;      // parallel to _items
+  std::vector<Timer> _timers;
+
+  std::atomic<bool> stop_flag{false}; // a stop() not yet seen by the loop
+  std::atomic<bool> running_flag{false};
+  std::atomic<uint64_t> dispatch_count{0};
+  std::thread _thread;
+};
+
+#endif
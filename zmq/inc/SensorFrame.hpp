@@ -0,0 +1,168 @@
+#ifndef SENSOR_FRAME_HPP
+#define SENSOR_FRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fixed-layout binary frame for sensor channels, shared by producers and
+// consumers. One frame carries every channel that changed in a tick.
+//
+// All fields are little endian:
+//
+//   header (8 bytes)
+//     0  u8   magic (0xB5, never a printable character, so a consumer can
+//             tell frames from the legacy "name:value;" text on one socket)
+//     1  u8   version
+//     2  u16  record count
+//     4  u32  sequence number (per publisher, wraps)
+//   record (16 bytes each)
+//     0  u16  channel id
+//     2  u16  reserved, 0
+//     4  u32  value
+//     8  u64  sample time, steady_clock nanoseconds
+namespace sensor_frame {
+
+constexpr uint8_t kMagic = 0xB5;
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 8;
+constexpr size_t kRecordSize = 16;
+constexpr size_t kMaxRecords = 32;
+constexpr size_t kMaxFrameSize = kHeaderSize + kMaxRecords * kRecordSize;
+
+enum class Channel : uint16_t {
+  Unknown = 0,
+  Speed = 1,
+  Odo = 2,
+  Battery = 3,
+  Charging = 4,
+  Obstacle = 5,
+};
+
+struct Record {
+  Channel channel;
+  uint32_t value;
+  uint64_t timestamp_ns;
+};
+
+struct Header {
+  uint8_t version;
+  uint16_t count;
+  uint32_t sequence;
+};
+
+inline Channel channelFromName(const std::string &name) {
+  if (name == "speed")
+    return Channel::Speed;
+  if (name == "odo")
+    return Channel::Odo;
+  if (name == "battery")
+    return Channel::Battery;
+  if (name == "charging")
+    return Channel::Charging;
+  if (name == "obs")
+    return Channel::Obstacle;
+  return Channel::Unknown;
+}
+
+inline const char *channelName(Channel channel) {
+  switch (channel) {
+  case Channel::Speed:
+    return "speed";
+  case Channel::Odo:
+    return "odo";
+  case Channel::Battery:
+    return "battery";
+  case Channel::Charging:
+    return "charging";
+  case Channel::Obstacle:
+    return "obs";
+  default:
+    return "unknown";
+  }
+}
+
+namespace detail {
+inline void put16(uint8_t *p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+inline void put32(uint8_t *p, uint32_t v) {
+  put16(p, static_cast<uint16_t>(v));
+  put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+inline void put64(uint8_t *p, uint64_t v) {
+  put32(p, static_cast<uint32_t>(v));
+  put32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+inline uint16_t get16(const uint8_t *p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+inline uint32_t get32(const uint8_t *p) {
+  return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+inline uint64_t get64(const uint8_t *p) {
+  return get32(p) | (static_cast<uint64_t>(get32(p + 4)) << 32);
+}
+} // namespace detail
+
+constexpr size_t encodedSize(size_t count) {
+  return kHeaderSize + count * kRecordSize;
+}
+
+// Returns the number of bytes written, or 0 if the frame does not fit
+inline size_t encode(uint32_t sequence, const Record *records, size_t count,
+                     uint8_t *out, size_t capacity) {
+  if (count > kMaxRecords || capacity < encodedSize(count)) {
+    return 0;
+  }
+  out[0] = kMagic;
+  out[1] = kVersion;
+  detail::put16(out + 2, static_cast<uint16_t>(count));
+  detail::put32(out + 4, sequence);
+
+  uint8_t *p = out + kHeaderSize;
+  for (size_t i = 0; i < count; ++i, p += kRecordSize) {
+    detail::put16(p, static_cast<uint16_t>(records[i].channel));
+    detail::put16(p + 2, 0);
+    detail::put32(p + 4, records[i].value);
+    detail::put64(p + 8, records[i].timestamp_ns);
+  }
+  return encodedSize(count);
+}
+
+inline bool isFrame(const void *data, size_t size) {
+  return size >= kHeaderSize && static_cast<const uint8_t *>(data)[0] == kMagic;
+}
+
+// Validates magic, version and length against the record count
+inline bool decodeHeader(const void *data, size_t size, Header &header) {
+  if (!isFrame(data, size)) {
+    return false;
+  }
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  header.version = p[1];
+  header.count = detail::get16(p + 2);
+  header.sequence = detail::get32(p + 4);
+  return header.version == kVersion && size == encodedSize(header.count);
+}
+
+// Decodes a whole frame, calling on_record(const Record &) per record
+template <typename OnRecord>
+bool decode(const void *data, size_t size, Header &header,
+            OnRecord &&on_record) {
+  if (!decodeHeader(data, size, header)) {
+    return false;
+  }
+  const uint8_t *p = static_cast<const uint8_t *>(data) + kHeaderSize;
+  for (size_t i = 0; i < header.count; ++i, p += kRecordSize) {
+    Record record{static_cast<Channel>(detail::get16(p)), detail::get32(p + 4),
+                  detail::get64(p + 8)};
+    on_record(record);
+  }
+  return true;
+}
+
+} // namespace sensor_frame
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef SHM_TRANSPORT_HPP
+#define SHM_TRANSPORT_HPP
+
+#include "ZmqPublisher.hpp"
+#include "ZmqSubscriber.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Shared-memory transport for consumers on the same machine.
+//
+// The publisher owns a POSIX shared-memory ring of fixed-size slots with a
+// single writer and any number of readers. Each slot is a seqlock: the writer
+// marks it busy, copies the payload and stamps it with the message sequence;
+// a reader copies the payload and keeps it only if the stamp still matches.
+// Readers that fall more than one ring behind skip ahead and count the lost
+// messages. Blocking receives sleep on a futex in the ring header, and the
+// writer only issues the wake syscall when someone is waiting.
+//
+// The publisher recreates the ring on startup, so subscribers must be
+// recreated when the publishing process restarts.
+//
+// Selected with an "shm://<name>" endpoint (see Transport.hpp).
+namespace shm_ring {
+
+constexpr uint32_t kMagic = 0x53484d52; // "SHMR"
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kDefaultSlotCount = 256;
+constexpr uint32_t kDefaultSlotSize = 512;
+
+struct RingHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t slot_count;
+  uint32_t slot_size;
+  std::atomic<uint64_t> write_seq; // last published sequence, 0 = none
+  std::atomic<uint32_t> futex_word; // bumped on every publish
+  std::atomic<uint32_t> waiters;
+};
+
+struct SlotHeader {
+  std::atomic<uint64_t> seq; // sequence stored in the slot, or kBusy
+  uint32_t size;
+  uint32_t reserved;
+};
+
+constexpr uint64_t kBusy = ~0ULL;
+
+// Maps "shm://name" (or "name") to the POSIX object name "/name"
+std::string objectName(const std::string &endpoint);
+
+} // namespace shm_ring
+
+class ShmPublisher : public IPublisher {
+public:
+  explicit ShmPublisher(const std::string &endpoint,
+                        uint32_t slot_count = shm_ring::kDefaultSlotCount,
+                        uint32_t slot_size = shm_ring::kDefaultSlotSize);
+  ~ShmPublisher() override;
+
+  ShmPublisher(const ShmPublisher &) = delete;
+  ShmPublisher &operator=(const ShmPublisher &) = delete;
+
+  void send(const std::string &message) override;
+  void send(std::string_view message) override;
+  using IPublisher::send;
+
+  bool isConnected() const { return _header != nullptr; }
+  uint64_t getSequence() const;
+
+private:
+  std::string _name;
+  void *_region = nullptr;
+  size_t _regionSize = 0;
+  shm_ring::RingHeader *_header = nullptr;
+  uint8_t *_slots = nullptr;
+  size_t _stride = 0;
+};
+
+class ShmSubscriber : public ISubscriber {
+public:
+  explicit ShmSubscriber(const std::string &endpoint);
+  ~ShmSubscriber() override;
+
+  ShmSubscriber(const ShmSubscriber &) = delete;
+  ShmSubscriber &operator=(const ShmSubscriber &) = delete;
+
+  // Returns the next message, waiting up to timeout_ms; "" if none arrived.
+  // Attaches lazily, so the subscriber may be created before the publisher.
+  std::string receive(int timeout_ms = 0) override;
+  bool receiveInto(std::string &out, int timeout_ms = 0) override;
+  bool isConnected() const override { return _header != nullptr; }
+
+  uint64_t getDropped() const { return _dropped; }
+
+private:
+  bool attach();
+  void detach();
+  bool tryRead(std::string &out);
+
+  std::string _name;
+  void *_region = nullptr;
+  size_t _regionSize = 0;
+  shm_ring::RingHeader *_header = nullptr;
+  const uint8_t *_slots = nullptr;
+  size_t _stride = 0;
+  uint64_t _next = 0;
+  uint64_t _dropped = 0;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include "ZmqPublisher.hpp"
+#include "ZmqSubscriber.hpp"
+#include <memory>
+#include <string>
+#include <zmq.hpp>
+
+// Endpoint-based transport selection: "shm://<name>" uses the shared-memory
+// ring (ShmTransport.hpp), anything else (tcp://, ipc://, inproc://) is
+// handed to ZeroMQ.
+bool isShmEndpoint(const std::string &endpoint);
+
+std::shared_ptr<IPublisher> createPublisher(const std::string &endpoint,
+                                            zmq::context_t &context);
+std::shared_ptr<ISubscriber> createSubscriber(const std::string &endpoint,
+                                              zmq::context_t &context);
+
+#endif
@@ -5,6 +5,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <zmq.hpp>
 
 // Interface for publisher functionality
@@ -12,6 +13,21 @@ class IPublisher {
 public:
   virtual ~IPublisher() = default;
   virtual void send(const std::string &message) = 0;
+
+  // Views let callers publish from stack buffers. The default copies into a
+  // std::string; transports override it to send without allocating.
+  virtual void send(std::string_view message) { send(std::string(message)); }
+  void send(const char *message) { send(std::string_view(message)); }
+
+  // Header and payload as one two-part message. The default sends them
+  // concatenated for transports without multipart support.
+  virtual void sendMultipart(std::string_view header,
+                             std::string_view payload) {
+    std::string message;
+    message.reserve(header.size() + payload.size());
+    message.append(header).append(payload);
+    send(message);
+  }
 };
 
 class ZmqPublisher : public IPublisher {
@@ -21,13 +37,27 @@ public:
                bool test_mode = false);
   ~ZmqPublisher() override;
 
-  // Send a message through the publisher
+  // Send a message through the publisher. Messages up to
+  // inlineMessageSize bytes are stored inside the ZMQ message itself and do
+  // not allocate; larger ones cost one malloc in libzmq.
   void send(const std::string &message) override;
+  void send(std::string_view message) override;
+  using IPublisher::send;
+
+  // Two-frame message (ZMQ_SNDMORE), each frame sent like send()
+  void sendMultipart(std::string_view header,
+                     std::string_view payload) override;
+
+  // libzmq keeps messages up to 33 bytes inline (64-bit builds)
+  static constexpr size_t inlineMessageSize = 33;
 
   // Test if the publisher is connected
   bool isConnected() const;
 
 private:
+  bool canSend() const;
+  zmq::message_t makeMessage(std::string_view data);
+
   zmq::context_t &_context;
   zmq::socket_t _socket;
   std::string _address;
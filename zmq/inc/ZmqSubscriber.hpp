@@ -7,6 +7,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 
 // Interface for subscriber functionality
 class ISubscriber {
@@ -14,21 +15,69 @@ public:
   virtual ~ISubscriber() = default;
   virtual std::string receive(int timeout_ms = 0) = 0;
   virtual bool isConnected() const = 0;
+
+  // Fills a caller-owned buffer with the next non-empty message, reusing its
+  // capacity; false if none arrived within timeout_ms. Empty messages carry
+  // nothing to act on and are consumed without ending a receive loop early.
+  // The default cannot see them: receive() returns "" for both.
+  virtual bool receiveInto(std::string &out, int timeout_ms = 0) {
+    std::string message = receive(timeout_ms);
+    if (message.empty()) {
+      return false;
+    }
+    out.assign(message);
+    return true;
+  }
 };
 
 class ZmqSubscriber : public ISubscriber {
 public:
+  // Latest conflates to the newest message, for state where only the
+  // current value matters. All queues up to queueDepth messages so every
+  // one is seen, in order, by receive loops such as drain().
+  enum class Delivery { Latest, All };
+  static constexpr int queueDepth = 100;
+
   // Constructor with test_mode parameter
   ZmqSubscriber(const std::string &address, zmq::context_t &context,
-                bool test_mode = false);
+                bool test_mode = false, Delivery delivery = Delivery::Latest);
   ~ZmqSubscriber() override;
 
   // Receive a message with optional timeout in milliseconds
   std::string receive(int timeout_ms = 0) override;
 
+  // Returns a view of the next message, valid until the next receive call on
+  // this subscriber; std::nullopt if none arrived within timeout_ms. The poll
+  // item and message object are reused, so this never allocates.
+  std::optional<std::string_view> receiveView(int timeout_ms = 0);
+  bool receiveInto(std::string &out, int timeout_ms = 0) override;
+
+  // Waits up to timeout_ms for a message, then hands every queued message
+  // (at most max_messages) to handler(std::string_view). Returns the count.
+  template <typename Handler>
+  size_t drain(Handler &&handler, int timeout_ms = 0,
+               size_t max_messages = 64) {
+    size_t count = 0;
+    while (count < max_messages) {
+      auto message = receiveView(count == 0 ? timeout_ms : 0);
+      if (!message) {
+        break;
+      }
+      handler(*message);
+      count++;
+    }
+    return count;
+  }
+
   // Check if the subscriber is connected
   bool isConnected() const override;
 
+  // Socket handle for an external poll loop (see Reactor.hpp); nullptr in
+  // test mode or when the connect failed
+  void *handle() const {
+    return _is_connected && !_test_mode ? _pollItem.socket : nullptr;
+  }
+
   // For test mode: set the next message to be received
   void setTestMessage(const std::string &message);
 
@@ -39,6 +88,9 @@ private:
   bool _test_mode;
   bool _is_connected;
 
+  zmq::pollitem_t _pollItem;
+  zmq::message_t _message;
+
   // For test mode
   std::string _test_message;
   bool _has_test_message = false;
@@ -0,0 +1,150 @@
+#include "Reactor.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+Reactor::Reactor() {
+  _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (_wakeFd < 0) {
+    throw std::runtime_error(std::string("Reactor: eventfd failed: ") +
+                             std::strerror(errno));
+  }
+  _items.push_back({nullptr, _wakeFd, ZMQ_POLLIN, 0});
+  _handlers.emplace_back(); // wakeups are handled by the loop itself
+}
+
+Reactor::~Reactor() {
+  stop();
+  close(_wakeFd);
+}
+
+void Reactor::addSocket(void *socket, Handler handler) {
+  if (!socket) {
+    throw std::invalid_argument("Reactor: null socket");
+  }
+  _items.push_back({socket, 0, ZMQ_POLLIN, 0});
+  _handlers.push_back(std::move(handler));
+}
+
+void Reactor::addFd(int fd, Handler handler) {
+  _items.push_back({nullptr, fd, ZMQ_POLLIN, 0});
+  _handlers.push_back(std::move(handler));
+}
+
+void Reactor::addTimer(std::chrono::milliseconds period, Handler handler) {
+  if (period <= std::chrono::milliseconds::zero()) {
+    throw std::invalid_argument("Reactor: timer period must be positive");
+  }
+  _timers.push_back({period, Clock::now() + period, std::move(handler)});
+}
+
+void Reactor::run() {
+  running_flag = true;
+  loop();
+}
+
+void Reactor::start() {
+  if (running_flag.exchange(true)) {
+    return; // already running
+  }
+  if (_thread.joinable()) {
+    _thread.join(); // stopped from one of its own handlers
+  }
+  // start() returns with the loop running, so an earlier stop() is void
+  stop_flag = false;
+  _thread = std::thread(&Reactor::loop, this);
+}
+
+void Reactor::loop() {
+  // A stop() issued before the loop got here ends it at once. The loop
+  // consumes the stop, so the reactor can be run again.
+  while (!stop_flag) {
+    runOnce(std::chrono::milliseconds(-1));
+  }
+  stop_flag = false;
+  running_flag = false;
+}
+
+void Reactor::stop() {
+  stop_flag = true;
+  uint64_t one = 1;
+  if (write(_wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+    std::cerr << "Reactor: wakeup failed: " << std::strerror(errno)
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+  }
+  if (_thread.joinable() && _thread.get_id() != std::this_thread::get_id()) {
+    _thread.join();
+  }
+}
+
+size_t Reactor::runOnce(std::chrono::milliseconds max_wait) {
+  // Sleep until the earliest timer, or max_wait (negative waits forever)
+  auto now = Clock::now();
+  std::chrono::milliseconds timeout = max_wait;
+  for (const auto &timer : _timers) {
+    auto until = std::chrono::ceil<std::chrono::milliseconds>(timer.due - now);
+    until = std::max(until, std::chrono::milliseconds::zero());
+    if (timeout.count() < 0 || until < timeout) {
+      timeout = until;
+    }
+  }
+
+  for (auto &item : _items) {
+    item.revents = 0;
+  }
+  try {
+    zmq::poll(_items.data(), _items.size(), timeout);
+  } catch (const zmq::error_t &e) {
+    if (e.num() != EINTR) {
+      std::cerr << "ZMQ Error in reactor poll: " << e.what()
+                << std::endl; // LCOV_EXCL_LINE - ZMQ error handling
+    }
+    return 0;
+  }
+
+  size_t dispatched = 0;
+  if (_items[0].revents & ZMQ_POLLIN) {
+    clearWakeup();
+  }
+  for (size_t i = 1; i < _items.size(); ++i) {
+    if (_items[i].revents & ZMQ_POLLIN) {
+      dispatched += dispatch(_handlers[i]);
+    }
+  }
+
+  now = Clock::now();
+  for (auto &timer : _timers) {
+    if (timer.due > now) {
+      continue;
+    }
+    dispatched += dispatch(timer.handler);
+    // Keep the cadence, but do not replay ticks missed while busy
+    timer.due += timer.period;
+    if (timer.due <= now) {
+      timer.due = now + timer.period;
+    }
+  }
+  return dispatched;
+}
+
+size_t Reactor::dispatch(const Handler &handler) {
+  try {
+    handler();
+  } catch (const std::exception &e) {
+    std::cerr << "Error in reactor handler: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+  }
+  dispatch_count.fetch_add(1, std::memory_order_relaxed);
+  return 1;
+}
+
+void Reactor::clearWakeup() {
+  uint64_t count;
+  while (read(_wakeFd, &count, sizeof(count)) > 0) {
+  }
+}
@@ -0,0 +1,295 @@
+#include "ShmTransport.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared-memory ring needs lock-free 64-bit atomics");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex word must be a plain 32-bit integer");
+
+constexpr size_t kAlign = 64; // keep slots on their own cache lines
+
+constexpr size_t alignUp(size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+size_t headerBytes() { return alignUp(sizeof(shm_ring::RingHeader)); }
+
+size_t slotStride(uint32_t slot_size) {
+  return alignUp(sizeof(shm_ring::SlotHeader) + slot_size);
+}
+
+uint32_t *futexAddress(std::atomic<uint32_t> &word) {
+  return reinterpret_cast<uint32_t *>(&word);
+}
+
+// Shared (not PRIVATE) futex ops, the word lives in a cross-process mapping
+void futexWait(std::atomic<uint32_t> &word, uint32_t expected,
+               const struct timespec *timeout) {
+  syscall(SYS_futex, futexAddress(word), FUTEX_WAIT, expected, timeout,
+          nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<uint32_t> &word) {
+  syscall(SYS_futex, futexAddress(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr,
+          0);
+}
+
+} // namespace
+
+std::string shm_ring::objectName(const std::string &endpoint) {
+  const std::string scheme = "shm://";
+  std::string name = endpoint.compare(0, scheme.size(), scheme) == 0
+                         ? endpoint.substr(scheme.size())
+                         : endpoint;
+  return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+// ---------------------------------------------------------------- publisher
+
+ShmPublisher::ShmPublisher(const std::string &endpoint, uint32_t slot_count,
+                           uint32_t slot_size)
+    : _name(shm_ring::objectName(endpoint)), _stride(slotStride(slot_size)) {
+  if (slot_count == 0 || slot_size == 0) {
+    throw std::invalid_argument("ShmPublisher needs a non-empty ring");
+  }
+
+  // A stale ring from a previous run may have another geometry
+  shm_unlink(_name.c_str());
+  int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+  if (fd < 0) {
+    std::cerr << "Error creating shared memory " << _name << ": "
+              << std::strerror(errno)
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    return;
+  }
+
+  _regionSize = headerBytes() + slot_count * _stride;
+  if (ftruncate(fd, static_cast<off_t>(_regionSize)) != 0) {
+    std::cerr << "Error sizing shared memory " << _name << ": "
+              << std::strerror(errno)
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    close(fd);
+    shm_unlink(_name.c_str());
+    return;
+  }
+  void *region =
+      mmap(nullptr, _regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (region == MAP_FAILED) {
+    std::cerr << "Error mapping shared memory " << _name << ": "
+              << std::strerror(errno)
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    shm_unlink(_name.c_str());
+    return;
+  }
+
+  // ftruncate zero-fills, so every slot starts with seq 0 (never published)
+  _region = region;
+  _slots = static_cast<uint8_t *>(region) + headerBytes();
+  auto *header = new (region) shm_ring::RingHeader;
+  header->slot_count = slot_count;
+  header->slot_size = slot_size;
+  header->version = shm_ring::kVersion;
+  header->write_seq.store(0, std::memory_order_relaxed);
+  header->futex_word.store(0, std::memory_order_relaxed);
+  header->waiters.store(0, std::memory_order_relaxed);
+  // Readers validate the magic last
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = shm_ring::kMagic;
+  _header = header;
+}
+
+ShmPublisher::~ShmPublisher() {
+  if (_region) {
+    munmap(_region, _regionSize);
+    shm_unlink(_name.c_str());
+  }
+}
+
+void ShmPublisher::send(const std::string &message) {
+  send(std::string_view(message));
+}
+
+void ShmPublisher::send(std::string_view message) {
+  if (!_header) {
+    std::cerr << "Error: Cannot send message - shared memory not mapped"
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    return;
+  }
+  if (message.size() > _header->slot_size) {
+    std::cerr << "Error: message of " << message.size()
+              << " bytes exceeds shared memory slot size "
+              << _header->slot_size
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    return;
+  }
+
+  uint64_t seq = _header->write_seq.load(std::memory_order_relaxed) + 1;
+  uint8_t *slot = _slots + (seq % _header->slot_count) * _stride;
+  auto *slot_header = reinterpret_cast<shm_ring::SlotHeader *>(slot);
+
+  slot_header->seq.store(shm_ring::kBusy, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(slot + sizeof(shm_ring::SlotHeader), message.data(),
+              message.size());
+  slot_header->size = static_cast<uint32_t>(message.size());
+  slot_header->seq.store(seq, std::memory_order_release);
+  _header->write_seq.store(seq, std::memory_order_release);
+
+  _header->futex_word.fetch_add(1);
+  if (_header->waiters.load() > 0) {
+    futexWakeAll(_header->futex_word);
+  }
+}
+
+uint64_t ShmPublisher::getSequence() const {
+  return _header ? _header->write_seq.load(std::memory_order_acquire) : 0;
+}
+
+// --------------------------------------------------------------- subscriber
+
+ShmSubscriber::ShmSubscriber(const std::string &endpoint)
+    : _name(shm_ring::objectName(endpoint)) {
+  attach();
+}
+
+ShmSubscriber::~ShmSubscriber() { detach(); }
+
+bool ShmSubscriber::attach() {
+  int fd = shm_open(_name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return false; // publisher not up yet
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < headerBytes()) {
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  // Read-write: blocking receives register in the waiter count
+  void *region = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (region == MAP_FAILED) {
+    return false;
+  }
+
+  auto *header = static_cast<shm_ring::RingHeader *>(region);
+  bool valid = header->magic == shm_ring::kMagic;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  valid = valid && header->version == shm_ring::kVersion &&
+          header->slot_count > 0 &&
+          size >= headerBytes() + header->slot_count *
+                                      slotStride(header->slot_size);
+  if (!valid) {
+    munmap(region, size);
+    return false;
+  }
+
+  _region = region;
+  _regionSize = size;
+  _header = header;
+  _slots = static_cast<const uint8_t *>(region) + headerBytes();
+  _stride = slotStride(header->slot_size);
+  // Like a SUB socket, only messages published after attaching are seen
+  _next = header->write_seq.load(std::memory_order_acquire) + 1;
+  return true;
+}
+
+void ShmSubscriber::detach() {
+  if (_region) {
+    munmap(_region, _regionSize);
+    _region = nullptr;
+    _header = nullptr;
+  }
+}
+
+bool ShmSubscriber::tryRead(std::string &out) {
+  const uint32_t slot_count = _header->slot_count;
+  for (;;) {
+    uint64_t written = _header->write_seq.load(std::memory_order_acquire);
+    if (written < _next) {
+      return false;
+    }
+    if (written - _next >= slot_count) {
+      // Lapped by the writer: skip to the oldest slot still in the ring
+      uint64_t oldest = written - slot_count + 1;
+      _dropped += oldest - _next;
+      _next = oldest;
+    }
+
+    const uint8_t *slot = _slots + (_next % slot_count) * _stride;
+    const auto *slot_header =
+        reinterpret_cast<const shm_ring::SlotHeader *>(slot);
+    uint64_t before = slot_header->seq.load(std::memory_order_acquire);
+    uint32_t size = slot_header->size;
+    if (before == _next && size <= _header->slot_size) {
+      out.assign(reinterpret_cast<const char *>(slot) +
+                     sizeof(shm_ring::SlotHeader),
+                 size);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot_header->seq.load(std::memory_order_relaxed) == _next) {
+        _next++;
+        return true;
+      }
+    }
+    // Overwritten while we looked at it
+    _dropped++;
+    _next++;
+  }
+}
+
+std::string ShmSubscriber::receive(int timeout_ms) {
+  std::string message;
+  receiveInto(message, timeout_ms);
+  return message;
+}
+
+bool ShmSubscriber::receiveInto(std::string &out, int timeout_ms) {
+  if (!_header && !attach()) {
+    if (timeout_ms > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(
+          std::min(timeout_ms, 10))); // wait for the publisher to appear
+    }
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  for (;;) {
+    uint32_t word = _header->futex_word.load();
+    if (tryRead(out)) {
+      if (!out.empty()) {
+        return true;
+      }
+      continue; // skipped like ZmqSubscriber::receiveInto
+    }
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (timeout_ms <= 0 || remaining <= std::chrono::nanoseconds::zero()) {
+      return false;
+    }
+
+    auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+    struct timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(ns / 1000000000);
+    timeout.tv_nsec = static_cast<long>(ns % 1000000000);
+    _header->waiters.fetch_add(1);
+    futexWait(_header->futex_word, word, &timeout);
+    _header->waiters.fetch_sub(1);
+  }
+}
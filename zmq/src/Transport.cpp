@@ -0,0 +1,22 @@
+#include "Transport.hpp"
+#include "ShmTransport.hpp"
+
+bool isShmEndpoint(const std::string &endpoint) {
+  return endpoint.compare(0, 6, "shm://") == 0;
+}
+
+std::shared_ptr<IPublisher> createPublisher(const std::string &endpoint,
+                                            zmq::context_t &context) {
+  if (isShmEndpoint(endpoint)) {
+    return std::make_shared<ShmPublisher>(endpoint);
+  }
+  return std::make_shared<ZmqPublisher>(endpoint, context);
+}
+
+std::shared_ptr<ISubscriber> createSubscriber(const std::string &endpoint,
+                                              zmq::context_t &context) {
+  if (isShmEndpoint(endpoint)) {
+    return std::make_shared<ShmSubscriber>(endpoint);
+  }
+  return std::make_shared<ZmqSubscriber>(endpoint, context);
+}
@@ -1,5 +1,10 @@
 #include "ZmqPublisher.hpp"
 
+namespace {
+// Subscribers map this back to an empty message
+constexpr std::string_view emptyMessageMarker = "<EMPTY_MESSAGE>";
+} // namespace
+
 ZmqPublisher::ZmqPublisher(const std::string &address, zmq::context_t &context,
                            bool test_mode)
     : _context(context), _socket(context, zmq::socket_type::pub),
@@ -55,17 +60,39 @@ ZmqPublisher::~ZmqPublisher() {
 }
 
 void ZmqPublisher::send(const std::string &message) {
+  send(std::string_view(message));
+}
+
+bool ZmqPublisher::canSend() const {
+  // If not connected, try to log the issue but don't crash
+  if (!_is_connected) {
+    std::cerr << "Error: Cannot send message - publisher not connected"
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+    return false;
+  }
+  return true;
+}
+
+zmq::message_t ZmqPublisher::makeMessage(std::string_view data) {
+  // Handle empty messages by sending a special marker
+  if (data.empty()) {
+    data = emptyMessageMarker;
+  }
+  // zmq_msg_init_size plus one copy: inline up to inlineMessageSize,
+  // otherwise a single malloc for the reference count and payload together.
+  // Handing ZMQ an external buffer instead (zmq_msg_init_data) still mallocs
+  // the reference count and needs the same copy, so it saves nothing.
+  return zmq::message_t(data.data(), data.size());
+}
+
+void ZmqPublisher::send(std::string_view message) {
   // In test mode, just log the message
   if (_test_mode) {
     std::cerr << "TEST MODE - PUBLISHING to " << _address << ": " << message
               << std::endl; // LCOV_EXCL_LINE - Test mode logging
     return;
   }
-
-  // If not connected, try to log the issue but don't crash
-  if (!_is_connected) {
-    std::cerr << "Error: Cannot send message - publisher not connected"
-              << std::endl; // LCOV_EXCL_LINE - Error handling
+  if (!canSend()) {
     return;
   }
 
@@ -73,13 +100,34 @@ void ZmqPublisher::send(const std::string &message) {
     std::cerr << "PUBLISHING to " << _address << ": " << message
               << std::endl; // LCOV_EXCL_LINE - Debug logging
 
-    // Handle empty messages by sending a special marker
-    const std::string &msgToSend =
-        message.empty() ? "<EMPTY_MESSAGE>" : message;
+    _socket.send(makeMessage(message), zmq::send_flags::none);
+  } catch (const zmq::error_t &e) {
+    std::cerr << "ZMQ Error sending message: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - ZMQ error handling
+  } catch (const std::exception &e) {
+    std::cerr << "Error sending message: " << e.what()
+              << std::endl; // LCOV_EXCL_LINE - Error handling
+  }
+}
+
+void ZmqPublisher::sendMultipart(std::string_view header,
+                                 std::string_view payload) {
+  if (_test_mode) {
+    std::cerr << "TEST MODE - PUBLISHING to " << _address << ": " << header
+              << " | " << payload
+              << std::endl; // LCOV_EXCL_LINE - Test mode logging
+    return;
+  }
+  if (!canSend()) {
+    return;
+  }
+
+  try {
+    std::cerr << "PUBLISHING to " << _address << ": " << header << " | "
+              << payload << std::endl; // LCOV_EXCL_LINE - Debug logging
 
-    zmq::message_t msg(msgToSend.size());
-    memcpy(msg.data(), msgToSend.c_str(), msgToSend.size());
-    _socket.send(msg, zmq::send_flags::none);
+    _socket.send(makeMessage(header), zmq::send_flags::sndmore);
+    _socket.send(makeMessage(payload), zmq::send_flags::none);
   } catch (const zmq::error_t &e) {
     std::cerr << "ZMQ Error sending message: " << e.what()
               << std::endl; // LCOV_EXCL_LINE - ZMQ error handling
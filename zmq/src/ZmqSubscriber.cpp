@@ -2,19 +2,25 @@
 #include <chrono>
 
 ZmqSubscriber::ZmqSubscriber(const std::string &address,
-                             zmq::context_t &context, bool test_mode)
+                             zmq::context_t &context, bool test_mode,
+                             Delivery delivery)
     : _context(context), _socket(context, zmq::socket_type::sub),
-      _address(address), _test_mode(test_mode), _is_connected(false) {
+      _address(address), _test_mode(test_mode), _is_connected(false),
+      _pollItem{static_cast<void *>(_socket), 0, ZMQ_POLLIN, 0} {
 
   if (!test_mode) {
     try {
-      // Set HWM to 1 to only keep latest message
-      int hwm = 1;
-      _socket.set(zmq::sockopt::rcvhwm, hwm);
-
-      // Enable conflate option to only keep most recent message
-      int conflate = 1;
-      _socket.set(zmq::sockopt::conflate, conflate);
+      if (delivery == Delivery::Latest) {
+        // Set HWM to 1 to only keep latest message
+        int hwm = 1;
+        _socket.set(zmq::sockopt::rcvhwm, hwm);
+
+        // Enable conflate option to only keep most recent message
+        int conflate = 1;
+        _socket.set(zmq::sockopt::conflate, conflate);
+      } else {
+        _socket.set(zmq::sockopt::rcvhwm, queueDepth);
+      }
 
       // Set zero linger period for clean exits
       int linger = 0;
@@ -53,7 +59,28 @@ ZmqSubscriber::~ZmqSubscriber() {
   }
 }
 
+namespace {
+// Publishers send this in place of an empty payload
+constexpr std::string_view emptyMessageMarker = "<EMPTY_MESSAGE>";
+} // namespace
+
 std::string ZmqSubscriber::receive(int timeout_ms) {
+  auto message = receiveView(timeout_ms);
+  return message ? std::string(*message) : std::string();
+}
+
+bool ZmqSubscriber::receiveInto(std::string &out, int timeout_ms) {
+  for (auto message = receiveView(timeout_ms); message;
+       message = receiveView(0)) {
+    if (!message->empty()) {
+      out.assign(message->data(), message->size());
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<std::string_view> ZmqSubscriber::receiveView(int timeout_ms) {
   // In test mode, return the test message if available
   if (_test_mode) {
     if (_has_test_message) {
@@ -61,49 +88,45 @@ std::string ZmqSubscriber::receive(int timeout_ms) {
       std::cerr << "TEST MODE - RECEIVED from " << _address << ": "
                 << _test_message
                 << std::endl; // LCOV_EXCL_LINE - Test mode logging
-      return _test_message;
+      return std::string_view(_test_message);
     }
-    return "";
+    return std::nullopt;
   }
 
   // If not connected, cannot receive
   if (!_is_connected) {
     std::cerr << "Error: Cannot receive message - subscriber not connected"
               << std::endl; // LCOV_EXCL_LINE - Error handling
-    return "";
+    return std::nullopt;
   }
 
   try {
-    zmq::message_t msg;
-    zmq::recv_flags flags = zmq::recv_flags::dontwait;
-
     // If timeout is specified, try to receive with timeout
     if (timeout_ms > 0) {
-      // Poll for specified timeout
-      zmq::pollitem_t items[] = {
-          {static_cast<void *>(_socket), 0, ZMQ_POLLIN, 0}};
-
-      // Use std::chrono::milliseconds instead of a long integer
-      zmq::poll(&items[0], 1, std::chrono::milliseconds(timeout_ms));
+      _pollItem.revents = 0;
+      zmq::poll(&_pollItem, 1, std::chrono::milliseconds(timeout_ms));
 
-      if (!(items[0].revents & ZMQ_POLLIN)) {
-        return ""; // No message available after timeout
+      if (!(_pollItem.revents & ZMQ_POLLIN)) {
+        return std::nullopt; // No message available after timeout
       }
     }
 
-    zmq::recv_result_t result = _socket.recv(msg, flags);
+    zmq::recv_result_t result =
+        _socket.recv(_message, zmq::recv_flags::dontwait);
 
     if (!result) {
-      return ""; // No message available, return immediately
+      return std::nullopt; // No message available, return immediately
     }
 
-    std::string message(static_cast<char *>(msg.data()), msg.size());
+    std::string_view message(static_cast<const char *>(_message.data()),
+                             _message.size());
 
     // Check for special empty message marker
-    if (message == "<EMPTY_MESSAGE>") {
+    if (message.size() == emptyMessageMarker.size() &&
+        message == emptyMessageMarker) {
       std::cerr << "RECEIVED from " << _address << ": <empty message>"
                 << std::endl; // LCOV_EXCL_LINE - Debug logging
-      return "";
+      return std::string_view();
     }
 
     std::cerr << "RECEIVED from " << _address << ": " << message
@@ -112,11 +135,11 @@ std::string ZmqSubscriber::receive(int timeout_ms) {
   } catch (const zmq::error_t &e) {
     std::cerr << "ZMQ Error receiving message: " << e.what()
               << std::endl; // LCOV_EXCL_LINE - ZMQ error handling
-    return "";
+    return std::nullopt;
   } catch (const std::exception &e) {
     std::cerr << "Error receiving message: " << e.what()
               << std::endl; // LCOV_EXCL_LINE - Error handling
-    return "";
+    return std::nullopt;
   }
 }
 